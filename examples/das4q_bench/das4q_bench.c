@@ -0,0 +1,216 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <argp.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "das4q_log.h"
+#include "das4q_sim.h"
+#include "device.h"
+#include "json.h"
+#include "kernels.h"
+#include "libdas4q.h"
+
+// Bumped whenever a field changes meaning, so old results aren't compared
+// against new ones by mistake
+#define BENCH_FORMAT 1
+
+static const struct {
+    const char *name;
+    unsigned int bit;
+} suites[] = {
+    {"kernels", BENCH_KERNELS}, {"open", BENCH_OPEN},
+    {"key", BENCH_KEY},         {"frame", BENCH_FRAME},
+    {"anim", BENCH_ANIM},       {"profile", BENCH_PROFILE},
+};
+
+const char *argp_program_version = "das4q_bench 0.02";
+const char *argp_program_bug_address = "paerley@gmail.com";
+static char doc[] =
+    "Benchmarks for libdas4q, against the simulator and against a real "
+    "keyboard if there is one.  Results go out as JSON.";
+static char args_doc[] = "";
+static struct argp_option options[] = {
+    {"iterations", 'n', "count", 0, "Calls per kernel (default 1000000)"},
+    {"repeat", 'r', "count", 0,
+     "Samples per device measurement (default 20)"},
+    {"anim-ms", 'a', "ms", 0,
+     "How long each animation frame rate is held (default 1000)"},
+    {"suites", 's', "list", 0,
+     "Comma separated suites to run, of kernels, open, key, frame, anim "
+     "and profile (default all)"},
+    {"sim-latency", 'l', "us", 0,
+     "Time each simulated report takes (default 0, the library alone)"},
+    {"device", 'd', "/dev/hidrawN", 0,
+     "Keyboard to use instead of searching with libusb"},
+    {"no-hardware", 'N', 0, 0, "Only run against the simulator"},
+    {"output", 'o', "filename", 0, "Write the results here, not stdout"},
+    {0}};
+
+struct arguments {
+    bench_options_t bench;
+    long iterations;
+    unsigned int sim_latency_us;
+    char *device;
+    bool hardware;
+    char *output;
+};
+
+static bool parse_suites(char *arg, unsigned int *bits) {
+    char *save = NULL;
+
+    *bits = 0;
+    for (char *name = strtok_r(arg, ",", &save); name != NULL;
+         name = strtok_r(NULL, ",", &save)) {
+        size_t i;
+        for (i = 0; i < sizeof(suites) / sizeof(suites[0]); i++) {
+            if (strcmp(name, suites[i].name) == 0) {
+                *bits |= suites[i].bit;
+                break;
+            }
+        }
+        if (i == sizeof(suites) / sizeof(suites[0])) {
+            return false;
+        }
+    }
+    return *bits != 0;
+}
+
+static error_t parse_opt(int key, char *arg, struct argp_state *state) {
+    struct arguments *arguments = state->input;
+    switch (key) {
+        case 'n':
+            arguments->iterations = strtol(arg, NULL, 0);
+            if (arguments->iterations <= 0) {
+                argp_usage(state);
+            }
+            break;
+        case 'r':
+            arguments->bench.repeat = atoi(arg);
+            if (arguments->bench.repeat <= 0) {
+                argp_usage(state);
+            }
+            break;
+        case 'a':
+            arguments->bench.anim_ms = atoi(arg);
+            if (arguments->bench.anim_ms <= 0) {
+                argp_usage(state);
+            }
+            break;
+        case 's':
+            if (!parse_suites(arg, &arguments->bench.suites)) {
+                argp_error(state, "Unknown suite in --suites");
+            }
+            break;
+        case 'l':
+            arguments->sim_latency_us = atoi(arg);
+            break;
+        case 'd':
+            arguments->device = arg;
+            break;
+        case 'N':
+            arguments->hardware = false;
+            break;
+        case 'o':
+            arguments->output = arg;
+            break;
+        default:
+            return ARGP_ERR_UNKNOWN;
+    }
+    return 0;
+}
+
+static struct argp argp = {options, parse_opt, args_doc, doc};
+
+// Opens and closes the real keyboard once, quietly, to see if it's there.
+static bool hardware_present(const bench_target_t *target) {
+    das4q_log_level_t level = das4q_get_log_level();
+
+    das4q_set_log_level(DAS4Q_LOG_NONE);
+    das4q_handle handle = bench_open(target, DAS4Q_INIT_NO_CLEAR);
+    das4q_set_log_level(level);
+    if (handle == NULL) {
+        return false;
+    }
+    das4q_close_device(handle);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    struct arguments arguments = {
+        .bench = {.suites = BENCH_ALL, .repeat = 20, .anim_ms = 1000},
+        .iterations = 1000000,
+        .sim_latency_us = 0,
+        .device = NULL,
+        .hardware = true,
+        .output = NULL,
+    };
+    FILE *out = stdout;
+    json_t json;
+    int ret = 0;
+
+    argp_parse(&argp, argc, argv, 0, 0, &arguments);
+    // Keep stderr to what went wrong
+    das4q_set_log_level(DAS4Q_LOG_WARN);
+
+    if (arguments.output != NULL) {
+        out = fopen(arguments.output, "w");
+        if (out == NULL) {
+            fprintf(stderr, "Can't write %s: %s\n", arguments.output,
+                    strerror(errno));
+            return 1;
+        }
+    }
+
+    json_init(&json, out);
+    json_int(&json, "format", BENCH_FORMAT);
+    json_string(&json, "version", argp_program_version);
+    json_uint(&json, "timestamp", (uint64_t)time(NULL));
+
+    if (arguments.bench.suites & BENCH_KERNELS) {
+        run_kernels(&json, arguments.iterations);
+    }
+
+    json_object(&json, "targets");
+    das4q_sim_config_t config = {
+        .set_latency_us = arguments.sim_latency_us,
+        .get_latency_us = arguments.sim_latency_us};
+    das4q_sim_t *sim = das4q_sim_new(&config);
+    bench_target_t sim_target = {.name = "sim", .sim = sim};
+    if (sim == NULL || !run_device(&json, &sim_target, &arguments.bench)) {
+        fprintf(stderr, "Failed to benchmark the simulator\n");
+        json_null(&json, "sim");
+        ret = 1;
+    }
+    das4q_sim_free(sim);
+
+    bench_target_t hw_target = {.name = "hardware",
+                                .device = arguments.device};
+    if (!arguments.hardware || !hardware_present(&hw_target) ||
+        !run_device(&json, &hw_target, &arguments.bench)) {
+        json_null(&json, "hardware");
+    }
+    json_end_object(&json);
+    json_finish(&json);
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    return ret;
+}
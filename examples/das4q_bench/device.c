@@ -0,0 +1,453 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "config.h"
+#include "das4q_anim.h"
+#include "das4q_profile.h"
+#include "das4q_transport.h"
+#include "libdas4q.h"
+#include "profile.h"
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+// User and system time of the whole process.  With the simulator that
+// includes the simulated keyboard.
+static uint64_t cpu_us(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (uint64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) *
+               1000000 +
+           usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+// Writes the distribution of n samples, which get sorted.
+static void json_latency(json_t *json, const char *key, uint64_t *us, int n,
+                         int failed) {
+    uint64_t total = 0;
+
+    json_object(json, key);
+    json_uint(json, "samples", n);
+    json_uint(json, "failed", failed);
+    if (n > 0) {
+        qsort(us, n, sizeof(*us), compare_u64);
+        for (int i = 0; i < n; i++) {
+            total += us[i];
+        }
+        json_double(json, "mean_us", (double)total / n);
+        json_uint(json, "min_us", us[0]);
+        json_uint(json, "p50_us", us[(n - 1) / 2]);
+        json_uint(json, "p99_us", us[(n - 1) * 99 / 100]);
+        json_uint(json, "max_us", us[n - 1]);
+    }
+    json_end_object(json);
+}
+
+das4q_handle bench_open(const bench_target_t *target, unsigned int flags) {
+    if (target->sim != NULL) {
+        return das4q_open_transport_flags(&das4q_sim_transport, target->sim,
+                                          flags);
+    }
+    return das4q_init_device_flags(target->device, flags);
+}
+
+// A frame where every key differs from the one before
+static void bench_fill_frame(das4q_setting_t frame[DAS4Q_NUM_KEYS], int n) {
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        frame[i] = (das4q_setting_t){.mode = DAS4Q_MODE_SOLID,
+                                     .red = n + i,
+                                     .green = 2 * n + i,
+                                     .blue = 255 - n};
+    }
+}
+
+static void bench_open_suite(json_t *json, const bench_target_t *target,
+                             const bench_options_t *options, uint64_t *us) {
+    static const struct {
+        const char *name;
+        unsigned int flags;
+    } modes[] = {
+        {"default", DAS4Q_INIT_DEFAULT},
+        {"fast", DAS4Q_INIT_FAST},
+    };
+
+    json_object(json, "open");
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        int n = 0;
+        int failed = 0;
+        for (int i = 0; i < options->repeat; i++) {
+            uint64_t start = now_us();
+            das4q_handle handle = bench_open(target, modes[m].flags);
+            if (handle == NULL) {
+                failed++;
+                continue;
+            }
+            us[n++] = now_us() - start;
+            das4q_close_device(handle);
+        }
+        json_latency(json, modes[m].name, us, n, failed);
+    }
+    json_end_object(json);
+}
+
+static void bench_key_suite(json_t *json, das4q_handle handle,
+                            const bench_options_t *options, uint64_t *us) {
+    das4q_setting_t frame[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t aframe[DAS4Q_NUM_KEYS] = {0};
+    int n = 0;
+    int failed = 0;
+
+    json_object(json, "key");
+
+    // One key on its own, round trips and all
+    for (int i = 0; i < options->repeat; i++) {
+        das4q_setting_t setting = {
+            .mode = DAS4Q_MODE_SOLID, .red = i, .green = 255 - i, .blue = 0};
+        uint64_t start = now_us();
+        if (!das4q_set_key_backlight(handle, i % DAS4Q_NUM_KEYS, setting,
+                                     aframe[0])) {
+            failed++;
+            continue;
+        }
+        us[n++] = now_us() - start;
+    }
+    json_latency(json, "set_key_backlight", us, n, failed);
+
+    // One key changing in an otherwise steady frame, as a daemon sees it
+    bench_fill_frame(frame, 0);
+    das4q_update_frame(handle, frame, aframe);
+    n = 0;
+    failed = 0;
+    for (int i = 0; i < options->repeat; i++) {
+        frame[i % DAS4Q_NUM_KEYS].blue ^= 0xff;
+        uint64_t start = now_us();
+        if (das4q_update_frame(handle, frame, aframe) < 0) {
+            failed++;
+            continue;
+        }
+        us[n++] = now_us() - start;
+    }
+    json_latency(json, "update_frame", us, n, failed);
+    json_end_object(json);
+}
+
+static void bench_frame_suite(json_t *json, das4q_handle handle,
+                              const bench_options_t *options, uint64_t *us) {
+    static const int windows[] = {1, 8, DAS4Q_MAX_ACK_WINDOW};
+    das4q_setting_t frame[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t aframe[DAS4Q_NUM_KEYS] = {0};
+
+    // All DAS4Q_NUM_KEYS keys, every one of them changed
+    json_array(json, "frame");
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++) {
+        int n = 0;
+        int failed = 0;
+
+        das4q_set_ack_window(handle, windows[w]);
+        uint64_t cpu_start = cpu_us();
+        for (int i = 0; i < options->repeat; i++) {
+            bench_fill_frame(frame, i + 1);
+            uint64_t start = now_us();
+            if (das4q_set_frame(handle, frame, aframe) < 0) {
+                failed++;
+                continue;
+            }
+            us[n++] = now_us() - start;
+        }
+        uint64_t cpu = cpu_us() - cpu_start;
+
+        json_object(json, NULL);
+        json_int(json, "ack_window", windows[w]);
+        json_latency(json, "latency", us, n, failed);
+        json_double(json, "cpu_us_per_frame",
+                    options->repeat > 0 ? (double)cpu / options->repeat : 0);
+        json_end_object(json);
+    }
+    json_end_array(json);
+    das4q_set_ack_window(handle, 1);
+}
+
+// Every key changes every frame, the most an animation can ask for
+static bool bench_effect(uint64_t t_us, das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                         das4q_active_setting_t aframe[DAS4Q_NUM_KEYS],
+                         void *user_data) {
+    static int n;
+    const bench_options_t *options = user_data;
+
+    bench_fill_frame(frame, ++n);
+    return t_us < (uint64_t)options->anim_ms * 1000;
+}
+
+static void bench_anim_suite(json_t *json, das4q_handle handle,
+                             const bench_options_t *options) {
+    static const int rates[] = {30, 60, 120};
+
+    json_array(json, "anim");
+    for (size_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+        das4q_anim_stats_t stats = {0};
+        das4q_anim_t *anim = das4q_anim_new(handle, rates[r]);
+        if (anim == NULL) {
+            continue;
+        }
+        das4q_anim_add_effect(anim, bench_effect, (void *)options);
+        uint64_t cpu_start = cpu_us();
+        int ret = das4q_anim_run(anim);
+        uint64_t cpu = cpu_us() - cpu_start;
+        das4q_anim_get_stats(anim, &stats);
+        das4q_anim_free(anim);
+
+        json_object(json, NULL);
+        json_int(json, "target_fps", rates[r]);
+        json_double(json, "achieved_fps", stats.achieved_fps);
+        json_uint(json, "frames", stats.frames);
+        json_uint(json, "dropped", stats.dropped);
+        json_uint(json, "failed", stats.failed);
+        json_double(json, "link_utilization", stats.link_utilization);
+        json_double(json, "cpu_us_per_frame",
+                    stats.frames > 0 ? (double)cpu / stats.frames : 0);
+        json_bool(json, "sustained",
+                  ret == 0 && stats.dropped == 0 && stats.failed == 0);
+        json_end_object(json);
+    }
+    json_end_array(json);
+}
+
+// How many times the generated config sets every key, by name
+#define BENCH_CONFIG_PASSES 64
+
+/*
+ * Writes a config with BENCH_CONFIG_PASSES entries for every key, both
+ * settings in each, to fd.
+ *
+ *  returns: the config's size, 0 if it couldn't be written.
+ */
+static size_t bench_write_config(int fd) {
+    FILE *file = fdopen(fd, "w");
+    if (file == NULL) {
+        close(fd);
+        return 0;
+    }
+
+    fprintf(file, "{\n    \"default\": {\"mode\": 1, \"red\": 0, "
+                  "\"green\": 0, \"blue\": 32},\n    \"keys\": [");
+    const char *sep = "\n";
+    for (int pass = 0; pass < BENCH_CONFIG_PASSES; pass++) {
+        for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+            const char *name = das4q_key_name(i);
+            if (name == NULL) {
+                continue;
+            }
+            fprintf(file,
+                    "%s        {\"key\": \"%s\", \"setting\": {\"mode\": 1, "
+                    "\"red\": %d, \"green\": %d, \"blue\": %d}, "
+                    "\"active_setting\": {\"mode\": %d, \"red\": %d, "
+                    "\"green\": 0, \"blue\": 255}}",
+                    sep, name, i, pass, 255 - i, DAS4Q_ACTIVE_MODE_BREATHE,
+                    pass);
+            sep = ",\n";
+        }
+    }
+    fprintf(file, "\n    ]\n}\n");
+
+    long len = ftell(file);
+    if (fclose(file) != 0 || len < 0) {
+        return 0;
+    }
+    return len;
+}
+
+static void bench_profile_suite(json_t *json, das4q_handle handle,
+                                const bench_options_t *options,
+                                uint64_t *us) {
+    das4q_setting_t frame[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t aframe[DAS4Q_NUM_KEYS];
+    char path[] = "/tmp/das4q_bench.XXXXXX";
+    char config_path[] = "/tmp/das4q_bench_config.XXXXXX";
+    void *profile = NULL;
+    size_t len = 0;
+    int n = 0;
+    int failed = 0;
+
+    // As big as a profile gets: every key set, every key with an active
+    // mode too
+    bench_fill_frame(frame, 7);
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        aframe[i] = (das4q_active_setting_t){.mode = DAS4Q_ACTIVE_MODE_BREATHE,
+                                             .red = i,
+                                             .green = 0,
+                                             .blue = 255 - i};
+    }
+
+    json_object(json, "profile");
+    for (int i = 0; i < options->repeat; i++) {
+        free(profile);
+        profile = NULL;
+        uint64_t start = now_us();
+        if (das4q_compile_profile(frame, aframe, &profile, &len) < 0) {
+            failed++;
+            continue;
+        }
+        us[n++] = now_us() - start;
+    }
+    json_latency(json, "compile", us, n, failed);
+    if (profile == NULL) {
+        json_end_object(json);
+        return;
+    }
+    json_uint(json, "bytes", len);
+
+    int fd = mkstemp(path);
+    if (fd < 0 || write(fd, profile, len) != (ssize_t)len) {
+        fprintf(stderr, "Can't write a profile to %s\n", path);
+        if (fd >= 0) {
+            close(fd);
+            unlink(path);
+        }
+        goto send;
+    }
+    close(fd);
+
+    // Off the disk and checked by das_udev's own map_profile
+    n = 0;
+    failed = 0;
+    for (int i = 0; i < options->repeat; i++) {
+        size_t mapped_len;
+        uint64_t start = now_us();
+        void *mapped = map_profile(path, &mapped_len);
+        if (mapped == NULL) {
+            failed++;
+            continue;
+        }
+        us[n++] = now_us() - start;
+        munmap(mapped, mapped_len);
+    }
+    json_latency(json, "load", us, n, failed);
+    unlink(path);
+
+send:
+    n = 0;
+    failed = 0;
+    for (int i = 0; i < options->repeat; i++) {
+        das4q_invalidate_frame(handle);
+        uint64_t start = now_us();
+        if (das4q_send_profile(handle, profile, len) < 0 ||
+            !das4q_apply_changes(handle)) {
+            failed++;
+            continue;
+        }
+        us[n++] = now_us() - start;
+    }
+    json_latency(json, "send", us, n, failed);
+
+    // The JSON a profile is compiled from, through das_udev's loader
+    size_t config_len = 0;
+    fd = mkstemp(config_path);
+    if (fd >= 0) {
+        config_len = bench_write_config(fd);
+    }
+    if (config_len == 0) {
+        fprintf(stderr, "Can't write a config to %s\n", config_path);
+    } else {
+        json_uint(json, "config_bytes", config_len);
+        n = 0;
+        failed = 0;
+        for (int i = 0; i < options->repeat; i++) {
+            uint64_t start = now_us();
+            if (!load_config_file(config_path, frame, aframe)) {
+                failed++;
+                continue;
+            }
+            us[n++] = now_us() - start;
+        }
+        json_latency(json, "config", us, n, failed);
+    }
+    if (fd >= 0) {
+        unlink(config_path);
+    }
+
+    json_end_object(json);
+    free(profile);
+}
+
+static void json_link_stats(json_t *json, das4q_handle handle) {
+    das4q_stats_t stats;
+
+    das4q_get_stats(handle, &stats);
+    json_object(json, "link");
+    json_uint(json, "set_reports", stats.set_reports);
+    json_uint(json, "get_reports", stats.get_reports);
+    json_uint(json, "transfer_errors", stats.transfer_errors);
+    json_uint(json, "timeouts", stats.timeouts);
+    json_uint(json, "key_retries", stats.key_retries);
+    json_uint(json, "keys_failed", stats.keys_failed);
+    json_uint(json, "srtt_us", stats.srtt_us);
+    json_end_object(json);
+}
+
+bool run_device(json_t *json, const bench_target_t *target,
+                const bench_options_t *options) {
+    uint64_t *us = calloc(options->repeat, sizeof(*us));
+    if (us == NULL) {
+        return false;
+    }
+
+    das4q_handle handle = bench_open(target, DAS4Q_INIT_DEFAULT);
+    if (handle == NULL) {
+        free(us);
+        return false;
+    }
+
+    json_object(json, target->name);
+    json_int(json, "repeat", options->repeat);
+    if (options->suites & BENCH_OPEN) {
+        bench_open_suite(json, target, options, us);
+    }
+    if (options->suites & BENCH_KEY) {
+        bench_key_suite(json, handle, options, us);
+    }
+    if (options->suites & BENCH_FRAME) {
+        bench_frame_suite(json, handle, options, us);
+    }
+    if (options->suites & BENCH_ANIM) {
+        bench_anim_suite(json, handle, options);
+    }
+    if (options->suites & BENCH_PROFILE) {
+        bench_profile_suite(json, handle, options, us);
+    }
+    json_link_stats(json, handle);
+    json_end_object(json);
+
+    das4q_close_device(handle);
+    free(us);
+    return true;
+}
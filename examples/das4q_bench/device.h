@@ -0,0 +1,59 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAS4Q_BENCH_DEVICE_H
+#define DAS4Q_BENCH_DEVICE_H
+
+#include "das4q_sim.h"
+#include "json.h"
+
+// Suites, as bits of bench_options_t.suites
+#define BENCH_KERNELS (1 << 0)
+#define BENCH_OPEN (1 << 1)
+#define BENCH_KEY (1 << 2)
+#define BENCH_FRAME (1 << 3)
+#define BENCH_ANIM (1 << 4)
+#define BENCH_PROFILE (1 << 5)
+#define BENCH_ALL 0x3f
+
+typedef struct bench_options {
+    unsigned int suites;
+    int repeat;   // Samples per measurement
+    int anim_ms;  // How long each frame rate is held
+} bench_options_t;
+
+// Something to benchmark against
+typedef struct bench_target {
+    const char *name;
+    das4q_sim_t *sim;  // Set for the simulator
+    char *device;      // Otherwise a hidraw node, NULL to go through libusb
+} bench_target_t;
+
+/*
+ * Opens the target.
+ *
+ *  flags: das4q_init_flags_t
+ */
+das4q_handle bench_open(const bench_target_t *target, unsigned int flags);
+
+/*
+ * Runs every suite but the kernels against target, into an object named
+ * after it.
+ *
+ *  returns: false if the target couldn't be opened at all.
+ */
+bool run_device(json_t *json, const bench_target_t *target,
+                const bench_options_t *options);
+
+#endif  // DAS4Q_BENCH_DEVICE_H
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "json.h"
+
+#include <math.h>
+#include <stdio.h>
+
+// Separator, indent and key for the next value.
+static void json_key(json_t *json, const char *key) {
+    if (!json->first[json->depth]) {
+        fputc(',', json->out);
+    }
+    json->first[json->depth] = false;
+    fprintf(json->out, "\n%*s", 2 * json->depth, "");
+    if (key != NULL) {
+        fprintf(json->out, "\"%s\": ", key);
+    }
+}
+
+static void json_open(json_t *json, const char *key, char bracket) {
+    json_key(json, key);
+    fputc(bracket, json->out);
+    if (json->depth < JSON_MAX_DEPTH - 1) {
+        json->depth++;
+    }
+    json->first[json->depth] = true;
+}
+
+static void json_close(json_t *json, char bracket) {
+    bool empty = json->first[json->depth];
+    if (json->depth > 0) {
+        json->depth--;
+    }
+    if (!empty) {
+        fprintf(json->out, "\n%*s", 2 * json->depth, "");
+    }
+    fputc(bracket, json->out);
+}
+
+void json_init(json_t *json, FILE *out) {
+    json->out = out;
+    json->depth = 0;
+    fputc('{', out);
+    json->first[0] = true;
+}
+
+void json_finish(json_t *json) {
+    json->depth = 0;
+    fputs("\n}\n", json->out);
+    fflush(json->out);
+}
+
+void json_object(json_t *json, const char *key) { json_open(json, key, '{'); }
+
+void json_end_object(json_t *json) { json_close(json, '}'); }
+
+void json_array(json_t *json, const char *key) { json_open(json, key, '['); }
+
+void json_end_array(json_t *json) { json_close(json, ']'); }
+
+void json_string(json_t *json, const char *key, const char *value) {
+    json_key(json, key);
+    fputc('"', json->out);
+    for (const char *c = value; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(json->out, "\\%c", *c);
+        } else if ((unsigned char)*c < 0x20) {
+            fprintf(json->out, "\\u%04x", *c);
+        } else {
+            fputc(*c, json->out);
+        }
+    }
+    fputc('"', json->out);
+}
+
+void json_uint(json_t *json, const char *key, uint64_t value) {
+    json_key(json, key);
+    fprintf(json->out, "%llu", (unsigned long long)value);
+}
+
+void json_int(json_t *json, const char *key, int64_t value) {
+    json_key(json, key);
+    fprintf(json->out, "%lld", (long long)value);
+}
+
+void json_double(json_t *json, const char *key, double value) {
+    json_key(json, key);
+    if (isfinite(value)) {
+        fprintf(json->out, "%.3f", value);
+    } else {
+        fputs("null", json->out);
+    }
+}
+
+void json_bool(json_t *json, const char *key, bool value) {
+    json_key(json, key);
+    fputs(value ? "true" : "false", json->out);
+}
+
+void json_null(json_t *json, const char *key) {
+    json_key(json, key);
+    fputs("null", json->out);
+}
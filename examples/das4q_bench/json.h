@@ -0,0 +1,54 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAS4Q_BENCH_JSON_H
+#define DAS4Q_BENCH_JSON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Just enough of a JSON writer for the results, so the benchmark doesn't
+ * need cJSON.  Keys are given inside objects and NULL inside arrays.
+ */
+
+#define JSON_MAX_DEPTH 16
+
+typedef struct json {
+    FILE *out;
+    int depth;
+    bool first[JSON_MAX_DEPTH];
+} json_t;
+
+// Starts the top level object.
+void json_init(json_t *json, FILE *out);
+
+// Ends the top level object.
+void json_finish(json_t *json);
+
+void json_object(json_t *json, const char *key);
+void json_end_object(json_t *json);
+void json_array(json_t *json, const char *key);
+void json_end_array(json_t *json);
+
+void json_string(json_t *json, const char *key, const char *value);
+void json_uint(json_t *json, const char *key, uint64_t value);
+void json_int(json_t *json, const char *key, int64_t value);
+// NaN and infinities come out as null
+void json_double(json_t *json, const char *key, double value);
+void json_bool(json_t *json, const char *key, bool value);
+void json_null(json_t *json, const char *key);
+
+#endif  // DAS4Q_BENCH_JSON_H
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernels.h"
+
+#include <time.h>
+
+#include "das4q_planes.h"
+#include "libdas4q.h"
+
+static das4q_planes_t planes, other;
+static uint8_t mask[DAS4Q_PLANE_LEN] __attribute__((aligned(32)));
+static uint8_t lut[256];
+static das4q_setting_t frame[DAS4Q_NUM_KEYS];
+
+static const das4q_rgb_t red = {.red = 255};
+static const das4q_rgb_t blue = {.blue = 255};
+
+static void bench_fill(void) { das4q_planes_fill(&planes, red); }
+
+static void bench_gradient(void) {
+    das4q_planes_gradient(&planes, mask, red, blue);
+}
+
+static void bench_blend(void) { das4q_planes_blend(&planes, &other, 100); }
+
+static void bench_blend_mask(void) {
+    das4q_planes_blend_mask(&planes, &other, mask);
+}
+
+static void bench_scale(void) { das4q_planes_scale(&planes, 200); }
+
+static void bench_gamma(void) { das4q_planes_lut(&planes, lut); }
+
+static void bench_fade(void) { das4q_planes_fade(&planes, &other, 3); }
+
+static void bench_to_frame(void) {
+    das4q_planes_to_frame(&planes, frame, DAS4Q_MODE_SOLID);
+}
+
+static const struct {
+    const char *name;
+    void (*fn)(void);
+} kernels[] = {
+    {"fill", bench_fill},
+    {"gradient", bench_gradient},
+    {"blend", bench_blend},
+    {"blend_mask", bench_blend_mask},
+    {"scale", bench_scale},
+    {"gamma_lut", bench_gamma},
+    {"fade", bench_fade},
+    {"to_frame", bench_to_frame},
+};
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+void run_kernels(json_t *json, long iterations) {
+    das4q_isa_t best = das4q_planes_get_isa();
+
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i++) {
+        mask[i] = i * 255 / (DAS4Q_PLANE_LEN - 1);
+        other.r[i] = other.g[i] = other.b[i] = 255 - mask[i];
+    }
+    das4q_gamma_lut(lut, 2.2);
+
+    json_object(json, "kernels");
+    json_string(json, "best_isa", das4q_isa_name(best));
+    json_uint(json, "iterations", iterations);
+    // ns per call, null where the CPU doesn't have the instruction set
+    json_object(json, "ns_per_frame");
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        json_object(json, kernels[k].name);
+        for (int isa = DAS4Q_ISA_SCALAR; isa <= DAS4Q_ISA_AVX2; isa++) {
+            if (!das4q_planes_set_isa(isa)) {
+                json_null(json, das4q_isa_name(isa));
+                continue;
+            }
+            double start = now_ns();
+            for (long i = 0; i < iterations; i++) {
+                kernels[k].fn();
+                // Keep the compiler from dropping repeated calls
+                __asm__ volatile("" ::: "memory");
+            }
+            json_double(json, das4q_isa_name(isa),
+                        (now_ns() - start) / iterations);
+        }
+        json_end_object(json);
+    }
+    json_end_object(json);
+    json_end_object(json);
+    das4q_planes_set_isa(best);
+}
@@ -0,0 +1,28 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAS4Q_BENCH_KERNELS_H
+#define DAS4Q_BENCH_KERNELS_H
+
+#include "json.h"
+
+/*
+ * Times each das4q_planes.h kernel on a full frame, for every instruction
+ * set the CPU supports, into a "kernels" object.
+ *
+ *  iterations: calls per kernel and instruction set
+ */
+void run_kernels(json_t *json, long iterations);
+
+#endif  // DAS4Q_BENCH_KERNELS_H
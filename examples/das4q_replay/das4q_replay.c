@@ -0,0 +1,326 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <argp.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "das4q_log.h"
+#include "das4q_record.h"
+#include "das4q_transport.h"
+#include "libdas4q.h"
+
+/*
+ * Replays a recording through the protocol code.
+ *
+ * The frames the recorded session sent are rebuilt from its SET_REPORTs,
+ * then sent again with das4q_update_frame against a replay of the same
+ * recording, so the keyboard's answers, failures included, come back as
+ * they did at the time.  Changes to the protocol code show up as a
+ * different time, or as SET_REPORTs that no longer match.
+ */
+
+// Longest command the keyboard takes, its size byte plus two
+#define CMD_MAX 16
+
+typedef struct frame {
+    das4q_setting_t settings[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t active[DAS4Q_NUM_KEYS];
+    bool update;  // Has keys set, rather than being an apply on its own
+    bool apply;   // Ended in an apply rather than the end of the recording
+} frame_t;
+
+typedef struct frames {
+    frame_t *frames;
+    int count;
+    int cap;
+    frame_t next;  // Built up until the next apply
+    bool dirty;    // next has keys set since the last apply
+
+    uint8_t cmd[CMD_MAX];
+    int cmd_len;
+    uint64_t cmds;
+} frames_t;
+
+const char *argp_program_version = "das4q_replay 0.01";
+const char *argp_program_bug_address = "paerley@gmail.com";
+static char doc[] =
+    "Replays a recording made with DAS4Q_RECORD or das_udev --record "
+    "through libdas4q, without the keyboard.";
+static char args_doc[] = "RECORDING";
+static struct argp_option options[] = {
+    {"speed", 's', "factor", 0,
+     "1 waits as long as the keyboard took, 2 half as long, 0 (default) "
+     "not at all"},
+    {"repeat", 'n', "count", 0, "Times to run the recording (default 1)"},
+    {"ack-window", 'w', "keys", 0, "Ack window to replay with (default 1)"},
+    {"verbose", 'v', 0, 0, "Log what the library does"},
+    {0}};
+
+struct arguments {
+    char *path;
+    double speed;
+    int repeat;
+    int ack_window;
+    bool verbose;
+};
+
+static error_t parse_opt(int key, char *arg, struct argp_state *state) {
+    struct arguments *arguments = state->input;
+    switch (key) {
+        case 's':
+            arguments->speed = strtod(arg, NULL);
+            if (arguments->speed < 0) {
+                argp_usage(state);
+            }
+            break;
+        case 'n':
+            arguments->repeat = atoi(arg);
+            if (arguments->repeat <= 0) {
+                argp_usage(state);
+            }
+            break;
+        case 'w':
+            arguments->ack_window = atoi(arg);
+            if (arguments->ack_window < 1 ||
+                arguments->ack_window > DAS4Q_MAX_ACK_WINDOW) {
+                argp_usage(state);
+            }
+            break;
+        case 'v':
+            arguments->verbose = true;
+            break;
+        case ARGP_KEY_ARG:
+            if (state->arg_num >= 1) {
+                argp_usage(state);
+            }
+            arguments->path = arg;
+            break;
+        case ARGP_KEY_END:
+            if (state->arg_num < 1) {
+                argp_usage(state);
+            }
+            break;
+        default:
+            return ARGP_ERR_UNKNOWN;
+    }
+    return 0;
+}
+
+static struct argp argp = {options, parse_opt, args_doc, doc};
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static bool frames_push(frames_t *frames, bool apply) {
+    if (frames->count == frames->cap) {
+        int cap = frames->cap ? 2 * frames->cap : 64;
+        frame_t *bigger = realloc(frames->frames, cap * sizeof(frame_t));
+        if (bigger == NULL) {
+            return false;
+        }
+        frames->frames = bigger;
+        frames->cap = cap;
+    }
+    frames->next.update = frames->dirty;
+    frames->next.apply = apply;
+    frames->frames[frames->count++] = frames->next;
+    frames->dirty = false;
+    return true;
+}
+
+// A whole command, as das4q_build_key_cmds and friends lay them out.
+static bool frames_cmd(frames_t *frames, const uint8_t *cmd) {
+    const uint8_t type = cmd[3];
+    const uint8_t key = cmd[4];
+
+    frames->cmds++;
+    if (cmd[2] != 0x78) {
+        // The version query, which opening the replay sends anyway
+        return true;
+    }
+    if (type == 0x08 && cmd[1] == 0x08 && key < DAS4Q_NUM_KEYS) {
+        frames->next.settings[key] = (das4q_setting_t){
+            .mode = cmd[5], .red = cmd[6], .green = cmd[7], .blue = cmd[8]};
+        frames->dirty = true;
+    } else if (type == 0x04 && cmd[1] == 0x0b && key < DAS4Q_NUM_KEYS) {
+        frames->next.active[key] = (das4q_active_setting_t){
+            .mode = cmd[5],
+            .red = cmd[6],
+            .green = cmd[7],
+            .blue = cmd[8],
+            .unk = {cmd[9], cmd[10], cmd[11]}};
+        frames->dirty = true;
+    } else if (type == 0x0a) {
+        return frames_push(frames, true);
+    }
+    return true;
+}
+
+/*
+ * Feeds the command stream of one SET_REPORT through.  Commands run on
+ * across reports, and the gaps between them are zero padded.
+ */
+static bool frames_feed(frames_t *frames, const uint8_t *data, int len) {
+    for (int i = 1; i < len; i++) {
+        if (frames->cmd_len == 0 && data[i] != 0xea) {
+            continue;
+        }
+        frames->cmd[frames->cmd_len++] = data[i];
+        if (frames->cmd_len < 2) {
+            continue;
+        }
+        int want = frames->cmd[1] + 2;
+        if (want > CMD_MAX) {
+            // Not a command after all
+            frames->cmd_len = 0;
+            continue;
+        }
+        if (frames->cmd_len == want) {
+            frames->cmd_len = 0;
+            if (!frames_cmd(frames, frames->cmd)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Rebuilds the frames the recorded session sent.
+static bool frames_load(frames_t *frames, das4q_replay_t *replay) {
+    for (int i = 0; i < das4q_replay_count(replay); i++) {
+        const uint8_t *data;
+        const das4q_record_t *record = das4q_replay_record(replay, i, &data);
+        // The keyboard never saw reports that failed
+        if (record->in || record->ret < 0) {
+            continue;
+        }
+        if (!frames_feed(frames, data, record->len)) {
+            return false;
+        }
+    }
+    return !frames->dirty || frames_push(frames, false);
+}
+
+// Total time the recorded session spent, from its first report to the end
+// of its last.
+static uint64_t recorded_us(das4q_replay_t *replay) {
+    uint64_t us = 0;
+    int count = das4q_replay_count(replay);
+
+    for (int i = 1; i < count; i++) {
+        us += das4q_replay_record(replay, i, NULL)->delta_us;
+    }
+    if (count > 0) {
+        us += das4q_replay_record(replay, count - 1, NULL)->duration_us;
+    }
+    return us;
+}
+
+static bool run(const struct arguments *arguments, das4q_replay_t *replay,
+                const frames_t *frames) {
+    das4q_stats_t stats;
+    int failed = 0;
+
+    das4q_replay_rewind(replay);
+    uint64_t start = now_us();
+    // The recording has its own clear, if it was opened with one
+    das4q_handle handle = das4q_open_transport_flags(
+        &das4q_replay_transport, replay, DAS4Q_INIT_NO_CLEAR);
+    if (handle == NULL) {
+        fprintf(stderr, "Failed to open the replay\n");
+        return false;
+    }
+    das4q_set_ack_window(handle, arguments->ack_window);
+    for (int i = 0; i < frames->count; i++) {
+        const frame_t *frame = &frames->frames[i];
+        if (frame->update &&
+            das4q_update_frame(handle, frame->settings, frame->active) < 0) {
+            failed++;
+        }
+        if (frame->apply && !das4q_apply_changes(handle)) {
+            failed++;
+        }
+    }
+    das4q_get_stats(handle, &stats);
+    das4q_close_device(handle);
+    uint64_t us = now_us() - start;
+
+    printf("  %.3f ms, %d failed updates, %llu key retries, %llu ack "
+           "timeouts\n",
+           us / 1000.0, failed, (unsigned long long)stats.key_retries,
+           (unsigned long long)stats.ack_timeouts);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    struct arguments arguments = {
+        .path = NULL,
+        .speed = 0,
+        .repeat = 1,
+        .ack_window = 1,
+        .verbose = false,
+    };
+    frames_t frames = {0};
+    das4q_replay_stats_t stats;
+    int ret = 1;
+
+    argp_parse(&argp, argc, argv, 0, 0, &arguments);
+    das4q_set_log_level(arguments.verbose ? DAS4Q_LOG_DEBUG
+                                          : DAS4Q_LOG_WARN);
+
+    das4q_replay_config_t config = {.speed = arguments.speed};
+    das4q_replay_t *replay = das4q_replay_new(arguments.path, &config);
+    if (replay == NULL) {
+        fprintf(stderr, "Can't load %s: %s\n", arguments.path,
+                strerror(abs(errno)));
+        return 1;
+    }
+    if (!frames_load(&frames, replay)) {
+        fprintf(stderr, "Out of memory\n");
+        goto cleanup;
+    }
+    printf("%s: %d reports over %.3f ms, %llu commands, %d frames\n",
+           arguments.path, das4q_replay_count(replay),
+           recorded_us(replay) / 1000.0, (unsigned long long)frames.cmds,
+           frames.count);
+
+    for (int i = 0; i < arguments.repeat; i++) {
+        if (!run(&arguments, replay, &frames)) {
+            goto cleanup;
+        }
+    }
+
+    das4q_replay_get_stats(replay, &stats);
+    printf("%llu SET and %llu GET reports, %llu mismatched, %llu past the "
+           "end\n",
+           (unsigned long long)stats.set_reports,
+           (unsigned long long)stats.get_reports,
+           (unsigned long long)stats.set_mismatches,
+           (unsigned long long)stats.overruns);
+    ret = 0;
+
+cleanup:
+    free(frames.frames);
+    das4q_replay_free(replay);
+    return ret;
+}
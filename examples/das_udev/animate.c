@@ -0,0 +1,236 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "animate.h"
+
+#include <errno.h>
+#include <math.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "config.h"
+#include "das4q_anim.h"
+#include "das4q_layout.h"
+#include "das4q_plan.h"
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig) { stop = 1; }
+
+static void print_stats(das4q_anim_t *anims[], int nanims) {
+    for (int i = 0; i < nanims; i++) {
+        das4q_anim_stats_t stats;
+        das4q_anim_get_stats(anims[i], &stats);
+        printf("keyboard %d: %5.1f of %d fps, %llu dropped, "
+               "link %3.0f%% busy\n",
+               i, stats.achieved_fps, stats.target_fps,
+               (unsigned long long)stats.dropped,
+               stats.link_utilization * 100);
+    }
+}
+
+// Fades the base color in and out every two seconds
+static bool effect_breathe(uint64_t t_us,
+                           das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                           das4q_active_setting_t aframe[DAS4Q_NUM_KEYS],
+                           void *user_data) {
+    const das4q_setting_t *base = user_data;
+    double level = (1 - cos(t_us * 2 * M_PI / 2000000.0)) / 2;
+
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        frame[i].mode = DAS4Q_MODE_SOLID;
+        frame[i].red = base->red * level;
+        frame[i].green = base->green * level;
+        frame[i].blue = base->blue * level;
+    }
+    return true;
+}
+
+// One key at a time in the base color, walking the key codes
+static bool effect_sweep(uint64_t t_us, das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                         das4q_active_setting_t aframe[DAS4Q_NUM_KEYS],
+                         void *user_data) {
+    const das4q_setting_t *base = user_data;
+    int lit = (t_us / 50000) % DAS4Q_NUM_KEYS;
+
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        frame[i].mode = DAS4Q_MODE_SOLID;
+        frame[i].red = i == lit ? base->red : 0;
+        frame[i].green = i == lit ? base->green : 0;
+        frame[i].blue = i == lit ? base->blue : 0;
+    }
+    return true;
+}
+
+// Rings of the base color spreading out from the space bar
+static bool effect_ripple(uint64_t t_us,
+                          das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                          das4q_active_setting_t aframe[DAS4Q_NUM_KEYS],
+                          void *user_data) {
+    const das4q_setting_t *base = user_data;
+    const uint8_t *distance = das4q_key_distances(KEY_SPACE);
+    // Two key widths per ring, four key widths a second
+    double front = t_us * 4.0 * DAS4Q_LAYOUT_UNIT / 1000000.0;
+
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        double level = 0;
+        if (distance[i] != DAS4Q_LAYOUT_NO_KEY) {
+            level = (1 + cos((front - distance[i]) * M_PI /
+                             DAS4Q_LAYOUT_UNIT)) / 2;
+        }
+        frame[i].mode = DAS4Q_MODE_SOLID;
+        frame[i].red = base->red * level;
+        frame[i].green = base->green * level;
+        frame[i].blue = base->blue * level;
+    }
+    return true;
+}
+
+static const struct {
+    const char *name;
+    das4q_effect_kind_t kind;
+} planned[] = {
+    {"pulse", DAS4Q_EFFECT_PULSE},
+    {"blink", DAS4Q_EFFECT_BLINK},
+    {"cycle", DAS4Q_EFFECT_CYCLE},
+};
+
+/*
+ * Plans effect on every keyboard and uploads it.
+ *
+ *  returns: keys the host still has to draw over all keyboards, -1 on
+ *           error.
+ */
+static int upload_plans(das4q_plan_t *plans[], das4q_handle handles[],
+                        int nhandles, das4q_effect_kind_t kind,
+                        unsigned int period_ms, das4q_setting_t base) {
+    das4q_effect_request_t request = {.kind = kind,
+                                      .trigger = DAS4Q_TRIGGER_ALWAYS,
+                                      .red = base.red,
+                                      .green = base.green,
+                                      .blue = base.blue,
+                                      .period_ms = period_ms,
+                                      .tolerance_pct = 10};
+    int host_keys = 0;
+
+    for (int i = 0; i < nhandles; i++) {
+        plans[i] = das4q_plan_new(handles[i]);
+        if (plans[i] == NULL || das4q_plan_add(plans[i], &request) < 0 ||
+            das4q_plan_upload(plans[i]) < 0) {
+            printf("Failed to set up keyboard %d\n", i);
+            return -1;
+        }
+        host_keys += das4q_plan_host_keys(plans[i]);
+    }
+    return host_keys;
+}
+
+int run_animation(das4q_handle handles[], int nhandles, const char *effect,
+                  int fps, unsigned int period_ms, das4q_setting_t base) {
+    das4q_anim_t *anims[DAS_UDEV_MAX_KEYBOARDS];
+    das4q_plan_t *plans[DAS_UDEV_MAX_KEYBOARDS] = {0};
+    void *user_data[DAS_UDEV_MAX_KEYBOARDS];
+    struct pollfd fds[DAS_UDEV_MAX_KEYBOARDS];
+    das4q_effect_fn fn = NULL;
+    struct sigaction sa = {.sa_handler = on_signal};
+    int nanims = 0;
+    int ret = 0;
+
+    for (int i = 0; i < nhandles; i++) {
+        user_data[i] = &base;
+    }
+    if (strcmp(effect, "breathe") == 0) {
+        fn = effect_breathe;
+    } else if (strcmp(effect, "sweep") == 0) {
+        fn = effect_sweep;
+    } else if (strcmp(effect, "ripple") == 0) {
+        fn = effect_ripple;
+    }
+    for (size_t i = 0; i < sizeof(planned) / sizeof(planned[0]); i++) {
+        if (strcmp(effect, planned[i].name) != 0) {
+            continue;
+        }
+        int host_keys = upload_plans(plans, handles, nhandles,
+                                     planned[i].kind, period_ms, base);
+        if (host_keys < 0) {
+            ret = 1;
+            goto cleanup;
+        }
+        if (host_keys == 0) {
+            printf("The keyboard plays %s by itself\n", effect);
+            goto cleanup;
+        }
+        fn = das4q_plan_effect;
+        for (int j = 0; j < nhandles; j++) {
+            user_data[j] = plans[j];
+        }
+    }
+    if (fn == NULL) {
+        printf("Unknown effect %s, try breathe, sweep, ripple, pulse, blink "
+               "or cycle\n",
+               effect);
+        return 1;
+    }
+
+    // No SA_RESTART, poll needs to come back with EINTR
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    for (; nanims < nhandles; nanims++) {
+        anims[nanims] = das4q_anim_new(handles[nanims], fps);
+        if (anims[nanims] == NULL) {
+            printf("Can't animate at %d fps\n", fps);
+            ret = 1;
+            goto cleanup;
+        }
+        das4q_anim_add_effect(anims[nanims], fn, user_data[nanims]);
+        das4q_anim_start(anims[nanims]);
+        fds[nanims].fd = das4q_anim_get_fd(anims[nanims]);
+        fds[nanims].events = POLLIN;
+    }
+
+    printf("Playing %s at %d fps, ^C to stop\n", effect, fps);
+    time_t last_print = time(NULL);
+    while (!stop) {
+        int n = poll(fds, nanims, 1000);
+        if (n < 0 && errno != EINTR) {
+            perror("poll");
+            ret = 1;
+            break;
+        }
+        for (int i = 0; n > 0 && i < nanims; i++) {
+            if (fds[i].revents & POLLIN) {
+                das4q_anim_dispatch(anims[i]);
+            }
+        }
+        if (time(NULL) != last_print) {
+            last_print = time(NULL);
+            print_stats(anims, nanims);
+        }
+    }
+    print_stats(anims, nanims);
+
+cleanup:
+    for (int i = 0; i < nanims; i++) {
+        das4q_anim_free(anims[i]);
+    }
+    for (int i = 0; i < nhandles; i++) {
+        das4q_plan_free(plans[i]);
+    }
+    return ret;
+}
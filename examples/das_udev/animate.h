@@ -0,0 +1,36 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAS_UDEV_ANIMATE_H
+#define DAS_UDEV_ANIMATE_H
+
+#include "libdas4q.h"
+
+/*
+ * Plays one of the built in effects on every keyboard until SIGINT or
+ * SIGTERM, printing the frame rate achieved every second.  pulse, blink
+ * and cycle are left to the firmware when it runs them at period_ms, and
+ * then return straight away with the keyboard still playing them.
+ *
+ *  effect: "breathe", "sweep", "ripple", "pulse", "blink" or "cycle"
+ *  period_ms: for pulse, blink and cycle, 0 for the firmware's own rate
+ *  base: color the effect works from
+ *
+ *  returns: process exit code.
+ */
+int run_animation(das4q_handle handles[], int nhandles, const char *effect,
+                  int fps, unsigned int period_ms, das4q_setting_t base);
+
+#endif  // DAS_UDEV_ANIMATE_H
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "arena.h"
+
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+struct arena_block {
+    arena_block_t *next;
+    size_t used;
+    size_t size;
+    alignas(max_align_t) unsigned char data[];
+};
+
+#define ARENA_ALIGN (alignof(max_align_t))
+
+void arena_init(arena_t *arena, size_t first_block, size_t limit) {
+    arena->head = NULL;
+    arena->next_size = first_block;
+    arena->total = 0;
+    arena->limit = limit;
+}
+
+void *arena_alloc(arena_t *arena, size_t size) {
+    arena_block_t *block = arena->head;
+
+    size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+    if (block == NULL || block->size - block->used < size) {
+        size_t block_size = arena->next_size;
+        if (block_size < size) {
+            block_size = size;
+        }
+        if (arena->total + block_size > arena->limit) {
+            return NULL;
+        }
+
+        block = malloc(sizeof(arena_block_t) + block_size);
+        if (block == NULL) {
+            return NULL;
+        }
+        block->next = arena->head;
+        block->used = 0;
+        block->size = block_size;
+        arena->head = block;
+        arena->total += block_size;
+        arena->next_size = block_size * 2;
+    }
+
+    void *ret = block->data + block->used;
+    block->used += size;
+    return ret;
+}
+
+void arena_free(arena_t *arena) {
+    while (arena->head != NULL) {
+        arena_block_t *block = arena->head;
+        arena->head = block->next;
+        free(block);
+    }
+    arena->total = 0;
+}
@@ -0,0 +1,42 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAS_UDEV_ARENA_H
+#define DAS_UDEV_ARENA_H
+
+#include <stddef.h>
+
+/*
+ * Bump allocator.  Allocations are never freed on their own, everything
+ * goes at once with arena_free.  Memory comes in blocks, the first sized
+ * by arena_init and each one after twice the last, up to limit in total.
+ */
+typedef struct arena_block arena_block_t;
+
+typedef struct arena {
+    arena_block_t *head;
+    size_t next_size;
+    size_t total;
+    size_t limit;
+} arena_t;
+
+void arena_init(arena_t *arena, size_t first_block, size_t limit);
+
+// returns: NULL once limit would be passed.
+void *arena_alloc(arena_t *arena, size_t size);
+
+void arena_free(arena_t *arena);
+
+#endif  // DAS_UDEV_ARENA_H
@@ -0,0 +1,242 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arena.h"
+
+// Everything a config load allocates comes out of one arena, freed in one
+// go when the frame is built.  Configs much bigger than this are refused.
+#define CONFIG_ARENA_LIMIT (64 << 20)
+
+static arena_t *cjson_arena;
+
+static void *cjson_arena_malloc(size_t size) {
+    return arena_alloc(cjson_arena, size);
+}
+
+// Freed along with the rest of the arena
+static void cjson_arena_free(void *ptr) {}
+
+static void print_node(const char *msg, cJSON *node) {
+    char *json = cJSON_PrintUnformatted(node);
+    printf("%s\n %s\n", msg, json != NULL ? json : "?");
+    cJSON_free(json);
+}
+
+bool parse_setting(cJSON *node, das4q_setting_t *setting) {
+    cJSON *mode = cJSON_GetObjectItem(node, "mode");
+    cJSON *red = cJSON_GetObjectItem(node, "red");
+    cJSON *green = cJSON_GetObjectItem(node, "green");
+    cJSON *blue = cJSON_GetObjectItem(node, "blue");
+
+    if (mode == NULL || red == NULL || green == NULL || blue == NULL) {
+        print_node("Failed parsing node, missing values:", node);
+        return false;
+    }
+
+    if (!cJSON_IsNumber(mode) || !cJSON_IsNumber(red) ||
+        !cJSON_IsNumber(green) || !cJSON_IsNumber(blue)) {
+        print_node("Numeric values expected:", node);
+        return false;
+    }
+
+    // We could validate this, but nah.
+    setting->mode = mode->valueint & 0xFF;
+    setting->red = red->valueint & 0xFF;
+    setting->green = green->valueint & 0xFF;
+    setting->blue = blue->valueint & 0xFF;
+    return true;
+}
+
+// I hate duplicating this just to change the type of mode, but here
+// we are.
+bool parse_active_setting(cJSON *node, das4q_active_setting_t *setting) {
+    cJSON *mode = cJSON_GetObjectItem(node, "mode");
+    cJSON *red = cJSON_GetObjectItem(node, "red");
+    cJSON *green = cJSON_GetObjectItem(node, "green");
+    cJSON *blue = cJSON_GetObjectItem(node, "blue");
+
+    if (mode == NULL || red == NULL || green == NULL || blue == NULL) {
+        print_node("Failed parsing node, missing values:", node);
+        return false;
+    }
+
+    if (!cJSON_IsNumber(mode) || !cJSON_IsNumber(red) ||
+        !cJSON_IsNumber(green) || !cJSON_IsNumber(blue)) {
+        print_node("Numeric values expected:", node);
+        return false;
+    }
+
+    // We could validate this, but nah.
+    setting->mode = mode->valueint & 0xFF;
+    setting->red = red->valueint & 0xFF;
+    setting->green = green->valueint & 0xFF;
+    setting->blue = blue->valueint & 0xFF;
+    return true;
+}
+
+bool parse_key(cJSON *node, das4q_map_t *key) {
+    if (cJSON_IsString(node)) {
+        return das4q_key_from_name(node->valuestring, key);
+    }
+    if (cJSON_IsNumber(node) && node->valueint >= 0 &&
+        node->valueint < DAS4Q_NUM_KEYS) {
+        *key = node->valueint;
+        return true;
+    }
+    return false;
+}
+
+static void load_config_json(cJSON *cfg, das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                             das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]) {
+    das4q_setting_t def_set = {.mode = 1};
+    das4q_active_setting_t adef_set = {.mode = 0};
+
+    cJSON *def = cJSON_GetObjectItem(cfg, "default");
+    if (def != NULL) {
+        parse_setting(def, &def_set);
+    }
+    cJSON *adef = cJSON_GetObjectItem(cfg, "active_default");
+    if (adef != NULL) {
+        parse_active_setting(adef, &adef_set);
+    }
+
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        frame[i] = def_set;
+        aframe[i] = adef_set;
+    }
+
+    cJSON *conf_array = cJSON_GetObjectItem(cfg, "keys");
+    cJSON *c = NULL;
+    cJSON_ArrayForEach(c, conf_array) {
+        if (!apply_key_entry(c, frame, aframe)) {
+            print_node("Something wrong:", c);
+        }
+    }
+}
+
+bool load_config_file(char *config_file,
+                      das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                      das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]) {
+    FILE *fp = fopen(config_file, "r");
+    if (fp == NULL) {
+        printf("Failed to open %s\n", config_file);
+        return false;
+    }
+
+    fseek(fp, 0, SEEK_END);
+    long fsize = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (fsize < 0) {
+        printf("Failed to read %s\n", config_file);
+        fclose(fp);
+        return false;
+    }
+
+    // Sized so the text and its parse tree usually fit in the first block
+    arena_t arena;
+    arena_init(&arena, fsize * 8 + 4096, CONFIG_ARENA_LIMIT);
+
+    bool ok = false;
+    // +1 keeps it nul terminated for cJSON_Parse
+    char *config_json = arena_alloc(&arena, fsize + 1);
+    if (config_json == NULL ||
+        fread(config_json, 1, fsize, fp) != (size_t)fsize) {
+        printf("Failed to read %s\n", config_file);
+        goto cleanup;
+    }
+    config_json[fsize] = '\0';
+
+    cJSON_Hooks hooks = {cjson_arena_malloc, cjson_arena_free};
+    cjson_arena = &arena;
+    cJSON_InitHooks(&hooks);
+
+    cJSON *cfg = cJSON_Parse(config_json);
+    if (cfg == NULL) {
+        printf("Failed to parse %s\n", config_file);
+    } else {
+        load_config_json(cfg, frame, aframe);
+        ok = true;
+    }
+
+    // Back to malloc for everyone else
+    cJSON_InitHooks(NULL);
+    cjson_arena = NULL;
+
+cleanup:
+    arena_free(&arena);
+    fclose(fp);
+    return ok;
+}
+
+void update_keyboards(das4q_handle handles[], int nhandles,
+                      const das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                      const das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]) {
+    const das4q_setting_t *frames[DAS_UDEV_MAX_KEYBOARDS];
+    const das4q_active_setting_t *aframes[DAS_UDEV_MAX_KEYBOARDS];
+    int results[DAS_UDEV_MAX_KEYBOARDS];
+
+    if (nhandles <= 0 || nhandles > DAS_UDEV_MAX_KEYBOARDS) {
+        return;
+    }
+    for (int i = 0; i < nhandles; i++) {
+        frames[i] = frame;
+        aframes[i] = aframe;
+    }
+    das4q_update_frames(handles, nhandles, frames, aframes, results);
+
+    for (int i = 0; i < nhandles; i++) {
+        // An unplugged keyboard gets the frame when it comes back
+        if (!das4q_is_connected(handles[i])) {
+            continue;
+        }
+        if (results[i] < 0) {
+            printf("Some keys failed to update on keyboard %d\n", i);
+        }
+        das4q_apply_changes(handles[i]);
+    }
+}
+
+bool apply_key_entry(cJSON *entry, das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                     das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]) {
+    cJSON *k = cJSON_GetObjectItem(entry, "key");
+    cJSON *cnode = cJSON_GetObjectItem(entry, "setting");
+    cJSON *anode = cJSON_GetObjectItem(entry, "active_setting");
+    das4q_setting_t set;
+    das4q_active_setting_t aset;
+    das4q_map_t key;
+
+    if (k == NULL || !parse_key(k, &key) || (cnode == NULL && anode == NULL)) {
+        return false;
+    }
+    if (cnode != NULL && !parse_setting(cnode, &set)) {
+        return false;
+    }
+    if (anode != NULL && !parse_active_setting(anode, &aset)) {
+        return false;
+    }
+
+    if (cnode != NULL) {
+        frame[key] = set;
+    }
+    if (anode != NULL) {
+        aframe[key] = aset;
+    }
+    return true;
+}
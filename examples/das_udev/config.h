@@ -0,0 +1,71 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAS_UDEV_CONFIG_H
+#define DAS_UDEV_CONFIG_H
+
+#include <stdbool.h>
+
+#include "cjson/cJSON.h"
+#include "libdas4q.h"
+
+/*
+ * Reads a {"mode": ..., "red": ..., "green": ..., "blue": ...} node.
+ *
+ *  returns: false, leaving setting alone, if the node is malformed.
+ */
+bool parse_setting(cJSON *node, das4q_setting_t *setting);
+bool parse_active_setting(cJSON *node, das4q_active_setting_t *setting);
+
+/*
+ * Reads a key, either its number or its name from keymap.h, e.g.
+ * "KEY_ESCAPE".
+ *
+ *  returns: false if there's no such key.
+ */
+bool parse_key(cJSON *node, das4q_map_t *key);
+
+/*
+ * Resolves a config file into a full frame, keys the file doesn't mention
+ * get its defaults.  Everything parsed lives in one arena, gone again by
+ * the time this returns.
+ *
+ *  returns: false if the file couldn't be read or parsed.
+ */
+bool load_config_file(char *config_file,
+                      das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                      das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]);
+
+// Most keyboards das_udev will drive at once
+#define DAS_UDEV_MAX_KEYBOARDS 8
+
+/*
+ * Sends one frame to every keyboard in parallel, and applies it.  Does
+ * nothing unless there are 1 to DAS_UDEV_MAX_KEYBOARDS handles.
+ */
+void update_keyboards(das4q_handle handles[], int nhandles,
+                      const das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                      const das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]);
+
+/*
+ * Applies one {"key": ..., "setting": ..., "active_setting": ...} entry,
+ * as found in a config's "keys" array, to a frame.  Either setting may be
+ * left out.  Nothing is changed if any of it is malformed.
+ *
+ *  returns: false if the entry is malformed.
+ */
+bool apply_key_entry(cJSON *entry, das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                     das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]);
+
+#endif  // DAS_UDEV_CONFIG_H
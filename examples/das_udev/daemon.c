@@ -0,0 +1,436 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#define _GNU_SOURCE  // accept4
+#include "daemon.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "cjson/cJSON.h"
+#include "config.h"
+
+#define MAX_CLIENTS 16
+#define MAX_USB_FDS (4 * DAS_UDEV_MAX_KEYBOARDS)
+
+typedef struct daemon_client {
+    int fd;
+    char buf[4096];
+    size_t len;
+} daemon_client_t;
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig) { stop = 1; }
+
+static int open_socket(const char *socket_path) {
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        printf("Socket path too long: %s\n", socket_path);
+        return -1;
+    }
+    strcpy(addr.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0) {
+        perror("socket");
+        return -1;
+    }
+    // Left behind by a previous run that didn't shut down cleanly
+    unlink(socket_path);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        listen(fd, MAX_CLIENTS) < 0) {
+        perror(socket_path);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*
+ * Watches the directory the config file is in rather than the file, so a
+ * save is seen however the editor does it: written in place, or written
+ * elsewhere and renamed over it.
+ *
+ *  returns: the inotify descriptor, -1 on error.
+ */
+static int watch_config(const char *config_file) {
+    char dir[PATH_MAX];
+    const char *slash = strrchr(config_file, '/');
+
+    if (slash == NULL) {
+        strcpy(dir, ".");
+    } else if (slash == config_file) {
+        strcpy(dir, "/");
+    } else if ((size_t)(slash - config_file) < sizeof(dir)) {
+        memcpy(dir, config_file, slash - config_file);
+        dir[slash - config_file] = '\0';
+    } else {
+        return -1;
+    }
+
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        perror("inotify_init1");
+        return -1;
+    }
+    if (inotify_add_watch(fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        perror(dir);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*
+ * Drains the watch.  An editor's save can take several events, they all
+ * come down to one reload.
+ *
+ *  returns: true if the config file was written or replaced.
+ */
+static bool config_saved(int fd, const char *config_file) {
+    char buf[4096]
+        __attribute__((aligned(__alignof__(struct inotify_event))));
+    const char *slash = strrchr(config_file, '/');
+    const char *name = slash != NULL ? slash + 1 : config_file;
+    bool saved = false;
+
+    for (;;) {
+        ssize_t len = read(fd, buf, sizeof(buf));
+        if (len < 0 && errno == EINTR) {
+            continue;
+        }
+        if (len <= 0) {
+            return saved;
+        }
+        for (char *p = buf; p < buf + len;) {
+            const struct inotify_event *event = (void *)p;
+            if (event->len > 0 && strcmp(event->name, name) == 0) {
+                saved = true;
+            }
+            p += sizeof(*event) + event->len;
+        }
+    }
+}
+
+/*
+ * Reads the config file again, and moves the keys whose resolved settings
+ * changed in it over to the frame.
+ *
+ *  config, aconfig: what the file resolved to last time, updated
+ *
+ *  returns: number of keys that changed, -1 if the file didn't load.
+ */
+static int reload_config(char *config_file,
+                         das4q_setting_t config[DAS4Q_NUM_KEYS],
+                         das4q_active_setting_t aconfig[DAS4Q_NUM_KEYS],
+                         das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                         das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]) {
+    das4q_setting_t next[DAS4Q_NUM_KEYS] = {0};
+    das4q_active_setting_t anext[DAS4Q_NUM_KEYS] = {0};
+    int changed = 0;
+
+    if (!load_config_file(config_file, next, anext)) {
+        return -1;
+    }
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        if (memcmp(&next[i], &config[i], sizeof(next[i])) == 0 &&
+            memcmp(&anext[i], &aconfig[i], sizeof(anext[i])) == 0) {
+            continue;
+        }
+        config[i] = frame[i] = next[i];
+        aconfig[i] = aframe[i] = anext[i];
+        changed++;
+    }
+    return changed;
+}
+
+static double ms_since(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000.0 +
+           (now.tv_nsec - start->tv_nsec) / 1000000.0;
+}
+
+static void handle_json(cJSON *json, das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                        das4q_active_setting_t aframe[DAS4Q_NUM_KEYS],
+                        bool *changed) {
+    cJSON *keys = cJSON_GetObjectItem(json, "keys");
+
+    if (keys == NULL) {
+        if (apply_key_entry(json, frame, aframe)) {
+            *changed = true;
+        } else {
+            printf("Bad key update\n");
+        }
+        return;
+    }
+
+    cJSON *c = NULL;
+    cJSON_ArrayForEach(c, keys) {
+        if (apply_key_entry(c, frame, aframe)) {
+            *changed = true;
+        } else {
+            printf("Bad key update\n");
+        }
+    }
+}
+
+/*
+ * Applies every complete message in a client's buffer to the frame.
+ *
+ *  returns: false if the client should be dropped.
+ */
+static bool handle_messages(daemon_client_t *client,
+                            das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                            das4q_active_setting_t aframe[DAS4Q_NUM_KEYS],
+                            bool *changed) {
+    size_t off = 0;
+
+    while (off < client->len) {
+        char *msg = client->buf + off;
+        size_t avail = client->len - off;
+
+        if ((uint8_t)msg[0] == DAS_UDEV_MSG_MAGIC) {
+            das_udev_msg_t bin;
+            if (avail < sizeof(bin)) {
+                break;
+            }
+            memcpy(&bin, msg, sizeof(bin));
+            off += sizeof(bin);
+            if (bin.key >= DAS4Q_NUM_KEYS) {
+                printf("Bad key 0x%02x\n", bin.key);
+                continue;
+            }
+            frame[bin.key] = bin.setting;
+            aframe[bin.key] = bin.active_setting;
+            *changed = true;
+            continue;
+        }
+
+        char *nl = memchr(msg, '\n', avail);
+        if (nl == NULL) {
+            break;
+        }
+        off += nl - msg + 1;
+
+        // Blank lines are fine, anything else has to parse
+        size_t i = 0;
+        while (msg + i < nl && (msg[i] == ' ' || msg[i] == '\t' ||
+                                msg[i] == '\r')) {
+            i++;
+        }
+        if (msg + i == nl) {
+            continue;
+        }
+        cJSON *json = cJSON_ParseWithLength(msg, nl - msg);
+        if (json == NULL) {
+            printf("Bad JSON from client\n");
+            continue;
+        }
+        handle_json(json, frame, aframe, changed);
+        cJSON_Delete(json);
+    }
+
+    memmove(client->buf, client->buf + off, client->len - off);
+    client->len -= off;
+    // A full buffer with no complete message in it never will have one
+    return client->len < sizeof(client->buf);
+}
+
+/*
+ * Drains a readable client.
+ *
+ *  returns: false once the client has gone away.
+ */
+static bool read_client(daemon_client_t *client,
+                        das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                        das4q_active_setting_t aframe[DAS4Q_NUM_KEYS],
+                        bool *changed) {
+    for (;;) {
+        ssize_t ret = read(client->fd, client->buf + client->len,
+                           sizeof(client->buf) - client->len);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        }
+        if (ret <= 0) {
+            // Let a last JSON line get away without its newline
+            if (client->len > 0 && client->len < sizeof(client->buf)) {
+                client->buf[client->len++] = '\n';
+                handle_messages(client, frame, aframe, changed);
+            }
+            return false;
+        }
+        client->len += ret;
+        if (!handle_messages(client, frame, aframe, changed)) {
+            printf("Client sent an oversized message, dropping it\n");
+            return false;
+        }
+    }
+}
+
+int run_daemon(das4q_handle handles[], int nhandles, const char *socket_path,
+               char *config_file, das4q_setting_t frame[DAS4Q_NUM_KEYS],
+               das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]) {
+    static daemon_client_t clients[MAX_CLIENTS];
+    static das4q_setting_t config[DAS4Q_NUM_KEYS];
+    static das4q_active_setting_t aconfig[DAS4Q_NUM_KEYS];
+    int nclients = 0;
+    int watch_fd = -1;
+    struct sigaction sa = {.sa_handler = on_signal};
+
+    // No SA_RESTART, poll needs to come back with EINTR
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    int listen_fd = open_socket(socket_path);
+    if (listen_fd < 0) {
+        return 1;
+    }
+    printf("Listening on %s\n", socket_path);
+
+    if (config_file != NULL) {
+        watch_fd = watch_config(config_file);
+        if (watch_fd >= 0) {
+            printf("Watching %s for changes\n", config_file);
+        }
+        memcpy(config, frame, sizeof(config));
+        memcpy(aconfig, aframe, sizeof(aconfig));
+    }
+
+    update_keyboards(handles, nhandles, frame, aframe);
+
+    // Survive KVM switches and suspends.  Only works over libusb.
+    bool hotplug[DAS_UDEV_MAX_KEYBOARDS];
+    for (int i = 0; i < nhandles; i++) {
+        hotplug[i] = das4q_enable_hotplug(handles[i], NULL, NULL) == 0;
+    }
+
+    while (!stop) {
+        struct pollfd fds[MAX_CLIENTS + 2 + MAX_USB_FDS];
+        bool changed = false;
+        int nfds = nclients + 2;
+        int timeout = -1;
+
+        fds[0].fd = listen_fd;
+        fds[0].events = POLLIN;
+        for (int i = 0; i < nclients; i++) {
+            fds[i + 1].fd = clients[i].fd;
+            fds[i + 1].events = POLLIN;
+        }
+        // Negative while there's no watch, which poll skips
+        fds[nclients + 1].fd = watch_fd;
+        fds[nclients + 1].events = POLLIN;
+        for (int i = 0; i < nhandles; i++) {
+            if (!hotplug[i]) {
+                continue;
+            }
+            int room = MAX_CLIENTS + 2 + MAX_USB_FDS - nfds;
+            int nusb = das4q_get_pollfds(handles[i], fds + nfds, room);
+            if (nusb > 0) {
+                nfds += nusb < room ? nusb : room;
+            }
+            int t = das4q_get_timeout(handles[i]);
+            if (t >= 0 && (timeout < 0 || t < timeout)) {
+                timeout = t;
+            }
+        }
+
+        if (poll(fds, nfds, timeout) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("poll");
+            break;
+        }
+
+        struct timespec reload_start;
+        int reloaded = -1;
+        if ((fds[nclients + 1].revents & POLLIN) &&
+            config_saved(watch_fd, config_file)) {
+            clock_gettime(CLOCK_MONOTONIC, &reload_start);
+            reloaded = reload_config(config_file, config, aconfig, frame,
+                                     aframe);
+            if (reloaded > 0) {
+                changed = true;
+            }
+        }
+
+        // Walk backwards so dropping a client doesn't skip the next one
+        for (int i = nclients - 1; i >= 0; i--) {
+            if (fds[i + 1].revents == 0) {
+                continue;
+            }
+            if (!read_client(&clients[i], frame, aframe, &changed)) {
+                close(clients[i].fd);
+                clients[i] = clients[--nclients];
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept4(listen_fd, NULL, NULL,
+                             SOCK_CLOEXEC | SOCK_NONBLOCK);
+            if (fd >= 0 && nclients < MAX_CLIENTS) {
+                clients[nclients].fd = fd;
+                clients[nclients].len = 0;
+                nclients++;
+            } else if (fd >= 0) {
+                printf("Too many clients\n");
+                close(fd);
+            }
+        }
+
+        for (int i = 0; i < nhandles; i++) {
+            if (hotplug[i]) {
+                // Replays the frame itself if the keyboard came back
+                das4q_handle_events(handles[i]);
+            }
+        }
+
+        // Everything that came in this time round goes out as one update
+        if (changed) {
+            update_keyboards(handles, nhandles, frame, aframe);
+        }
+        if (reloaded >= 0) {
+            printf("Reloaded %s, %d keys changed in %.1f ms\n", config_file,
+                   reloaded, ms_since(&reload_start));
+        }
+    }
+
+    for (int i = 0; i < nclients; i++) {
+        close(clients[i].fd);
+    }
+    if (watch_fd >= 0) {
+        close(watch_fd);
+    }
+    close(listen_fd);
+    unlink(socket_path);
+    return 0;
+}
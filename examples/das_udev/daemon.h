@@ -0,0 +1,58 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAS_UDEV_DAEMON_H
+#define DAS_UDEV_DAEMON_H
+
+#include <stdint.h>
+
+#include "libdas4q.h"
+
+#define DAS_UDEV_DEFAULT_SOCKET "/run/das4q.sock"
+
+#define DAS_UDEV_MSG_MAGIC 0xd4
+
+/*
+ * Binary key update for the daemon socket.
+ *
+ * JSON clients send one {"key": ..., "setting": ..., "active_setting": ...}
+ * object per line instead, or {"keys": [...]} to set several at once.
+ */
+typedef struct __attribute__((__packed__)) das_udev_msg {
+    uint8_t magic;  // DAS_UDEV_MSG_MAGIC
+    uint8_t key;
+    das4q_setting_t setting;
+    das4q_active_setting_t active_setting;
+} das_udev_msg_t;
+
+/*
+ * Keeps the keyboards open and serves key updates from a unix socket until
+ * SIGINT or SIGTERM.  Everything that arrived since the last update goes
+ * out together, and only keys that actually changed are sent.  Every
+ * keyboard shows the same frame.
+ *
+ * The config file is watched too.  When it's saved it's read again, and
+ * only the keys whose resolved settings changed in it are sent; keys it
+ * left as they were keep whatever clients last set them to.
+ *
+ *  config_file: optional, the file frame was loaded from
+ *  frame, aframe: starting state, updated as messages come in
+ *
+ *  returns: process exit code.
+ */
+int run_daemon(das4q_handle handles[], int nhandles, const char *socket_path,
+               char *config_file, das4q_setting_t frame[DAS4Q_NUM_KEYS],
+               das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]);
+
+#endif  // DAS_UDEV_DAEMON_H
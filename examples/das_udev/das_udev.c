@@ -16,159 +16,131 @@
 #include <argp.h>
 #include <stdio.h>
 #include <stdlib.h>
-
-#include "cjson/cJSON.h"
+#include <time.h>
+
+#include "animate.h"
+#include "config.h"
+#include "daemon.h"
+#include "das4q_log.h"
+#include "das4q_record.h"
+#include "das4q_sim.h"
 #include "libdas4q.h"
+#include "profile.h"
 
-das4q_setting_t *parse_setting(cJSON *node) {
-    cJSON *mode = cJSON_GetObjectItem(node, "mode");
-    cJSON *red = cJSON_GetObjectItem(node, "red");
-    cJSON *green = cJSON_GetObjectItem(node, "green");
-    cJSON *blue = cJSON_GetObjectItem(node, "blue");
-
-    if (mode == NULL || red == NULL || green == NULL || blue == NULL) {
-        printf("Failed parsing node, missing values:\n %s", cJSON_Print(node));
-        return NULL;
-    }
-
-    if (!cJSON_IsNumber(mode) || !cJSON_IsNumber(red) ||
-        !cJSON_IsNumber(green) || !cJSON_IsNumber(blue)) {
-        printf("Numeric values expected:\n %s", cJSON_Print(node));
-        return NULL;
-    }
-
-    das4q_setting_t *ret = calloc(1, sizeof(das4q_setting_t));
-    // We could validate this, but nah.
-    ret->mode = mode->valueint & 0xFF;
-    ret->red = red->valueint & 0xFF;
-    ret->green = green->valueint & 0xFF;
-    ret->blue = blue->valueint & 0xFF;
-
-    return ret;
+static double elapsed_ms(struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000.0 +
+           (now.tv_nsec - start->tv_nsec) / 1000000.0;
 }
 
-// I hate duplicating this just to change the type of mode, but here
-// we are.
-das4q_active_setting_t *parse_active_setting(cJSON *node) {
-    cJSON *mode = cJSON_GetObjectItem(node, "mode");
-    cJSON *red = cJSON_GetObjectItem(node, "red");
-    cJSON *green = cJSON_GetObjectItem(node, "green");
-    cJSON *blue = cJSON_GetObjectItem(node, "blue");
+// Times the old per-key loop against das4q_set_frame for the same frame,
+// at each ack window size.
+void run_benchmark(das4q_handle handle, das4q_setting_t set) {
+    das4q_setting_t frame[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t aframe[DAS4Q_NUM_KEYS] = {0};
+    struct timespec start;
+    int failed = 0;
 
-    if (mode == NULL || red == NULL || green == NULL || blue == NULL) {
-        printf("Failed parsing node, missing values:\n %s", cJSON_Print(node));
-        return NULL;
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        frame[i] = set;
     }
 
-    if (!cJSON_IsNumber(mode) || !cJSON_IsNumber(red) ||
-        !cJSON_IsNumber(green) || !cJSON_IsNumber(blue)) {
-        printf("Numeric values expected:\n %s", cJSON_Print(node));
-        return NULL;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        if (!das4q_set_key_backlight(handle, i, frame[i], aframe[i])) {
+            failed++;
+        }
     }
-
-    das4q_active_setting_t *ret = calloc(1, sizeof(das4q_active_setting_t));
-    // We could validate this, but nah.
-    ret->mode = mode->valueint & 0xFF;
-    ret->red = red->valueint & 0xFF;
-    ret->green = green->valueint & 0xFF;
-    ret->blue = blue->valueint & 0xFF;
-
-    return ret;
-}
-
-void apply_config_file(char *config_file, das4q_handle handle) {
-    FILE *fp = fopen(config_file, "r");
-    if (fp == NULL) {
-        printf("Failed to open %s\n", config_file);
-        return;
+    printf("per-key loop:              %8.2f ms (%d keys failed)\n",
+           elapsed_ms(&start), failed);
+
+    // Throughput of das4q_set_frame as more acks are left in flight
+    for (int window = 1; window <= DAS4Q_MAX_ACK_WINDOW; window *= 2) {
+        das4q_set_ack_window(handle, window);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        int ret = das4q_set_frame(handle, frame, aframe);
+        double ms = elapsed_ms(&start);
+        printf("das4q_set_frame window %2d: %8.2f ms %8.1f keys/s (%s)\n",
+               window, ms, DAS4Q_NUM_KEYS * 1000.0 / ms,
+               ret < 0 ? "some keys failed" : "ok");
     }
+    das4q_set_ack_window(handle, 1);
+}
 
-    fseek(fp, 0, SEEK_END);
-    long fsize = ftell(fp);
-    fseek(fp, 0, SEEK_SET);
-
-    char *config_json = calloc(fsize, sizeof(char));
-    fread(config_json, fsize, 1, fp);
-
-    cJSON *cfg = cJSON_Parse(config_json);
-    if (cfg != NULL) {
-        das4q_setting_t *def_set = NULL;
-        cJSON *def = cJSON_GetObjectItem(cfg, "default");
-        if (def != NULL) {
-            def_set = parse_setting(def);
-        }
-        if (def_set == NULL) {
-            def_set = calloc(1, sizeof(das4q_setting_t));
-            def_set->mode = 1;
-            def_set->red = 0;
-            def_set->green = 0;
-            def_set->blue = 0;
-        }
-
-        das4q_active_setting_t *adef_set = NULL;
-        cJSON *adef = cJSON_GetObjectItem(cfg, "active_default");
-        if (adef != NULL) {
-            adef_set = parse_active_setting(adef);
-        }
-        if (adef_set == NULL) {
-            adef_set = calloc(1, sizeof(das4q_active_setting_t));
-            adef_set->mode = 0;
-            adef_set->red = 0;
-            adef_set->green = 0;
-            adef_set->blue = 0;
-        }
-
-        das4q_setting_t *set_array[0x84] = {0};
-        das4q_active_setting_t *aset_array[0x84] = {0};
-
-        cJSON *conf_array = cJSON_GetObjectItem(cfg, "keys");
-        if (conf_array != NULL) {
-            cJSON *c = NULL;
-            cJSON_ArrayForEach(c, conf_array) {
-                cJSON *cnode = cJSON_GetObjectItem(c, "setting");
-                cJSON *k = cJSON_GetObjectItem(c, "key");
-                if (cnode == NULL || k == NULL || !cJSON_IsNumber(k)) {
-                    printf("Something wrong: \n%s\n",
-                           cJSON_PrintUnformatted(c));
-                    continue;
-                }
-                set_array[k->valueint] = parse_setting(cnode);
-            }
-
-            cJSON_ArrayForEach(c, conf_array) {
-                cJSON *cnode = cJSON_GetObjectItem(c, "active_setting");
-                cJSON *k = cJSON_GetObjectItem(c, "key");
-                if (cnode == NULL || k == NULL || !cJSON_IsNumber(k)) {
-                    printf("Something wrong: \n%s\n",
-                           cJSON_PrintUnformatted(c));
-                    continue;
-                }
-                aset_array[k->valueint] = parse_active_setting(cnode);
-            }
+// What the benchmark cost on the wire
+static void print_link_stats(das4q_handle handle) {
+    static const char *const names[DAS4Q_STATS_NUM_OPS] = {
+        "SET_REPORT", "GET_REPORT", "key", "stream", "apply"};
+    das4q_stats_t stats;
+
+    das4q_get_stats(handle, &stats);
+    printf("%llu SET_REPORTs, %llu GET_REPORTs, %llu bytes out, "
+           "%llu errors (%llu timeouts)\n",
+           (unsigned long long)stats.set_reports,
+           (unsigned long long)stats.get_reports,
+           (unsigned long long)stats.bytes_sent,
+           (unsigned long long)stats.transfer_errors,
+           (unsigned long long)stats.timeouts);
+    printf("%llu keys sent, %llu failed, %llu key retries, "
+           "%llu command retries, %llu bad acks, %llu missing acks\n",
+           (unsigned long long)stats.keys_sent,
+           (unsigned long long)stats.keys_failed,
+           (unsigned long long)stats.key_retries,
+           (unsigned long long)stats.cmd_retries,
+           (unsigned long long)stats.ack_mismatches,
+           (unsigned long long)stats.ack_timeouts);
+    printf("%llu us round trip, %llu ms timeout, %llu us backing off\n",
+           (unsigned long long)stats.srtt_us,
+           (unsigned long long)stats.timeout_ms,
+           (unsigned long long)stats.backoff_us);
+    for (int op = 0; op < DAS4Q_STATS_NUM_OPS; op++) {
+        const das4q_histogram_t *latency = &stats.latency[op];
+        if (latency->count == 0) {
+            continue;
         }
+        printf("%-10s %8llu, mean %8.1f us, p50 < %6llu us, "
+               "p99 < %6llu us, max %6llu us\n",
+               names[op], (unsigned long long)latency->count,
+               (double)latency->total_us / latency->count,
+               (unsigned long long)das4q_histogram_percentile(latency, 50),
+               (unsigned long long)das4q_histogram_percentile(latency, 99),
+               (unsigned long long)latency->max_us);
+    }
+}
 
-        for (int i = 0; i < 0x84; i++) {
-            das4q_setting_t *s = NULL;
-            das4q_active_setting_t *as = NULL;
-            if (set_array[i] != NULL) {
-                s = set_array[i];
-            } else {
-                s = def_set;
-            }
+// One frame to every keyboard, one after the other and then in parallel
+void run_broadcast_benchmark(das4q_handle handles[], int nhandles,
+                             das4q_setting_t set) {
+    das4q_setting_t frame[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t aframe[DAS4Q_NUM_KEYS] = {0};
+    const das4q_setting_t *frames[DAS_UDEV_MAX_KEYBOARDS];
+    const das4q_active_setting_t *aframes[DAS_UDEV_MAX_KEYBOARDS];
+    struct timespec start;
+
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        frame[i] = set;
+    }
+    for (int i = 0; i < nhandles; i++) {
+        frames[i] = frame;
+        aframes[i] = aframe;
+        das4q_invalidate_frame(handles[i]);
+    }
 
-            if (aset_array[i] != NULL) {
-                as = aset_array[i];
-            } else {
-                as = adef_set;
-            }
-            das4q_set_key_backlight(handle, i, *s, *as);
-        }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < nhandles; i++) {
+        das4q_update_frame(handles[i], frame, aframe);
+    }
+    printf("%d keyboards one by one:    %8.2f ms\n", nhandles,
+           elapsed_ms(&start));
 
-        free(def_set);
-        cJSON_free(cfg);
+    for (int i = 0; i < nhandles; i++) {
+        das4q_invalidate_frame(handles[i]);
     }
-    free(config_json);
-    fclose(fp);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int ret = das4q_update_frames(handles, nhandles, frames, aframes, NULL);
+    printf("%d keyboards in parallel:   %8.2f ms (%s)\n", nhandles,
+           elapsed_ms(&start), ret < 0 ? "some keys failed" : "ok");
 }
 
 const char *argp_program_version = "das_udev 0.01";
@@ -178,6 +150,9 @@ static char doc[] =
 static char args_doc[] = "";
 static struct argp_option options[] = {
     {"config-file", 'c', "filename", 0, "Config file to apply"},
+    {"device", 'd', "/dev/hidrawN", 0,
+     "hidraw node of the lighting interface, instead of searching with "
+     "libusb"},
     {"red", 'r', "0", 0, "Default red amount"},
     {"green", 'g', "0", 0, "Default green amount"},
     {"blue", 'b', "0", 0, "Default blue amount"},
@@ -185,14 +160,64 @@ static struct argp_option options[] = {
      "Default mode:\n"
      "1 - Solid\n"
      "31 - Blinking"},
+    {"compile", 'C', "config", 0,
+     "Compile a config file into a profile for --profile, written to "
+     "--output, without touching the keyboard"},
+    {"output", 'o', "filename", 0, "Where --compile writes the profile"},
+    {"profile", 'p', "filename", 0,
+     "Apply a profile made by --compile, which skips all the parsing"},
+    {"animate", 'A', "effect", 0,
+     "Play breathe, sweep or ripple in the default color until "
+     "interrupted.  pulse, blink and cycle are handed to the keyboard when "
+     "it can play them itself"},
+    {"fps", 'F', "30", 0, "Target frame rate for --animate"},
+    {"period", 'P', "ms", 0,
+     "Cycle length for --animate pulse, blink or cycle.  Without it the "
+     "keyboard plays them at its own rate with nothing more sent"},
+    {"daemon", 'D', 0, 0,
+     "Stay running and take key updates on a unix socket, starting from "
+     "the config file or default color.  Changes to the config file are "
+     "picked up as it's saved"},
+    {"socket", 's', "path", 0,
+     "Socket for --daemon, defaults to " DAS_UDEV_DEFAULT_SOCKET},
+    {"simulate", 'S', "latency_us", OPTION_ARG_OPTIONAL,
+     "Talk to a simulated keyboard instead, each report taking latency_us"},
+    {"benchmark", 'B', 0, 0,
+     "Time a full update per key and as one frame at each ack window, "
+     "using the default color"},
+    {"fast", 'f', 0, 0,
+     "Open without clearing the lights first, and trust the firmware "
+     "version cached in " DAS4Q_IDENTITY_CACHE " for a keyboard seen "
+     "before"},
+    {"record", 'R', "filename", 0,
+     "Record every report to and from the keyboard, for das4q_replay.  "
+     "More keyboards go to filename.1, filename.2 and so on"},
+    {"verbose", 'v', 0, 0,
+     "Log more from the library, once for debug and twice for every packet"},
+    {"quiet", 'q', 0, 0, "Only log warnings and errors from the library"},
     {0}};
 
 struct arguments {
     char *config_file;
+    char *device;
     uint8_t red;
     uint8_t green;
     uint8_t blue;
     das4q_keymode_t mode;
+    bool benchmark;
+    bool simulate;
+    unsigned int sim_latency_us;
+    bool daemon;
+    char *socket_path;
+    char *compile;
+    char *output;
+    char *profile;
+    char *animate;
+    int fps;
+    unsigned int period_ms;
+    das4q_log_level_t log_level;
+    unsigned int init_flags;
+    char *record;
 };
 
 static error_t parse_opt(int key, char *arg, struct argp_state *state) {
@@ -201,6 +226,9 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
         case 'c':
             arguments->config_file = arg;
             break;
+        case 'd':
+            arguments->device = arg;
+            break;
         case 'r':
             arguments->red = arg ? atoi(arg) : 0;
             break;
@@ -213,6 +241,51 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
         case 'm':
             arguments->mode = arg ? atoi(arg) : 1;
             break;
+        case 'B':
+            arguments->benchmark = true;
+            break;
+        case 'C':
+            arguments->compile = arg;
+            break;
+        case 'o':
+            arguments->output = arg;
+            break;
+        case 'p':
+            arguments->profile = arg;
+            break;
+        case 'A':
+            arguments->animate = arg;
+            break;
+        case 'F':
+            arguments->fps = arg ? atoi(arg) : 30;
+            break;
+        case 'P':
+            arguments->period_ms = arg ? atoi(arg) : 0;
+            break;
+        case 'D':
+            arguments->daemon = true;
+            break;
+        case 's':
+            arguments->socket_path = arg;
+            break;
+        case 'S':
+            arguments->simulate = true;
+            arguments->sim_latency_us = arg ? atoi(arg) : 0;
+            break;
+        case 'f':
+            arguments->init_flags = DAS4Q_INIT_FAST;
+            break;
+        case 'R':
+            arguments->record = arg;
+            break;
+        case 'v':
+            if (arguments->log_level < DAS4Q_LOG_TRACE) {
+                arguments->log_level++;
+            }
+            break;
+        case 'q':
+            arguments->log_level = DAS4Q_LOG_WARN;
+            break;
         case ARGP_KEY_ARG:
             return 0;
         default:
@@ -227,38 +300,137 @@ int main(int argc, char *argv[]) {
     struct arguments arguments;
 
     arguments.config_file = NULL;
+    arguments.device = NULL;
     arguments.red = 0;
     arguments.green = 0;
     arguments.blue = 0;
     arguments.mode = DAS4Q_MODE_SOLID;
+    arguments.benchmark = false;
+    arguments.simulate = false;
+    arguments.sim_latency_us = 0;
+    arguments.daemon = false;
+    arguments.socket_path = DAS_UDEV_DEFAULT_SOCKET;
+    arguments.compile = NULL;
+    arguments.output = NULL;
+    arguments.profile = NULL;
+    arguments.animate = NULL;
+    arguments.fps = 30;
+    arguments.period_ms = 0;
+    arguments.log_level = DAS4Q_LOG_INFO;
+    arguments.init_flags = DAS4Q_INIT_DEFAULT;
+    arguments.record = NULL;
 
     argp_parse(&argp, argc, argv, 0, 0, &arguments);
+    das4q_set_log_level(arguments.log_level);
+    if (arguments.record != NULL) {
+        das4q_set_record_path(arguments.record);
+    }
+
+    if (arguments.compile != NULL) {
+        das4q_setting_t set = {.mode = arguments.mode,
+                               .red = arguments.red,
+                               .green = arguments.green,
+                               .blue = arguments.blue};
+        das4q_setting_t frame[DAS4Q_NUM_KEYS];
+        das4q_active_setting_t aframe[DAS4Q_NUM_KEYS] = {0};
+        for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+            frame[i] = set;
+        }
+        if (arguments.output == NULL) {
+            printf("--compile needs --output\n");
+            exit(1);
+        }
+        if (!load_config_file(arguments.compile, frame, aframe) ||
+            !write_profile(arguments.output, frame, aframe)) {
+            exit(1);
+        }
+        exit(0);
+    }
 
-    das4q_handle handle = das4q_init_device(NULL);
-    if (handle == NULL) {
+    das4q_sim_t *sim = NULL;
+    das4q_handle handles[DAS_UDEV_MAX_KEYBOARDS];
+    int nhandles = 1;
+    if (arguments.simulate) {
+        das4q_sim_config_t config = {
+            .set_latency_us = arguments.sim_latency_us,
+            .get_latency_us = arguments.sim_latency_us};
+        sim = das4q_sim_new(&config);
+        handles[0] = das4q_open_transport_flags(&das4q_sim_transport, sim,
+                                                arguments.init_flags);
+    } else if (arguments.device != NULL) {
+        handles[0] =
+            das4q_init_device_flags(arguments.device, arguments.init_flags);
+    } else {
+        // Every keyboard on the machine
+        nhandles = das4q_init_devices_flags(handles, DAS_UDEV_MAX_KEYBOARDS,
+                                            arguments.init_flags);
+        if (nhandles < 0) {
+            nhandles = 1;
+            handles[0] = NULL;
+        }
+    }
+    if (handles[0] == NULL) {
         printf("Failed to initialize das4q\n");
         exit(1);
     }
 
-    if (arguments.config_file != NULL) {
+    das4q_setting_t set = {.mode = arguments.mode,
+                           .red = arguments.red,
+                           .green = arguments.green,
+                           .blue = arguments.blue};
+    das4q_setting_t frame[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t aframe[DAS4Q_NUM_KEYS] = {0};
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        frame[i] = set;
+    }
+
+    if (arguments.profile != NULL) {
+        printf("Using profile %s\n", arguments.profile);
+        // The daemon keeps the frame and updates it, so it starts from the
+        // profile's keys.  Otherwise the profile is streamed as it is.
+        if (arguments.daemon &&
+            !load_profile(arguments.profile, frame, aframe)) {
+            exit(1);
+        }
+    } else if (arguments.config_file != NULL) {
         printf("Using settings from %s\n", arguments.config_file);
-        apply_config_file(arguments.config_file, handle);
+        load_config_file(arguments.config_file, frame, aframe);
     } else {
         printf("Using Default RGB Color: [%i, %i, %i]\n", arguments.red,
                arguments.green, arguments.blue);
         printf("Using mode: 0x%x\n", arguments.mode);
-        das4q_setting_t set = {.mode = arguments.mode,
-                               .red = arguments.red,
-                               .green = arguments.green,
-                               .blue = arguments.blue};
-        das4q_active_setting_t aset = {0};
-        for (int i = 0; i < 0x84; i++) {
-            das4q_set_key_backlight(handle, i, set, aset);
-        }
     }
 
-    das4q_apply_changes(handle);
+    int ret = 0;
+    if (arguments.benchmark) {
+        das4q_reset_stats(handles[0]);
+        run_benchmark(handles[0], set);
+        print_link_stats(handles[0]);
+        if (nhandles > 1) {
+            run_broadcast_benchmark(handles, nhandles, set);
+        }
+        for (int i = 0; i < nhandles; i++) {
+            das4q_apply_changes(handles[i]);
+        }
+    } else if (arguments.animate != NULL) {
+        ret = run_animation(handles, nhandles, arguments.animate,
+                            arguments.fps, arguments.period_ms, set);
+    } else if (arguments.daemon) {
+        ret = run_daemon(handles, nhandles, arguments.socket_path,
+                         arguments.profile == NULL ? arguments.config_file
+                                                   : NULL,
+                         frame, aframe);
+    } else if (arguments.profile != NULL) {
+        if (!apply_profile(arguments.profile, handles, nhandles)) {
+            ret = 1;
+        }
+    } else {
+        update_keyboards(handles, nhandles, frame, aframe);
+    }
 
-    das4q_close_device(handle);
-    exit(0);
+    for (int i = 0; i < nhandles; i++) {
+        das4q_close_device(handles[i]);
+    }
+    das4q_sim_free(sim);
+    exit(ret);
 }
@@ -0,0 +1,123 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "profile.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "das4q_profile.h"
+
+bool write_profile(const char *path,
+                   const das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                   const das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]) {
+    void *profile;
+    size_t len;
+
+    if (das4q_compile_profile(frame, aframe, &profile, &len) < 0) {
+        printf("Failed to compile profile\n");
+        return false;
+    }
+
+    bool ok = false;
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) {
+        perror(path);
+        goto cleanup;
+    }
+    if (fwrite(profile, 1, len, fp) != len) {
+        perror(path);
+        fclose(fp);
+        goto cleanup;
+    }
+    ok = fclose(fp) == 0;
+    if (!ok) {
+        perror(path);
+    } else {
+        printf("Wrote %zu byte profile to %s\n", len, path);
+    }
+
+cleanup:
+    free(profile);
+    return ok;
+}
+
+void *map_profile(const char *path, size_t *len) {
+    struct stat st;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror(path);
+        return NULL;
+    }
+    if (fstat(fd, &st) < 0 || st.st_size == 0) {
+        printf("Can't use profile %s\n", path);
+        close(fd);
+        return NULL;
+    }
+    void *profile =
+        mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (profile == MAP_FAILED) {
+        perror(path);
+        return NULL;
+    }
+
+    if (!das4q_profile_valid(profile, st.st_size)) {
+        printf("%s isn't a compiled profile\n", path);
+        munmap(profile, st.st_size);
+        return NULL;
+    }
+    *len = st.st_size;
+    return profile;
+}
+
+bool apply_profile(const char *path, das4q_handle handles[], int nhandles) {
+    size_t len;
+    void *profile = map_profile(path, &len);
+    if (profile == NULL) {
+        return false;
+    }
+
+    // One keyboard failing doesn't stop the others getting it
+    bool ok = true;
+    for (int i = 0; i < nhandles; i++) {
+        if (das4q_send_profile(handles[i], profile, len) < 0) {
+            printf("Some keys failed to update on keyboard %d\n", i);
+            ok = false;
+        }
+        das4q_apply_changes(handles[i]);
+    }
+
+    munmap(profile, len);
+    return ok;
+}
+
+bool load_profile(const char *path, das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                  das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]) {
+    size_t len;
+    void *profile = map_profile(path, &len);
+    if (profile == NULL) {
+        return false;
+    }
+
+    int ret = das4q_profile_frame(profile, len, frame, aframe);
+    munmap(profile, len);
+    return ret == 0;
+}
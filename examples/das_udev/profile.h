@@ -0,0 +1,59 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAS_UDEV_PROFILE_H
+#define DAS_UDEV_PROFILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "libdas4q.h"
+
+/*
+ * Compiles a frame with das4q_compile_profile and writes it to path.
+ *
+ *  returns: false if the profile couldn't be built or written.
+ */
+bool write_profile(const char *path,
+                   const das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                   const das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]);
+
+/*
+ * mmaps a compiled profile, populated up front, and checks it.
+ *
+ *  len: set to the profile's size, for munmap
+ *
+ *  returns: the profile, NULL if it couldn't be read or isn't one.
+ */
+void *map_profile(const char *path, size_t *len);
+
+/*
+ * Maps a compiled profile and streams it to every keyboard, then applies
+ * it.  Nothing is parsed or allocated on the way.
+ *
+ *  returns: false if the profile couldn't be read or a key failed.
+ */
+bool apply_profile(const char *path, das4q_handle handles[], int nhandles);
+
+/*
+ * Reads the frame a compiled profile was built from, for starting the
+ * daemon from it.
+ *
+ *  returns: false if the profile couldn't be read.
+ */
+bool load_profile(const char *path, das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                  das4q_active_setting_t aframe[DAS4Q_NUM_KEYS]);
+
+#endif  // DAS_UDEV_PROFILE_H
@@ -0,0 +1,118 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAS4Q_ANIM_H
+#define DAS4Q_ANIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libdas4q.h"
+
+/*
+ * Host side animations.
+ *
+ * A timerfd ticks at the target frame rate.  Each tick the effects redraw
+ * the frame in order, and whatever changed goes out with
+ * das4q_update_frame.  If the keyboard can't keep up the ticks that went
+ * by in the meantime are dropped rather than queued, so animations stay
+ * on time and just get choppier.
+ *
+ *   das4q_anim_t *anim = das4q_anim_new(handle, 30);
+ *   das4q_anim_add_effect(anim, my_effect, state);
+ *   das4q_anim_run(anim);
+ *   das4q_anim_free(anim);
+ */
+typedef struct das4q_anim das4q_anim_t;
+
+// Most effects one animation can stack
+#define DAS4Q_ANIM_MAX_EFFECTS 8
+
+/*
+ * Draws one frame.
+ *
+ *  t_us: time since the animation started
+ *  frame, aframe: the last frame sent, to be updated in place
+ *
+ *  returns: false once the effect is finished, which ends the animation
+ *           after this frame.
+ */
+typedef bool (*das4q_effect_fn)(uint64_t t_us,
+                                das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                                das4q_active_setting_t aframe[DAS4Q_NUM_KEYS],
+                                void *user_data);
+
+typedef struct das4q_anim_stats {
+    int target_fps;
+    double achieved_fps;
+    uint64_t frames;          // Frames drawn and sent
+    uint64_t dropped;         // Ticks skipped because a frame ran long
+    uint64_t failed;          // Frames where some keys didn't make it
+    uint64_t keys_sent;       // Keys that actually changed, over all frames
+    double link_utilization;  // Fraction of the time spent sending
+} das4q_anim_stats_t;
+
+/*
+ * Sets up an animation on handle, starting from the frame last set on it.
+ *
+ *  fps: target frame rate, 1 to 1000
+ *
+ *  returns: NULL with errno set on error.
+ */
+das4q_anim_t *das4q_anim_new(das4q_handle handle, int fps);
+void das4q_anim_free(das4q_anim_t *anim);
+
+/*
+ * Adds an effect on top of the ones already there.
+ *
+ *  returns: false if there are already DAS4Q_ANIM_MAX_EFFECTS.
+ */
+bool das4q_anim_add_effect(das4q_anim_t *anim, das4q_effect_fn effect,
+                           void *user_data);
+
+/*
+ * Starts the clock.  Callers with their own poll loop wait on
+ * das4q_anim_get_fd and call das4q_anim_dispatch when it's readable.
+ *
+ *  returns: 0 on success, -errno otherwise.
+ */
+int das4q_anim_start(das4q_anim_t *anim);
+
+// timerfd that becomes readable when a frame is due
+int das4q_anim_get_fd(das4q_anim_t *anim);
+
+/*
+ * Draws and sends a frame if one is due.
+ *
+ *  returns: 1 once the animation has finished, 0 if it's still going,
+ *           -errno on error.
+ */
+int das4q_anim_dispatch(das4q_anim_t *anim);
+
+/*
+ * Starts the animation and blocks until it finishes or
+ * das4q_anim_stop is called.
+ *
+ *  returns: 0 on success, -errno otherwise.
+ */
+int das4q_anim_run(das4q_anim_t *anim);
+
+// Ends the animation.  Safe to call from an effect or a signal handler.
+void das4q_anim_stop(das4q_anim_t *anim);
+
+// Frame rate and drop counts since das4q_anim_start
+void das4q_anim_get_stats(das4q_anim_t *anim, das4q_anim_stats_t *stats);
+
+#endif  // DAS4Q_ANIM_H
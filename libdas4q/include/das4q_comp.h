@@ -0,0 +1,104 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAS4Q_COMP_H
+#define DAS4Q_COMP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libdas4q.h"
+
+/*
+ * Layered compositor, for several programs sharing one keyboard.
+ *
+ * Each layer is a named frame with a priority, a per-key alpha (0 leaves
+ * the key to the layers below) and an opacity for the whole layer.  Colors
+ * are blended bottom to top; mode and active settings come from the
+ * highest layer covering the key.  A layer can be given a lifetime, after
+ * which a timer wheel drops it.  Only keys whose composited value changed
+ * are sent, so a short flash on three keys costs three keys on the way in
+ * and three on the way out.
+ *
+ *   das4q_comp_t *comp = das4q_comp_new(handle);
+ *   das4q_comp_set_layer(comp, "theme", 0, theme, NULL, NULL, 0);
+ *   das4q_comp_set_layer(comp, "mail", 10, flash, NULL, mask, 200);
+ *   das4q_comp_commit(comp);
+ *   // poll das4q_comp_get_fd, das4q_comp_dispatch when readable
+ */
+typedef struct das4q_comp das4q_comp_t;
+
+#define DAS4Q_COMP_MAX_LAYERS 16
+#define DAS4Q_COMP_NAME_LEN 32
+
+// Expiry resolution, and the number of ticks the wheel holds before
+// wrapping.  Longer lifetimes just go round more than once.
+#define DAS4Q_COMP_TICK_MS 10
+#define DAS4Q_COMP_WHEEL_SLOTS 64
+
+das4q_comp_t *das4q_comp_new(das4q_handle handle);
+void das4q_comp_free(das4q_comp_t *comp);
+
+/*
+ * Adds a layer, or replaces the one with the same name.  Nothing is sent
+ * until das4q_comp_commit.
+ *
+ *  priority: higher is on top.  Ties go to the layer set last.
+ *  settings: DAS4Q_NUM_KEYS settings, indexed by das4q_map_t
+ *  active_settings: optional, all off if NULL
+ *  alpha: optional per-key coverage, 0 to 255.  NULL covers every key.
+ *  ttl_ms: removes the layer after this long, 0 keeps it until removed
+ *
+ *  returns: 0 on success, -ENOSPC if there are already
+ *           DAS4Q_COMP_MAX_LAYERS, -EINVAL for a bad name.
+ */
+int das4q_comp_set_layer(das4q_comp_t *comp, const char *name, int priority,
+                         const das4q_setting_t settings[DAS4Q_NUM_KEYS],
+                         const das4q_active_setting_t
+                             active_settings[DAS4Q_NUM_KEYS],
+                         const uint8_t alpha[DAS4Q_NUM_KEYS],
+                         uint32_t ttl_ms);
+
+/*
+ * Fades a whole layer.
+ *
+ *  returns: 0 on success, -ENOENT if there's no such layer.
+ */
+int das4q_comp_set_opacity(das4q_comp_t *comp, const char *name,
+                           uint8_t opacity);
+
+// returns: 0 on success, -ENOENT if there's no such layer.
+int das4q_comp_remove_layer(das4q_comp_t *comp, const char *name);
+
+/*
+ * Flattens the layers and sends the keys whose result changed.  Keys no
+ * layer has ever covered are left alone; keys that were covered and no
+ * longer are turned off.
+ *
+ *  returns: number of keys sent on success, -errno if any key failed.
+ */
+int das4q_comp_commit(das4q_comp_t *comp);
+
+// timerfd that becomes readable while layers are waiting to expire
+int das4q_comp_get_fd(das4q_comp_t *comp);
+
+/*
+ * Drops layers whose time is up, and commits if there were any.
+ *
+ *  returns: number of layers dropped, -errno on error.
+ */
+int das4q_comp_dispatch(das4q_comp_t *comp);
+
+#endif  // DAS4Q_COMP_H
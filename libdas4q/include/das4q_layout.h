@@ -0,0 +1,84 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAS4Q_LAYOUT_H
+#define DAS4Q_LAYOUT_H
+
+#include <stdint.h>
+
+#include "libdas4q.h"
+
+/*
+ * Where each key physically sits, for effects that move across the
+ * keyboard (waves, ripples, anything radial).  Everything is looked up from
+ * tables generated by scripts/gen_layout.py, so none of it searches the
+ * layout at runtime.
+ *
+ * Positions are in 1/DAS4Q_LAYOUT_UNIT of a key width, with 0,0 the top
+ * left corner of escape.  The extra LEDs under the wide keys get the part
+ * of the key they light, the other unnamed slots in keymap.h have no
+ * geometry.
+ */
+
+#define DAS4Q_LAYOUT_UNIT 8
+#define DAS4Q_LAYOUT_WIDTH (22 * DAS4Q_LAYOUT_UNIT + DAS4Q_LAYOUT_UNIT / 2)
+#define DAS4Q_LAYOUT_HEIGHT (6 * DAS4Q_LAYOUT_UNIT + DAS4Q_LAYOUT_UNIT / 2)
+#define DAS4Q_MAX_NEIGHBOURS 16
+#define DAS4Q_LAYOUT_NO_KEY 0xff
+
+typedef struct das4q_key_geometry {
+    uint8_t x;  // Top left corner
+    uint8_t y;
+    uint8_t w;
+    uint8_t h;
+    uint8_t cx;  // Centre
+    uint8_t cy;
+} das4q_key_geometry_t;
+
+/*
+ * das4q_key_geometry:
+ *   key: das4q_map_t slot
+ *
+ * returns: the key's rectangle, or NULL for slots with no key or LED
+ */
+const das4q_key_geometry_t *das4q_key_geometry(das4q_map_t key);
+
+/*
+ * das4q_key_neighbours:
+ *   key: das4q_map_t slot
+ *   neighbours: set to the keys touching this one, diagonals included, and
+ *               across the gaps between the key blocks
+ *
+ * returns: how many neighbours there are, at most DAS4Q_MAX_NEIGHBOURS
+ */
+int das4q_key_neighbours(das4q_map_t key, const das4q_map_t **neighbours);
+
+/*
+ * das4q_key_distance:
+ *   returns: centre to centre distance between two keys, rounded, or
+ *            DAS4Q_LAYOUT_NO_KEY if either slot has no key
+ */
+uint8_t das4q_key_distance(das4q_map_t a, das4q_map_t b);
+
+/*
+ * das4q_key_distances:
+ *   origin: das4q_map_t slot
+ *
+ * returns: DAS4Q_NUM_KEYS distances from origin, indexed by das4q_map_t,
+ *          for radial effects that want the whole row at once
+ */
+const uint8_t *das4q_key_distances(das4q_map_t origin);
+
+#endif  // DAS4Q_LAYOUT_H
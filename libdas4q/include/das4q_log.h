@@ -0,0 +1,66 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAS4Q_LOG_H
+#define DAS4Q_LOG_H
+
+#include "libdas4q.h"
+
+/*
+ * Logging.
+ *
+ * Messages below the runtime level are never formatted, and levels above
+ * DAS4Q_LOG_MAX_LEVEL (a build option) aren't even compiled in.  Without a
+ * callback messages go to stderr.
+ *
+ * Every report to and from the keyboard is also kept, unformatted, in a
+ * small per-handle ring.  When something fails for good the ring is
+ * written out at DAS4Q_LOG_ERROR, so the packets leading up to the failure
+ * show up without tracing everything all the time.
+ */
+
+typedef enum das4q_log_level {
+    DAS4Q_LOG_NONE = 0,
+    DAS4Q_LOG_ERROR = 1,
+    DAS4Q_LOG_WARN = 2,
+    DAS4Q_LOG_INFO = 3,  // The default
+    DAS4Q_LOG_DEBUG = 4,
+    DAS4Q_LOG_TRACE = 5,  // Every report as it goes
+} das4q_log_level_t;
+
+/*
+ * Gets each message, without a trailing newline.  May be called from any
+ * thread that is using a handle.
+ */
+typedef void (*das4q_log_fn)(das4q_log_level_t level, const char *msg,
+                             void *user_data);
+
+// Applies to every handle.  DAS4Q_LOG_NONE silences the library.
+void das4q_set_log_level(das4q_log_level_t level);
+das4q_log_level_t das4q_get_log_level(void);
+
+// fn NULL goes back to stderr.
+void das4q_set_log_callback(das4q_log_fn fn, void *user_data);
+
+// Reports kept per handle for das4q_dump_trace
+#define DAS4Q_TRACE_LEN 64
+
+/*
+ * Logs the last DAS4Q_TRACE_LEN reports sent and received on handle,
+ * oldest first.
+ */
+void das4q_dump_trace(das4q_handle handle, das4q_log_level_t level);
+
+#endif  // DAS4Q_LOG_H
@@ -0,0 +1,124 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAS4Q_PLAN_H
+#define DAS4Q_PLAN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libdas4q.h"
+
+/*
+ * Effect planner.
+ *
+ * The firmware animates keys by itself: the passive modes pulse, blink
+ * and cycle for as long as they're set, and the active modes play on a
+ * keypress with their timing in unk.  Once uploaded those cost nothing on
+ * the bus.  The planner takes effects as they'd be described to a person
+ * and turns each into firmware modes when it can, leaving only what the
+ * firmware can't do, such as a pulse at a rate it doesn't run at, to be
+ * drawn by the host through das4q_anim:
+ *
+ *   das4q_plan_t *plan = das4q_plan_new(handle);
+ *   das4q_plan_add(plan, &(das4q_effect_request_t){
+ *       .kind = DAS4Q_EFFECT_PULSE, .blue = 0xff, .keys = keys, .nkeys = 3});
+ *   das4q_plan_upload(plan);
+ *   if (das4q_plan_host_keys(plan) > 0) {
+ *       das4q_anim_add_effect(anim, das4q_plan_effect, plan);
+ *       ...
+ *   }
+ */
+typedef struct das4q_plan das4q_plan_t;
+
+// Effects das4q_plan_add can't hand to the firmware
+#define DAS4Q_PLAN_MAX_HOST 16
+
+typedef enum das4q_effect_kind {
+    DAS4Q_EFFECT_STATIC,  // Steady color
+    DAS4Q_EFFECT_PULSE,   // Fades in and out
+    DAS4Q_EFFECT_BLINK,   // On and off
+    DAS4Q_EFFECT_CYCLE,   // Through the hues, the color is ignored
+    // Keypress only, spreading to other keys
+    DAS4Q_EFFECT_LASER,
+    DAS4Q_EFFECT_RIPPLE,
+    DAS4Q_EFFECT_IN_RIPPLE,
+} das4q_effect_kind_t;
+
+typedef enum das4q_effect_trigger {
+    DAS4Q_TRIGGER_ALWAYS,    // Runs until replaced
+    DAS4Q_TRIGGER_KEYPRESS,  // Plays when the key is pressed
+} das4q_effect_trigger_t;
+
+typedef struct das4q_effect_request {
+    das4q_effect_kind_t kind;
+    das4q_effect_trigger_t trigger;
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    // One cycle, or how long a keypress effect lasts.  0 takes whatever
+    // the firmware does.
+    uint32_t period_ms;
+    // How far an always running effect may be from the firmware's own
+    // rate, in percent, and still be left to it
+    uint8_t tolerance_pct;
+    // Times a keypress effect plays, 0 for the firmware's default
+    uint8_t repeat;
+    const das4q_map_t *keys;  // NULL for every key
+    int nkeys;
+} das4q_effect_request_t;
+
+#define DAS4Q_PLAN_FIRMWARE 0
+#define DAS4Q_PLAN_HOST 1
+
+/*
+ * Starts a plan from the frame last set on handle.
+ *
+ *  returns: NULL with errno set on error.
+ */
+das4q_plan_t *das4q_plan_new(das4q_handle handle);
+void das4q_plan_free(das4q_plan_t *plan);
+
+/*
+ * Adds an effect on top of what the plan already has for its keys.
+ * Nothing is sent until das4q_plan_upload.
+ *
+ *  returns: DAS4Q_PLAN_FIRMWARE if the keyboard will play it by itself,
+ *           DAS4Q_PLAN_HOST if it has to be drawn by das4q_plan_effect,
+ *           -ENOTSUP for an effect that only exists as a keypress effect,
+ *           -ERANGE for keypress timing that doesn't fit in unk,
+ *           -ENOSPC if there are already DAS4Q_PLAN_MAX_HOST host
+ *           effects, -EINVAL for anything else wrong with it.
+ */
+int das4q_plan_add(das4q_plan_t *plan, const das4q_effect_request_t *effect);
+
+/*
+ * Sends the planned frame, host drawn keys as they start, and applies it.
+ *
+ *  returns: number of keys sent on success, -errno if any key failed.
+ */
+int das4q_plan_upload(das4q_plan_t *plan);
+
+// Keys the host has to keep drawing, 0 when the firmware does it all
+int das4q_plan_host_keys(das4q_plan_t *plan);
+
+/*
+ * A das4q_effect_fn drawing the effects the firmware can't, with the plan
+ * as user_data.  Only the host drawn keys are touched.
+ */
+bool das4q_plan_effect(uint64_t t_us, das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                       das4q_active_setting_t aframe[DAS4Q_NUM_KEYS],
+                       void *user_data);
+
+#endif  // DAS4Q_PLAN_H
@@ -0,0 +1,111 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAS4Q_PLANES_H
+#define DAS4Q_PLANES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "libdas4q.h"
+
+/*
+ * Frames as separate red, green and blue planes, for effects that redraw
+ * every key every frame.
+ *
+ * Planes are indexed by das4q_map_t like a frame, padded out to a multiple
+ * of 32 so the vector kernels never need a tail loop.  The padding is
+ * scratch, kernels write it and das4q_planes_to_frame ignores it.  All
+ * kernels give the same results whichever instruction set runs them.
+ * Plain byte arrays passed in, such as pos and alpha, need no alignment.
+ */
+
+#define DAS4Q_PLANE_LEN 160
+
+typedef struct das4q_planes {
+    uint8_t r[DAS4Q_PLANE_LEN] __attribute__((aligned(32)));
+    uint8_t g[DAS4Q_PLANE_LEN] __attribute__((aligned(32)));
+    uint8_t b[DAS4Q_PLANE_LEN] __attribute__((aligned(32)));
+} das4q_planes_t;
+
+typedef struct das4q_rgb {
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+} das4q_rgb_t;
+
+typedef enum das4q_isa {
+    DAS4Q_ISA_SCALAR,
+    DAS4Q_ISA_SSE2,
+    DAS4Q_ISA_AVX2,
+} das4q_isa_t;
+
+// Best the CPU supports, unless das4q_planes_set_isa said otherwise
+das4q_isa_t das4q_planes_get_isa(void);
+
+/*
+ * Forces the kernels onto one instruction set, for benchmarks and
+ * comparisons.
+ *
+ *  returns: false if the CPU doesn't have it.
+ */
+bool das4q_planes_set_isa(das4q_isa_t isa);
+
+const char *das4q_isa_name(das4q_isa_t isa);
+
+// Every key one color
+void das4q_planes_fill(das4q_planes_t *planes, das4q_rgb_t color);
+
+/*
+ * Linear gradient between two colors.
+ *
+ *  pos: per key, 0 is from and 255 is to
+ */
+void das4q_planes_gradient(das4q_planes_t *planes,
+                           const uint8_t pos[DAS4Q_PLANE_LEN],
+                           das4q_rgb_t from, das4q_rgb_t to);
+
+// dst = dst * (255 - alpha) / 255 + src * alpha / 255
+void das4q_planes_blend(das4q_planes_t *dst, const das4q_planes_t *src,
+                        uint8_t alpha);
+
+// As das4q_planes_blend with a separate alpha for each key
+void das4q_planes_blend_mask(das4q_planes_t *dst, const das4q_planes_t *src,
+                             const uint8_t alpha[DAS4Q_PLANE_LEN]);
+
+/*
+ * Brightness.
+ *
+ *  factor: 8.8 fixed point, 256 leaves it as is.  Larger is clamped.
+ */
+void das4q_planes_scale(das4q_planes_t *planes, uint16_t factor);
+
+// Passes every channel through lut, e.g. one from das4q_gamma_lut
+void das4q_planes_lut(das4q_planes_t *planes, const uint8_t lut[256]);
+
+// Fills lut with a power curve, 2.2 or so evens out LED brightness
+void das4q_gamma_lut(uint8_t lut[256], double gamma);
+
+// Moves every channel up to step closer to target
+void das4q_planes_fade(das4q_planes_t *planes, const das4q_planes_t *target,
+                       uint8_t step);
+
+void das4q_planes_to_frame(const das4q_planes_t *planes,
+                           das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                           das4q_keymode_t mode);
+void das4q_planes_from_frame(das4q_planes_t *planes,
+                             const das4q_setting_t frame[DAS4Q_NUM_KEYS]);
+
+#endif  // DAS4Q_PLANES_H
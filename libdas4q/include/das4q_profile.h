@@ -0,0 +1,71 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAS4Q_PROFILE_H
+#define DAS4Q_PROFILE_H
+
+#include <stddef.h>
+
+#include "libdas4q.h"
+
+/*
+ * Compiled lighting profiles.
+ *
+ * A profile is a whole frame turned into the exact reports that go on the
+ * wire, checksums and all, so applying one is just a matter of streaming
+ * it out.  Nothing in it points anywhere, it can be written to a file and
+ * mmapped back in.  Fields are in host byte order.
+ */
+
+#define DAS4Q_PROFILE_MAGIC "DAS4QPF1"
+#define DAS4Q_PROFILE_VERSION 1
+
+/*
+ * Compiles a frame into a profile.
+ *
+ *  profile: set to a malloc'd profile, to be freed by the caller
+ *  len: set to the profile's size
+ *
+ *  returns: 0 on success, -errno otherwise.
+ */
+int das4q_compile_profile(
+    const das4q_setting_t settings[DAS4Q_NUM_KEYS],
+    const das4q_active_setting_t active_settings[DAS4Q_NUM_KEYS],
+    void **profile, size_t *len);
+
+// Checks a profile is well formed before it's used
+bool das4q_profile_valid(const void *profile, size_t len);
+
+/*
+ * Reads the frame a profile was compiled from back out of it.  Keys the
+ * profile doesn't have are left alone.
+ *
+ *  returns: 0 on success, -EINVAL for a bad profile.
+ */
+int das4q_profile_frame(
+    const void *profile, size_t len, das4q_setting_t settings[DAS4Q_NUM_KEYS],
+    das4q_active_setting_t active_settings[DAS4Q_NUM_KEYS]);
+
+/*
+ * Streams a profile's reports to the keyboard as they are, reading acks
+ * every ack_window keys.  Keys that don't get an ack are resent the usual
+ * way.  Changes still need das4q_apply_changes.
+ *
+ *  returns: number of keys sent on success, -EINVAL for a bad profile,
+ *           -errno if any key failed.
+ */
+int das4q_send_profile(das4q_handle handle, const void *profile, size_t len);
+
+#endif  // DAS4Q_PROFILE_H
@@ -0,0 +1,88 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAS4Q_QUEUE_H
+#define DAS4Q_QUEUE_H
+
+#include <stdint.h>
+
+#include "libdas4q.h"
+
+/*
+ * Thread safe key updates.
+ *
+ * Any number of threads submit keys into a lock-free ring, and one writer
+ * thread owns the keyboard.  Each time it wakes it takes everything
+ * waiting, keeps only the latest update for each key, and sends the keys
+ * that changed as one stream followed by das4q_apply_changes.  Submitting
+ * never waits on USB: if the ring is full it fails straight away.
+ *
+ * The writer thread is the only thing that may touch the handle while the
+ * queue exists.
+ *
+ *   das4q_queue_t *queue = das4q_queue_new(handle, 0);
+ *   das4q_queue_submit(queue, KEY_ESCAPE, setting, active);  // any thread
+ *   das4q_queue_free(queue);
+ */
+typedef struct das4q_queue das4q_queue_t;
+
+// Ring size das4q_queue_new uses for a capacity of 0
+#define DAS4Q_QUEUE_DEFAULT_CAPACITY 256
+
+typedef struct das4q_queue_stats {
+    uint64_t submitted;  // Updates accepted into the ring
+    uint64_t rejected;   // Updates turned away because the ring was full
+    uint64_t coalesced;  // Updates replaced by a later one for the same key
+    uint64_t batches;    // Times the writer sent anything
+    uint64_t keys_sent;  // Keys that actually went to the keyboard
+    uint64_t failed;     // Batches where some keys didn't make it
+} das4q_queue_stats_t;
+
+/*
+ * Starts the writer thread for handle.
+ *
+ *  capacity: updates the ring holds, rounded up to a power of two.  0 for
+ *            DAS4Q_QUEUE_DEFAULT_CAPACITY.
+ *
+ *  returns: NULL with errno set on error.
+ */
+das4q_queue_t *das4q_queue_new(das4q_handle handle, uint32_t capacity);
+
+/*
+ * Sends whatever is still in the ring, then stops the writer.  Nothing may
+ * be submitting any more.
+ */
+void das4q_queue_free(das4q_queue_t *queue);
+
+/*
+ * Queues an update for one key.  Safe from any thread, never blocks.
+ *
+ *  returns: 0 when queued, -EAGAIN if the ring is full, -EINVAL for a bad
+ *           key.
+ */
+int das4q_queue_submit(das4q_queue_t *queue, das4q_map_t key,
+                       das4q_setting_t setting,
+                       das4q_active_setting_t active);
+
+/*
+ * Waits until everything submitted before the call has been sent.
+ *
+ *  returns: 0 if every batch since the last flush made it, -EIO otherwise.
+ */
+int das4q_queue_flush(das4q_queue_t *queue);
+
+void das4q_queue_get_stats(das4q_queue_t *queue, das4q_queue_stats_t *stats);
+
+#endif  // DAS4Q_QUEUE_H
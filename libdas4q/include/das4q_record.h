@@ -0,0 +1,140 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAS4Q_RECORD_H
+#define DAS4Q_RECORD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "das4q_transport.h"
+#include "libdas4q.h"
+
+/*
+ * Capturing and replaying the exchange with a keyboard.
+ *
+ * A recorder sits between the library and a transport and writes every
+ * SET_REPORT and GET_REPORT to a file as it happens.  A replay is a
+ * transport that answers from such a file instead of a keyboard, so a
+ * session captured on real hardware can be run through the protocol code
+ * again, as often as needed, without the keyboard:
+ *
+ *   das4q_replay_t *replay = das4q_replay_new("session.das4qrec", NULL);
+ *   das4q_handle handle = das4q_open_transport(&das4q_replay_transport,
+ *                                              replay);
+ *   ...
+ *   das4q_close_device(handle);
+ *   das4q_replay_free(replay);
+ *
+ * The file is a header followed by one record per report.  Fields are in
+ * host byte order.  Only the blocking calls go through transports, the
+ * non-blocking interface isn't captured.
+ */
+
+#define DAS4Q_RECORD_MAGIC "DAS4QRC1"
+#define DAS4Q_RECORD_VERSION 1
+
+// Most report bytes kept per record
+#define DAS4Q_RECORD_MAX_DATA 64
+
+typedef struct __attribute__((__packed__)) das4q_record_header {
+    char magic[8];  // DAS4Q_RECORD_MAGIC, not terminated
+    uint32_t version;
+    uint32_t reserved;
+} das4q_record_header_t;
+
+typedef struct __attribute__((__packed__)) das4q_record {
+    uint32_t delta_us;     // Since the previous report started
+    uint32_t duration_us;  // How long the transport took over it
+    int32_t ret;  // What the transport returned, libusb errors as -errno
+    uint8_t in;   // 1 for GET_REPORT
+    uint8_t len;  // Bytes of data that follow, what went out or came back
+} das4q_record_t;
+
+/*
+ * Records every handle opened from now on to path.  The first handle gets
+ * path itself, any more path.1, path.2 and so on.  Without a call to this
+ * the DAS4Q_RECORD environment variable is used, if it's set.
+ *
+ *  path: NULL to stop recording new handles
+ */
+void das4q_set_record_path(const char *path);
+
+/*
+ * Wraps a transport in a recorder.  Handles opened through libdas4q get
+ * one by themselves once das4q_set_record_path is set, this is for custom
+ * transports.
+ *
+ *  returns: the recorder's ctx, to go with das4q_record_transport, or
+ *           NULL with errno set.  Closing it closes the inner transport.
+ */
+void *das4q_recorder_new(const das4q_transport_t *inner, void *inner_ctx,
+                         const char *path);
+
+extern const das4q_transport_t das4q_record_transport;
+
+typedef struct das4q_replay das4q_replay_t;
+
+typedef struct das4q_replay_config {
+    // 1 takes as long as the keyboard did over each report, 2 half as long
+    // and so on.  0 doesn't wait at all.
+    double speed;
+} das4q_replay_config_t;
+
+typedef struct das4q_replay_stats {
+    uint64_t set_reports;
+    uint64_t get_reports;
+    // SET_REPORTs that differ from the recording at the same position
+    uint64_t set_mismatches;
+    // Reports asked for after the recording ran out
+    uint64_t overruns;
+} das4q_replay_stats_t;
+
+extern const das4q_transport_t das4q_replay_transport;
+
+/*
+ * Loads a recording.  SET_REPORTs and GET_REPORTs are replayed in the
+ * order they were recorded, each independently of the other, so protocol
+ * code that sends fewer or different reports still gets the keyboard's
+ * answers in the order the keyboard gave them.
+ *
+ *  config: NULL replays as fast as possible
+ *
+ *  returns: NULL with errno set if the file can't be read or isn't a
+ *           recording.
+ */
+das4q_replay_t *das4q_replay_new(const char *path,
+                                 const das4q_replay_config_t *config);
+void das4q_replay_free(das4q_replay_t *replay);
+
+// Starts over from the first report, keeping the stats.
+void das4q_replay_rewind(das4q_replay_t *replay);
+
+void das4q_replay_get_stats(das4q_replay_t *replay,
+                            das4q_replay_stats_t *stats);
+
+// Number of reports in the recording
+int das4q_replay_count(das4q_replay_t *replay);
+
+/*
+ * The i-th recorded report.
+ *
+ *  data: set to its bytes, record->len of them
+ *
+ *  returns: NULL if i is out of range.
+ */
+const das4q_record_t *das4q_replay_record(das4q_replay_t *replay, int i,
+                                          const uint8_t **data);
+
+#endif  // DAS4Q_RECORD_H
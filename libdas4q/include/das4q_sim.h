@@ -0,0 +1,89 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAS4Q_SIM_H
+#define DAS4Q_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "das4q_transport.h"
+#include "libdas4q.h"
+
+/*
+ * An in-process DAS 4Q.
+ *
+ * Parses the command stream the same way the keyboard does, checks the
+ * checksums, keeps the per-key state and answers with version and ack
+ * packets.  Good enough to exercise and time the protocol code without
+ * hardware:
+ *
+ *   das4q_sim_t *sim = das4q_sim_new(&config);
+ *   das4q_handle handle = das4q_open_transport(&das4q_sim_transport, sim);
+ *   ...
+ *   das4q_close_device(handle);
+ *   das4q_sim_free(sim);
+ */
+typedef struct das4q_sim das4q_sim_t;
+
+typedef struct das4q_sim_config {
+    // Time each SET_REPORT / GET_REPORT takes, in microseconds
+    unsigned int set_latency_us;
+    unsigned int get_latency_us;
+
+    // Chance an ack never shows up, in parts per million
+    unsigned int ack_loss_ppm;
+
+    // Seeds the ack loss.  Same seed, same losses.
+    unsigned int seed;
+
+    // Firmware version to report, NULL for the one libdas4q expects
+    const char *version;
+} das4q_sim_config_t;
+
+typedef struct das4q_sim_stats {
+    uint64_t set_reports;
+    uint64_t get_reports;
+    uint64_t commands;
+    uint64_t bad_checksums;
+    uint64_t acks_sent;
+    uint64_t acks_lost;
+} das4q_sim_stats_t;
+
+extern const das4q_transport_t das4q_sim_transport;
+
+/*
+ *  config: NULL for an instant, lossless keyboard
+ *
+ *  returns: NULL on allocation failure.
+ */
+das4q_sim_t *das4q_sim_new(const das4q_sim_config_t *config);
+void das4q_sim_free(das4q_sim_t *sim);
+
+// Changes latency and loss on the fly, e.g. between benchmark runs.
+void das4q_sim_set_config(das4q_sim_t *sim, const das4q_sim_config_t *config);
+
+void das4q_sim_get_stats(das4q_sim_t *sim, das4q_sim_stats_t *stats);
+
+/*
+ * What the simulated keyboard has for a key.
+ *
+ *  returns: false if the key was never set.
+ */
+bool das4q_sim_get_key(das4q_sim_t *sim, das4q_map_t key,
+                       das4q_setting_t *setting,
+                       das4q_active_setting_t *active);
+
+#endif  // DAS4Q_SIM_H
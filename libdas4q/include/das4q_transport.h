@@ -0,0 +1,62 @@
+// Copyright 2023 Patrick Erley <paerley@gmail.com>
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DAS4Q_TRANSPORT_H
+#define DAS4Q_TRANSPORT_H
+
+#include <stdint.h>
+
+#include "libdas4q.h"
+
+/*
+ * How reports get to and from the keyboard.
+ *
+ * Everything libdas4q does is 8 byte HID feature reports on report ID 1,
+ * with the report ID in buff[0].  das4q_init_device uses libusb control
+ * transfers, anything else can be plugged in with das4q_open_transport.
+ */
+typedef struct das4q_transport {
+    const char *name;
+
+    // Sends one feature report.  returns: bytes sent, or negative on error.
+    int (*set_report)(void *ctx, const uint8_t *buff, int len);
+
+    // Reads one feature report.  returns: bytes read, or negative on error.
+    int (*get_report)(void *ctx, uint8_t *buff, int len);
+
+    // Optional, called from das4q_close_device.
+    void (*close)(void *ctx);
+} das4q_transport_t;
+
+/*
+ * Opens a keyboard behind a custom transport, and does the same version
+ * check and clear as das4q_init_device.
+ *
+ *  ctx: passed to every transport callback
+ *
+ *  returns: handle on success, Sets errno and returns NULL on error.
+ */
+das4q_handle das4q_open_transport(const das4q_transport_t *transport,
+                                  void *ctx);
+
+/*
+ * das4q_open_transport, with das4q_init_flags_t.  A custom transport has
+ * no USB port to key the identity cache on, so only DAS4Q_INIT_NO_CLEAR
+ * makes a difference.
+ */
+das4q_handle das4q_open_transport_flags(const das4q_transport_t *transport,
+                                        void *ctx, unsigned int flags);
+
+#endif  // DAS4Q_TRANSPORT_H
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#ifndef DAS4Q_KEYMAP_H
+#define DAS4Q_KEYMAP_H
+
 typedef enum __attribute__((__packed__)) das4q_map {
     KET_L_CTRL = 0x00,
     KEY_L_SHIFT = 0x01,
@@ -146,4 +149,6 @@ typedef enum __attribute__((__packed__)) das4q_map {
     // 0x82 ????
     // 0x83 ????
     // 0x84 + causes errors
-} das4q_map_t;
\ No newline at end of file
+} das4q_map_t;
+
+#endif  // DAS4Q_KEYMAP_H
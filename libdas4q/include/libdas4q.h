@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#ifndef LIBDAS4Q_H
+#define LIBDAS4Q_H
+
+#include <poll.h>
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -19,16 +23,77 @@
 
 typedef void *das4q_handle;
 
+// Number of addressable key slots, see keymap.h
+#define DAS4Q_NUM_KEYS 0x84
+
+/*
+ * Looks a key up by its name in keymap.h, e.g. "KEY_ESCAPE".  "KEY_L_CTRL"
+ * is taken for keymap.h's KET_L_CTRL.
+ *
+ *  returns: false if there's no key by that name.
+ */
+bool das4q_key_from_name(const char *name, das4q_map_t *key);
+
+// Name of a key in keymap.h, NULL for slots with no key of their own
+const char *das4q_key_name(das4q_map_t key);
+
 /*
  * Initializes the device at hiddev.
  *
- *  hiddev: /dev node to use.  If null, will search by vid/pid
+ *  hiddev: /dev/hidrawN node of the keyboard's lighting interface.  If
+ *          null, will search by vid/pid with libusb.  Only libusb opened
+ *          keyboards support the non-blocking interface.
  *
  *  returns: handle on success, Sets errno and returns NULL on error.
  */
 das4q_handle das4q_init_device(char *hiddev);
+
+/*
+ * Opens every keyboard libusb can find, each with a handle of its own.  A
+ * handle sticks to its USB port, so hotplug brings each keyboard back to
+ * the right handle.
+ *
+ *  handles: filled with up to max handles
+ *
+ *  returns: number of keyboards opened, -errno if there were none.
+ */
+int das4q_init_devices(das4q_handle handles[], int max);
 void das4q_close_device(das4q_handle handle);
 
+/*
+ * Opening a keyboard normally asks it for its firmware version and then
+ * clears the backlight, several round trips and a visible black flash.
+ * These skip either or both.
+ */
+typedef enum das4q_init_flags {
+    DAS4Q_INIT_DEFAULT = 0,
+    // Leave the lights as they are, the first frame sent replaces them
+    DAS4Q_INIT_NO_CLEAR = 1 << 0,
+    // Trust the firmware version cached for the keyboard in this USB port
+    // with this serial, if there is one, rather than asking again
+    DAS4Q_INIT_CACHED_IDENTITY = 1 << 1,
+    DAS4Q_INIT_FAST = DAS4Q_INIT_NO_CLEAR | DAS4Q_INIT_CACHED_IDENTITY,
+} das4q_init_flags_t;
+
+// Where verified identities are cached, unless changed
+#define DAS4Q_IDENTITY_CACHE "/run/das4q.identity"
+
+// das4q_init_device, with das4q_init_flags_t
+das4q_handle das4q_init_device_flags(char *hiddev, unsigned int flags);
+
+// das4q_init_devices, with das4q_init_flags_t
+int das4q_init_devices_flags(das4q_handle handles[], int max,
+                             unsigned int flags);
+
+/*
+ * Changes the identity cache file for every handle opened after.  It
+ * holds a line per keyboard that has passed the version check, and is
+ * only read or written with DAS4Q_INIT_CACHED_IDENTITY.
+ *
+ *  path: NULL to stop caching altogether
+ */
+void das4q_set_identity_cache(const char *path);
+
 typedef enum __attribute__((__packed__)) das4q_keymode {
     DAS4Q_MODE_NONE = 0,
     DAS4Q_MODE_SOLID = 1,
@@ -61,10 +126,310 @@ typedef struct das4q_active_setting {
     uint8_t red;
     uint8_t green;
     uint8_t blue;
+    // Timing, zero for the defaults above.  For the timed modes the first
+    // two bytes look to be a big endian duration in ms and the last a
+    // repeat count.
     uint8_t unk[3];
 } das4q_active_setting_t;
 
 bool das4q_set_key_backlight(das4q_handle handle, das4q_map_t key,
                              das4q_setting_t setting,
                              das4q_active_setting_t active);
-bool das4q_apply_changes(das4q_handle handle);
\ No newline at end of file
+bool das4q_apply_changes(das4q_handle handle);
+
+/*
+ * Sends every key in one pass, packing the commands back to back into as
+ * few reports as the firmware's framing allows.
+ *
+ *  settings: DAS4Q_NUM_KEYS passive settings, indexed by das4q_map_t
+ *  active_settings: DAS4Q_NUM_KEYS active settings, indexed by das4q_map_t
+ *
+ *  returns: number of keys sent on success, -errno if any key failed.
+ */
+int das4q_set_frame(
+    das4q_handle handle, const das4q_setting_t settings[DAS4Q_NUM_KEYS],
+    const das4q_active_setting_t active_settings[DAS4Q_NUM_KEYS]);
+
+/*
+ * Brings the keyboard in line with a full frame of settings.
+ *
+ * The library remembers the last passive and active setting the keyboard
+ * acknowledged for each key, and only keys that differ from that are sent.
+ *
+ *  settings: DAS4Q_NUM_KEYS passive settings, indexed by das4q_map_t
+ *  active_settings: DAS4Q_NUM_KEYS active settings, indexed by das4q_map_t
+ *
+ *  returns: number of keys sent on success, -errno if any key failed.
+ */
+int das4q_update_frame(
+    das4q_handle handle, const das4q_setting_t settings[DAS4Q_NUM_KEYS],
+    const das4q_active_setting_t active_settings[DAS4Q_NUM_KEYS]);
+
+/*
+ * das4q_update_frame on several keyboards at once, each from its own
+ * thread, so it takes as long as the slowest keyboard rather than the sum.
+ * None of the handles may be used by anything else until this returns.
+ *
+ *  settings, active_settings: one frame per handle.  Pass the same pointer
+ *                             for every handle to send them all one frame.
+ *  results: optional, gets each handle's das4q_update_frame result
+ *
+ *  returns: 0 if every keyboard updated, otherwise the first -errno.
+ */
+int das4q_update_frames(das4q_handle handles[], int nhandles,
+                        const das4q_setting_t *const settings[],
+                        const das4q_active_setting_t *const active_settings[],
+                        int results[]);
+
+// Largest window das4q_set_ack_window accepts
+#define DAS4Q_MAX_ACK_WINDOW 32
+
+/*
+ * Sets how many keys das4q_set_frame and das4q_update_frame send before
+ * stopping to read back their acks.  1, the default, waits on every key.
+ * Larger windows save round trips; a key with a bad ack is resent on its
+ * own, missing acks resend their whole window.
+ *
+ *  returns: false if window is outside 1..DAS4Q_MAX_ACK_WINDOW.
+ */
+bool das4q_set_ack_window(das4q_handle handle, int window);
+
+/*
+ * Forgets the remembered key state, so the next das4q_update_frame sends
+ * every key.  Use after a reconnect or anything else that may have changed
+ * the lights behind the library's back.
+ */
+void das4q_invalidate_frame(das4q_handle handle);
+
+/*
+ * Resends every key the caller has set since the keyboard was opened, as
+ * last asked for, then applies them.  For a keyboard that lost its lights
+ * to a replug or a suspend.
+ *
+ *  returns: number of keys sent on success, -errno if any key failed.
+ */
+int das4q_replay_frame(das4q_handle handle);
+
+/*
+ * Retries and timeouts.
+ *
+ * Transfer timeouts follow the measured round trip time: the smoothed
+ * time plus four times its variation, kept between timeout_min_ms and
+ * timeout_max_ms and doubled after every timeout until a transfer gets
+ * through again.  Only the libusb transports can change their timeout,
+ * hidraw keeps the kernel's and the simulator never times out.
+ *
+ * Every operation gets a fixed number of attempts, with an exponential
+ * backoff before each retry, so the worst case of an update is bounded
+ * instead of depending on how flaky the keyboard is being.
+ */
+
+// Upper limit on das4q_retry_policy_t.key_attempts
+#define DAS4Q_MAX_KEY_ATTEMPTS 8
+
+typedef struct das4q_retry_policy {
+    int cmd_attempts;      // Tries at getting one command's reports out
+    int key_attempts;      // Tries at getting a key acked
+    int version_attempts;  // Tries at the version check when opening
+
+    unsigned int backoff_us;      // Wait before the first retry
+    unsigned int backoff_max_us;  // Cap on the wait as it doubles
+
+    unsigned int timeout_min_ms;  // Bounds on the adaptive timeout
+    unsigned int timeout_max_ms;  // Also the timeout until it's measured
+
+    // Give up on whatever is left of a frame or key list after this long,
+    // 0 for no limit
+    unsigned int frame_budget_ms;
+} das4q_retry_policy_t;
+
+/*
+ * Replaces the handle's retry policy.  The default is 2 command and key
+ * attempts, 3 version attempts, a backoff of 1 ms up to 50 ms, timeouts
+ * of 100 to 3000 ms and no frame budget.
+ *
+ *  returns: false, leaving the policy alone, if any attempts are below 1,
+ *           key_attempts is over DAS4Q_MAX_KEY_ATTEMPTS or the timeouts
+ *           are 0 or the wrong way round.
+ */
+bool das4q_set_retry_policy(das4q_handle handle,
+                            const das4q_retry_policy_t *policy);
+
+void das4q_get_retry_policy(das4q_handle handle,
+                            das4q_retry_policy_t *policy);
+
+/*
+ * Non-blocking interface.
+ *
+ * Updates are queued and driven from das4q_handle_events, so a caller
+ * with its own poll/epoll loop never blocks on the keyboard.  Queued
+ * updates go out in order.  Don't mix these with the blocking calls above
+ * while anything is still pending.  Only keyboards opened through libusb
+ * support this, anything else gets -ENOTSUP.
+ */
+
+/*
+ * Called from das4q_handle_events when a queued update is done.
+ *
+ *  status: number of keys sent on success, -errno if any key failed.
+ */
+typedef void (*das4q_done_cb)(das4q_handle handle, int status,
+                              void *user_data);
+
+/*
+ * Queues a das4q_update_frame.  The frame is copied, and diffed against
+ * the keyboard's state when its turn comes.
+ *
+ *  cb: optional, called when the update is done
+ *
+ *  returns: 0 when queued, -errno otherwise.
+ */
+int das4q_update_frame_async(
+    das4q_handle handle, const das4q_setting_t settings[DAS4Q_NUM_KEYS],
+    const das4q_active_setting_t active_settings[DAS4Q_NUM_KEYS],
+    das4q_done_cb cb, void *user_data);
+
+/*
+ * Queues a das4q_set_key_backlight.
+ *
+ *  returns: 0 when queued, -errno otherwise.
+ */
+int das4q_set_key_backlight_async(das4q_handle handle, das4q_map_t key,
+                                  das4q_setting_t setting,
+                                  das4q_active_setting_t active,
+                                  das4q_done_cb cb, void *user_data);
+
+// Number of queued updates that haven't completed yet
+int das4q_async_pending(das4q_handle handle);
+
+/*
+ * Fills fds with the descriptors to poll for.
+ *
+ *  returns: total number of descriptors, which may be more than nfds, or
+ *           -errno.
+ */
+int das4q_get_pollfds(das4q_handle handle, struct pollfd *fds, int nfds);
+
+typedef void (*das4q_pollfd_added_cb)(int fd, short events, void *user_data);
+typedef void (*das4q_pollfd_removed_cb)(int fd, void *user_data);
+
+// Lets epoll users track descriptors coming and going.
+void das4q_set_pollfd_notifiers(das4q_handle handle,
+                                das4q_pollfd_added_cb added,
+                                das4q_pollfd_removed_cb removed,
+                                void *user_data);
+
+/*
+ * returns: ms until das4q_handle_events must be called even if nothing is
+ *          readable, -1 if there's no deadline.
+ */
+int das4q_get_timeout(das4q_handle handle);
+
+/*
+ * Processes whatever is ready without blocking.  Completion callbacks run
+ * from here.
+ *
+ *  returns: 0 on success, -errno otherwise.
+ */
+int das4q_handle_events(das4q_handle handle);
+
+/*
+ * Called from das4q_handle_events when the keyboard is unplugged or comes
+ * back.  By the time connected is true again the remembered frame has been
+ * replayed.
+ *
+ *  reconnect_us: time from libusb seeing the keyboard arrive until the
+ *                lights were right again, 0 on unplug
+ */
+typedef void (*das4q_hotplug_cb)(das4q_handle handle, bool connected,
+                                 uint64_t reconnect_us, void *user_data);
+
+/*
+ * Watches for the keyboard being unplugged and plugged back in, e.g. by a
+ * KVM switch or a suspend.  While it's gone updates fail, but are still
+ * remembered for the replay.  Events are only seen from
+ * das4q_handle_events, so the handle's pollfds need to be in the caller's
+ * loop.  Only keyboards opened through libusb support this.
+ *
+ *  cb: optional
+ *
+ *  returns: 0 on success, -errno otherwise.
+ */
+int das4q_enable_hotplug(das4q_handle handle, das4q_hotplug_cb cb,
+                         void *user_data);
+
+// false while the keyboard is unplugged
+bool das4q_is_connected(das4q_handle handle);
+
+/*
+ * Statistics.
+ *
+ * Every handle counts its traffic and times every transfer.  Latencies go
+ * into histograms with power of two buckets: bucket 0 is under 1 us,
+ * bucket i holds 2^(i-1) to 2^i - 1 us, and the last one everything
+ * longer.
+ */
+
+#define DAS4Q_STATS_BUCKETS 24
+
+typedef enum das4q_stats_op {
+    DAS4Q_STATS_SET_REPORT,  // One feature report out
+    DAS4Q_STATS_GET_REPORT,  // One feature report in
+    DAS4Q_STATS_KEY,         // A whole das4q_set_key_backlight
+    DAS4Q_STATS_STREAM,      // A whole frame or key list, acks included
+    DAS4Q_STATS_APPLY,       // das4q_apply_changes
+    DAS4Q_STATS_NUM_OPS
+} das4q_stats_op_t;
+
+typedef struct das4q_histogram {
+    uint64_t count;
+    uint64_t total_us;
+    uint64_t max_us;
+    uint64_t buckets[DAS4Q_STATS_BUCKETS];
+} das4q_histogram_t;
+
+typedef struct das4q_stats {
+    uint64_t elapsed_us;  // Since the handle was opened or stats reset
+
+    uint64_t set_reports;
+    uint64_t get_reports;
+    uint64_t bytes_sent;
+    uint64_t bytes_received;
+    uint64_t transfer_errors;  // Transfers that failed, timeouts included
+    uint64_t timeouts;         // Transfers that hit their timeout
+
+    uint64_t cmd_retries;  // Commands das4q_send_cmd had to start over
+    uint64_t key_retries;  // Keys sent again after a bad or missing ack
+    uint64_t ack_mismatches;  // Acks that came back as something else
+    uint64_t ack_timeouts;    // Acks that never came back
+
+    uint64_t keys_sent;    // Keys the keyboard acked
+    uint64_t keys_failed;  // Keys given up on
+
+    uint64_t backoff_us;       // Time spent waiting before retries
+    uint64_t budget_exceeded;  // Frames cut short by frame_budget_ms
+    uint64_t srtt_us;          // Smoothed transfer round trip time
+    uint64_t timeout_ms;       // Transfer timeout as of now
+
+    das4q_histogram_t latency[DAS4Q_STATS_NUM_OPS];
+} das4q_stats_t;
+
+/*
+ * Copies out the handle's counters.  May be called from another thread
+ * while the handle is busy.  Each counter is read atomically, but they're
+ * read one after another, so two of them can be a transfer or so apart.
+ */
+void das4q_get_stats(das4q_handle handle, das4q_stats_t *stats);
+
+// Zeroes the counters and restarts elapsed_us.  From the handle's thread.
+void das4q_reset_stats(das4q_handle handle);
+
+/*
+ * returns: the (exclusive) upper bound in us of the bucket holding the
+ *          p-th percentile (0 to 100) of a histogram, or its max for the
+ *          last bucket.  0 if it's empty.
+ */
+uint64_t das4q_histogram_percentile(const das4q_histogram_t *histogram,
+                                    double p);
+
+#endif  // LIBDAS4Q_H
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+# Copyright 2023 Patrick Erley <paerley@gmail.com>
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Generates the key name perfect hash table from keymap.h.
+
+Hash and displace: every name hashes to a bucket, and each bucket gets the
+seed that sends all of its names to empty slots.  A lookup is two hashes
+and one strcmp.
+
+    ./gen_keynames.py ../include/keymap.h > ../src/das4q_keynames.h
+"""
+
+import re
+import sys
+
+NUM_KEYS = 0x84
+# Extra names accepted for a key, alias: name in keymap.h.  keymap.h has
+# left control as KET_L_CTRL.
+ALIASES = {
+    "KEY_L_CTRL": "KET_L_CTRL",
+}
+
+
+def fnv1a(name, seed):
+    # Must match das4q_keyname_hash in das4q_keynames.c
+    h = 0x811C9DC5 ^ seed
+    for c in name.encode():
+        h ^= c
+        h = (h * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def build(keys):
+    nslots = 1
+    while nslots < len(keys):
+        nslots *= 2
+    nbuckets = max(1, len(keys) // 2)
+
+    buckets = [[] for _ in range(nbuckets)]
+    for name in keys:
+        buckets[fnv1a(name, 0) % nbuckets].append(name)
+
+    slots = [None] * nslots
+    seeds = [0] * nbuckets
+    # Biggest buckets first, while there's still room
+    for b in sorted(range(nbuckets), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+        for seed in range(1, 1 << 16):
+            want = [fnv1a(name, seed) % nslots for name in buckets[b]]
+            if len(set(want)) == len(want) and all(
+                slots[s] is None for s in want
+            ):
+                break
+        else:
+            sys.exit("no seed found for bucket %d" % b)
+        seeds[b] = seed
+        for name, s in zip(buckets[b], want):
+            slots[s] = name
+    return seeds, slots
+
+
+def main():
+    keymap = open(sys.argv[1]).read()
+    keys = {}
+    for name, value in re.findall(r"^\s*(K\w+)\s*=\s*(0x[0-9a-fA-F]+)",
+                                  keymap, re.M):
+        keys[name] = int(value, 16)
+    # Looked up like any other name, but das4q_key_name still gives keymap.h's
+    lookup = dict(keys)
+    for alias, name in ALIASES.items():
+        lookup[alias] = keys[name]
+
+    seeds, slots = build(list(lookup))
+
+    out = []
+    out.append("// Generated by scripts/gen_keynames.py from keymap.h.  Don't "
+               "edit,")
+    out.append("// rerun the script when keymap.h changes.")
+    out.append("")
+    out.append("#ifndef DAS4Q_KEYNAMES_H")
+    out.append("#define DAS4Q_KEYNAMES_H")
+    out.append("")
+    out.append("#define DAS4Q_KEYNAME_BUCKETS %d" % len(seeds))
+    out.append("#define DAS4Q_KEYNAME_SLOTS %d" % len(slots))
+    out.append("")
+    out.append("static const uint16_t "
+               "das4q_keyname_seeds[DAS4Q_KEYNAME_BUCKETS] = {")
+    for i in range(0, len(seeds), 8):
+        out.append("    " + " ".join("%d," % s for s in seeds[i:i + 8]))
+    out.append("};")
+    out.append("")
+    out.append("static const das4q_keyname_t "
+               "das4q_keyname_slots[DAS4Q_KEYNAME_SLOTS] = {")
+    for name in slots:
+        if name is None:
+            out.append("    {NULL, 0},")
+        else:
+            out.append('    {"%s", 0x%02x},' % (name, lookup[name]))
+    out.append("};")
+    out.append("")
+    out.append("static const char* const das4q_key_names[DAS4Q_NUM_KEYS] = {")
+    for name, value in sorted(keys.items(), key=lambda kv: kv[1]):
+        out.append('    [0x%02x] = "%s",' % (value, name))
+    out.append("};")
+    out.append("")
+    out.append("#endif  // DAS4Q_KEYNAMES_H")
+    print("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+# Copyright 2023 Patrick Erley <paerley@gmail.com>
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Generates the physical key layout tables from keymap.h.
+
+Positions are in key widths (u) below and in 1/8 u in the output, which
+keeps every edge and centre an integer.  For each key the output has its
+rectangle, the keys next to it, and its distance to every other key.
+
+    ./gen_layout.py ../include/keymap.h > ../src/das4q_layout_table.h
+"""
+
+import math
+import re
+import sys
+
+NUM_KEYS = 0x84
+UNIT = 8
+# Keys less than NEIGHBOUR_GAP_X apart across and at most NEIGHBOUR_GAP_Y
+# apart down count as neighbours.  Bridges the half key gap under the F row
+# and the quarter gap around the arrows, without reaching two keys over on
+# the staggered rows.
+NEIGHBOUR_GAP_X = 0.5
+NEIGHBOUR_GAP_Y = 0.5
+MAX_NEIGHBOURS = 16
+
+# name: (x, y, w, h), standard 104 key ANSI.  The 4Q's media keys sit above
+# the number pad.
+LAYOUT = {
+    "KEY_ESCAPE": (0, 0, 1, 1),
+    "KEY_F1": (2, 0, 1, 1),
+    "KEY_F2": (3, 0, 1, 1),
+    "KEY_F3": (4, 0, 1, 1),
+    "KEY_F4": (5, 0, 1, 1),
+    "KEY_F5": (6.5, 0, 1, 1),
+    "KEY_F6": (7.5, 0, 1, 1),
+    "KEY_F7": (8.5, 0, 1, 1),
+    "KEY_F8": (9.5, 0, 1, 1),
+    "KEY_F9": (11, 0, 1, 1),
+    "KEY_F10": (12, 0, 1, 1),
+    "KEY_F11": (13, 0, 1, 1),
+    "KEY_F12": (14, 0, 1, 1),
+    "KEY_PRINT_SCR": (15.25, 0, 1, 1),
+    "KEY_SCROLL_LOCK": (16.25, 0, 1, 1),
+    "KEY_PAUSE": (17.25, 0, 1, 1),
+    "KEY_SLEEP": (18.5, 0, 1, 1),
+    "KEY_BACKLIGHT_CTRL": (19.5, 0, 1, 1),
+    "KEY_MEDIA_PLAY_PAUSE": (20.5, 0, 1, 1),
+    "KEY_MEDIA_NEXT_TRACK": (21.5, 0, 1, 1),
+
+    "KEY_TILDE": (0, 1.5, 1, 1),
+    "KEY_1": (1, 1.5, 1, 1),
+    "KEY_2": (2, 1.5, 1, 1),
+    "KEY_3": (3, 1.5, 1, 1),
+    "KEY_4": (4, 1.5, 1, 1),
+    "KEY_5": (5, 1.5, 1, 1),
+    "KEY_6": (6, 1.5, 1, 1),
+    "KEY_7": (7, 1.5, 1, 1),
+    "KEY_8": (8, 1.5, 1, 1),
+    "KEY_9": (9, 1.5, 1, 1),
+    "KEY_0": (10, 1.5, 1, 1),
+    "KEY_DASH_UNDERSCORE": (11, 1.5, 1, 1),
+    "KEY_EQUALS_PLUS": (12, 1.5, 1, 1),
+    "KEY_BACKSPACE": (13, 1.5, 2, 1),
+    "KEY_INSERT": (15.25, 1.5, 1, 1),
+    "KEY_HOME": (16.25, 1.5, 1, 1),
+    "KEY_PAGE_UP": (17.25, 1.5, 1, 1),
+    "KEY_NUMLOCK": (18.5, 1.5, 1, 1),
+    "KEY_NUM_SLASH": (19.5, 1.5, 1, 1),
+    "KEY_NUM_STAR": (20.5, 1.5, 1, 1),
+    "KEY_NUM_MINUS": (21.5, 1.5, 1, 1),
+
+    "KEY_TAB": (0, 2.5, 1.5, 1),
+    "KEY_Q": (1.5, 2.5, 1, 1),
+    "KEY_W": (2.5, 2.5, 1, 1),
+    "KEY_E": (3.5, 2.5, 1, 1),
+    "KEY_R": (4.5, 2.5, 1, 1),
+    "KEY_T": (5.5, 2.5, 1, 1),
+    "KEY_Y": (6.5, 2.5, 1, 1),
+    "KEY_U": (7.5, 2.5, 1, 1),
+    "KEY_I": (8.5, 2.5, 1, 1),
+    "KEY_O": (9.5, 2.5, 1, 1),
+    "KEY_P": (10.5, 2.5, 1, 1),
+    "KEY_L_BRACKET": (11.5, 2.5, 1, 1),
+    "KEY_R_BRACKET": (12.5, 2.5, 1, 1),
+    "KEY_BACKSLASH": (13.5, 2.5, 1.5, 1),
+    "KEY_DELETE": (15.25, 2.5, 1, 1),
+    "KEY_END": (16.25, 2.5, 1, 1),
+    "KEY_PAGE_DOWN": (17.25, 2.5, 1, 1),
+    "KEY_NUM_7": (18.5, 2.5, 1, 1),
+    "KEY_NUM_8": (19.5, 2.5, 1, 1),
+    "KEY_NUM_9": (20.5, 2.5, 1, 1),
+    "KEY_NUM_PLUS": (21.5, 2.5, 1, 2),
+
+    "KEY_CAPSLOCK": (0, 3.5, 1.75, 1),
+    "KEY_A": (1.75, 3.5, 1, 1),
+    "KEY_S": (2.75, 3.5, 1, 1),
+    "KEY_D": (3.75, 3.5, 1, 1),
+    "KEY_F": (4.75, 3.5, 1, 1),
+    "KEY_G": (5.75, 3.5, 1, 1),
+    "KEY_H": (6.75, 3.5, 1, 1),
+    "KEY_J": (7.75, 3.5, 1, 1),
+    "KEY_K": (8.75, 3.5, 1, 1),
+    "KEY_L": (9.75, 3.5, 1, 1),
+    "KEY_SEMICOLON": (10.75, 3.5, 1, 1),
+    "KEY_APOSTROPHE": (11.75, 3.5, 1, 1),
+    "KEY_ENTER": (12.75, 3.5, 2.25, 1),
+    "KEY_NUM_4": (18.5, 3.5, 1, 1),
+    "KEY_NUM_5": (19.5, 3.5, 1, 1),
+    "KEY_NUM_6": (20.5, 3.5, 1, 1),
+
+    "KEY_L_SHIFT": (0, 4.5, 2.25, 1),
+    "KEY_Z": (2.25, 4.5, 1, 1),
+    "KEY_X": (3.25, 4.5, 1, 1),
+    "KEY_C": (4.25, 4.5, 1, 1),
+    "KEY_V": (5.25, 4.5, 1, 1),
+    "KEY_B": (6.25, 4.5, 1, 1),
+    "KEY_N": (7.25, 4.5, 1, 1),
+    "KEY_M": (8.25, 4.5, 1, 1),
+    "KEY_COMMA": (9.25, 4.5, 1, 1),
+    "KEY_PERIOD": (10.25, 4.5, 1, 1),
+    "KEY_SLASH": (11.25, 4.5, 1, 1),
+    "KEY_R_SHIFT": (12.25, 4.5, 2.75, 1),
+    "KEY_ARROW_UP": (16.25, 4.5, 1, 1),
+    "KEY_NUM_1": (18.5, 4.5, 1, 1),
+    "KEY_NUM_2": (19.5, 4.5, 1, 1),
+    "KEY_NUM_3": (20.5, 4.5, 1, 1),
+    "KEY_NUM_ENTER": (21.5, 4.5, 1, 2),
+
+    "KET_L_CTRL": (0, 5.5, 1.25, 1),
+    "KEY_L_SUPER": (1.25, 5.5, 1.25, 1),
+    "KEY_L_ALT": (2.5, 5.5, 1.25, 1),
+    "KEY_SPACE": (3.75, 5.5, 6.25, 1),
+    "KEY_R_ALT": (10, 5.5, 1.25, 1),
+    "KEY_R_SUPER": (11.25, 5.5, 1.25, 1),
+    "KEY_META": (12.5, 5.5, 1.25, 1),
+    "KEY_R_CTRL": (13.75, 5.5, 1.25, 1),
+    "KEY_ARROW_LEFT": (15.25, 5.5, 1, 1),
+    "KEY_ARROW_DOWN": (16.25, 5.5, 1, 1),
+    "KEY_ARROW_RIGHT": (17.25, 5.5, 1, 1),
+    "KEY_NUM_0": (18.5, 5.5, 2, 1),
+    "KEY_NUM_PERIOD": (20.5, 5.5, 1, 1),
+}
+
+# slot: (x, y, w, h) for the extra LEDs under the wide keys, which have no
+# name in keymap.h.  Each covers the part of its key it lights, the
+# spacebar's seven are spread evenly along it with KEY_SPACE in the middle.
+LEDS = {
+    0x07: (1.125, 4.5, 1.125, 1),  # Right half of left shift
+    0x12: (3.75, 5.5, 1, 1),  # Spacebar, left end
+    0x18: (4.625, 5.5, 1, 1),
+    0x1e: (5.5, 5.5, 1, 1),
+    0x2a: (7.25, 5.5, 1, 1),
+    0x30: (8.125, 5.5, 1, 1),
+    0x36: (9, 5.5, 1, 1),  # Spacebar, right end
+    0x49: (12.25, 4.5, 1, 1),  # Left end of right shift
+    0x4a: (12.75, 3.5, 1, 1),  # Left end of enter
+    0x6c: (19.5, 5.5, 1, 1),  # Right half of num pad 0
+}
+
+
+def gap(a0, a1, b0, b1):
+    return max(0, max(a0, b0) - min(a1, b1))
+
+
+def main():
+    keymap = open(sys.argv[1]).read()
+    keys = {}
+    for name, value in re.findall(r"^\s*(K\w+)\s*=\s*(0x[0-9a-fA-F]+)",
+                                  keymap, re.M):
+        keys[name] = int(value, 16)
+    if set(keys) != set(LAYOUT):
+        sys.exit("keymap.h and LAYOUT disagree: %s" %
+                 sorted(set(keys) ^ set(LAYOUT)))
+
+    if set(keys.values()) & set(LEDS):
+        sys.exit("LEDS has named keys: %s" %
+                 sorted("0x%02x" % k for k in set(keys.values()) & set(LEDS)))
+
+    names = [None] * NUM_KEYS
+    rects = [None] * NUM_KEYS
+    layout = [(name, value, LAYOUT[name]) for name, value in keys.items()]
+    layout += [("0x%02x" % value, value, rect)
+               for value, rect in LEDS.items()]
+    for name, value, rect in layout:
+        names[value] = name
+        rects[value] = tuple(int(v * UNIT) for v in rect)
+        if any(v * UNIT != int(v * UNIT) for v in rect):
+            sys.exit("%s isn't on the 1/%d u grid" % (name, UNIT))
+
+    present = [k for k in range(NUM_KEYS) if rects[k] is not None]
+    neighbours = [[] for _ in range(NUM_KEYS)]
+    for a in present:
+        ax, ay, aw, ah = rects[a]
+        for b in present:
+            bx, by, bw, bh = rects[b]
+            gap_x = gap(ax, ax + aw, bx, bx + bw)
+            gap_y = gap(ay, ay + ah, by, by + bh)
+            if a != b and gap_x < NEIGHBOUR_GAP_X * UNIT and \
+                    gap_y <= NEIGHBOUR_GAP_Y * UNIT:
+                neighbours[a].append(b)
+        if len(neighbours[a]) > MAX_NEIGHBOURS:
+            sys.exit("%s has %d neighbours" % (names[a], len(neighbours[a])))
+
+    def centre(k):
+        x, y, w, h = rects[k]
+        return (x + w / 2, y + h / 2)
+
+    distance = [[0xFF] * NUM_KEYS for _ in range(NUM_KEYS)]
+    for a in present:
+        for b in present:
+            (ax, ay), (bx, by) = centre(a), centre(b)
+            distance[a][b] = int(round(math.hypot(ax - bx, ay - by)))
+            assert distance[a][b] < 0xFF
+
+    out = []
+    out.append("// Generated by scripts/gen_layout.py from keymap.h.  Don't "
+               "edit,")
+    out.append("// rerun the script when keymap.h or the layout changes.")
+    out.append("")
+    out.append("#ifndef DAS4Q_LAYOUT_TABLE_H")
+    out.append("#define DAS4Q_LAYOUT_TABLE_H")
+    out.append("")
+    out.append("#if DAS4Q_LAYOUT_UNIT != %d || DAS4Q_MAX_NEIGHBOURS != %d" %
+               (UNIT, MAX_NEIGHBOURS))
+    out.append("#error das4q_layout.h and gen_layout.py disagree")
+    out.append("#endif")
+    out.append("")
+    out.append("static const das4q_key_geometry_t "
+               "das4q_layout_keys[DAS4Q_NUM_KEYS] = {")
+    for k in present:
+        x, y, w, h = rects[k]
+        cx, cy = centre(k)
+        out.append("    [%s] = {%d, %d, %d, %d, %d, %d}," %
+                   (names[k], x, y, w, h, cx, cy))
+    out.append("};")
+    out.append("")
+    out.append("// das4q_layout_neighbours[das4q_layout_neighbour_start[k]] "
+               "onwards, up to")
+    out.append("// das4q_layout_neighbour_start[k + 1]")
+    out.append("static const uint16_t "
+               "das4q_layout_neighbour_start[DAS4Q_NUM_KEYS + 1] = {")
+    starts = [0]
+    for k in range(NUM_KEYS):
+        starts.append(starts[-1] + len(neighbours[k]))
+    for i in range(0, len(starts), 8):
+        out.append("    " + " ".join("%d," % s for s in starts[i:i + 8]))
+    out.append("};")
+    out.append("")
+    out.append("static const das4q_map_t das4q_layout_neighbours[%d] = {" %
+               starts[-1])
+    for k in present:
+        out.append("    // %s" % names[k])
+        line = "   "
+        for n in neighbours[k]:
+            item = " %s," % names[n]
+            if len(line) + len(item) > 79:
+                out.append(line)
+                line = "   "
+            line += item
+        out.append(line)
+    out.append("};")
+    out.append("")
+    out.append("// Centre to centre, DAS4Q_LAYOUT_NO_KEY where either slot "
+               "has no key")
+    out.append("static const uint8_t "
+               "das4q_layout_distance[DAS4Q_NUM_KEYS][DAS4Q_NUM_KEYS] = {")
+    for a in range(NUM_KEYS):
+        out.append("    [0x%02x] = {" % a)
+        row = distance[a]
+        for i in range(0, NUM_KEYS, 12):
+            out.append("        " +
+                       " ".join("%d," % d for d in row[i:i + 12]))
+        out.append("    },")
+    out.append("};")
+    out.append("")
+    out.append("#endif  // DAS4Q_LAYOUT_TABLE_H")
+    print("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
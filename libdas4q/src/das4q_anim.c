@@ -0,0 +1,210 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "das4q_anim.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "das4q_priv.h"
+
+typedef struct das4q_anim_effect {
+    das4q_effect_fn fn;
+    void* user_data;
+} das4q_anim_effect_t;
+
+struct das4q_anim {
+    das4q_priv_t* priv;
+    int fd;
+    int fps;
+
+    das4q_anim_effect_t effects[DAS4Q_ANIM_MAX_EFFECTS];
+    int neffects;
+
+    das4q_setting_t frame[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t aframe[DAS4Q_NUM_KEYS];
+
+    struct timespec start;
+    volatile sig_atomic_t stopped;
+
+    uint64_t frames;
+    uint64_t dropped;
+    uint64_t failed;
+    uint64_t keys_sent;
+    uint64_t busy_us;
+};
+
+static uint64_t das4q_anim_us_since(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - start->tv_sec) * 1000000 +
+           (now.tv_nsec - start->tv_nsec) / 1000;
+}
+
+das4q_anim_t* das4q_anim_new(das4q_handle handle, int fps) {
+    das4q_priv_t* priv = handle;
+
+    if (fps < 1 || fps > 1000) {
+        errno = -EINVAL;
+        return NULL;
+    }
+    das4q_anim_t* anim = calloc(1, sizeof(das4q_anim_t));
+    if (anim == NULL) {
+        return NULL;
+    }
+    anim->fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (anim->fd < 0) {
+        free(anim);
+        return NULL;
+    }
+    anim->priv = priv;
+    anim->fps = fps;
+
+    // Pick up from whatever's on the keyboard now
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        if (priv->cache_valid[i]) {
+            anim->frame[i] = priv->cache[i];
+            anim->aframe[i] = priv->active_cache[i];
+        } else {
+            anim->frame[i].mode = DAS4Q_MODE_SOLID;
+        }
+    }
+    return anim;
+}
+
+void das4q_anim_free(das4q_anim_t* anim) {
+    if (anim == NULL) {
+        return;
+    }
+    close(anim->fd);
+    free(anim);
+}
+
+bool das4q_anim_add_effect(das4q_anim_t* anim, das4q_effect_fn effect,
+                           void* user_data) {
+    if (anim->neffects >= DAS4Q_ANIM_MAX_EFFECTS) {
+        return false;
+    }
+    anim->effects[anim->neffects].fn = effect;
+    anim->effects[anim->neffects].user_data = user_data;
+    anim->neffects++;
+    return true;
+}
+
+int das4q_anim_get_fd(das4q_anim_t* anim) { return anim->fd; }
+
+static int das4q_anim_arm(das4q_anim_t* anim, bool on) {
+    struct itimerspec spec = {0};
+    if (on) {
+        long period_ns = 1000000000L / anim->fps;
+        spec.it_interval.tv_sec = period_ns / 1000000000L;
+        spec.it_interval.tv_nsec = period_ns % 1000000000L;
+        // First frame right away
+        spec.it_value.tv_nsec = 1;
+    }
+    if (timerfd_settime(anim->fd, 0, &spec, NULL) < 0) {
+        return -errno;
+    }
+    return 0;
+}
+
+int das4q_anim_start(das4q_anim_t* anim) {
+    anim->frames = 0;
+    anim->dropped = 0;
+    anim->failed = 0;
+    anim->keys_sent = 0;
+    anim->busy_us = 0;
+    anim->stopped = 0;
+    clock_gettime(CLOCK_MONOTONIC, &anim->start);
+    return das4q_anim_arm(anim, true);
+}
+
+int das4q_anim_dispatch(das4q_anim_t* anim) {
+    uint64_t ticks;
+
+    if (anim->stopped) {
+        das4q_anim_arm(anim, false);
+        return 1;
+    }
+    if (read(anim->fd, &ticks, sizeof(ticks)) != sizeof(ticks)) {
+        return errno == EAGAIN ? 0 : -errno;
+    }
+    // Only the newest tick gets a frame, the rest went by while the last
+    // one was being sent.
+    anim->dropped += ticks - 1;
+
+    struct timespec frame_start;
+    clock_gettime(CLOCK_MONOTONIC, &frame_start);
+    uint64_t t_us = das4q_anim_us_since(&anim->start);
+    for (int i = 0; i < anim->neffects; i++) {
+        if (!anim->effects[i].fn(t_us, anim->frame, anim->aframe,
+                                 anim->effects[i].user_data)) {
+            anim->stopped = 1;
+        }
+    }
+
+    int ret = das4q_update_frame(anim->priv, anim->frame, anim->aframe);
+    if (ret < 0) {
+        anim->failed++;
+    } else if (ret > 0) {
+        anim->keys_sent += ret;
+        das4q_apply_changes(anim->priv);
+    }
+    anim->frames++;
+    anim->busy_us += das4q_anim_us_since(&frame_start);
+
+    if (anim->stopped) {
+        das4q_anim_arm(anim, false);
+        return 1;
+    }
+    return 0;
+}
+
+int das4q_anim_run(das4q_anim_t* anim) {
+    int ret = das4q_anim_start(anim);
+
+    while (ret == 0) {
+        struct pollfd pfd = {.fd = anim->fd, .events = POLLIN};
+        if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+            ret = -errno;
+            break;
+        }
+        ret = das4q_anim_dispatch(anim);
+    }
+    return ret < 0 ? ret : 0;
+}
+
+void das4q_anim_stop(das4q_anim_t* anim) { anim->stopped = 1; }
+
+void das4q_anim_get_stats(das4q_anim_t* anim, das4q_anim_stats_t* stats) {
+    uint64_t elapsed_us = das4q_anim_us_since(&anim->start);
+
+    memset(stats, 0, sizeof(*stats));
+    stats->target_fps = anim->fps;
+    stats->frames = anim->frames;
+    stats->dropped = anim->dropped;
+    stats->failed = anim->failed;
+    stats->keys_sent = anim->keys_sent;
+    if (elapsed_us > 0) {
+        stats->achieved_fps = anim->frames * 1000000.0 / elapsed_us;
+        stats->link_utilization = (double)anim->busy_us / elapsed_us;
+    }
+}
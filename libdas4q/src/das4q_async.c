@@ -0,0 +1,486 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <errno.h>
+#include <libusb-1.0/libusb.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "das4q_priv.h"
+#include "libdas4q.h"
+
+/*
+ * Non-blocking key updates.
+ *
+ * This is the same protocol as das4q_stream_keys with an ack window of 1,
+ * turned inside out: every SET_REPORT and GET_REPORT is a libusb transfer,
+ * and the completion callback submits whatever comes next.  Only one
+ * transfer is ever in flight, the keyboard only has the one byte stream.
+ */
+
+typedef struct das4q_async_op {
+    struct das4q_async_op* next;
+    das4q_done_cb cb;
+    void* user_data;
+
+    // Diff against the keyboard's state when the op starts, rather than
+    // sending the keys given.
+    bool diff;
+    das4q_setting_t settings[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t active_settings[DAS4Q_NUM_KEYS];
+
+    uint8_t tries[DAS4Q_NUM_KEYS];
+    das4q_map_t work[DAS4Q_NUM_KEYS * DAS4Q_MAX_KEY_ATTEMPTS];
+    int nwork;
+    int cur;     // work[cur] is the key waiting on an ack
+    size_t pos;  // Next byte of the stream to go out
+    int sent;
+    int status;
+} das4q_async_op_t;
+
+typedef struct das4q_async {
+    das4q_priv_t* priv;
+    struct libusb_transfer* xfer;
+    uint8_t buffer[LIBUSB_CONTROL_SETUP_SIZE + 8];
+    bool in_flight;
+    bool reading;
+    uint64_t submit_us;
+
+    das4q_async_op_t* head;
+    das4q_async_op_t* tail;
+    int pending;
+
+    // Finished ops whose callbacks das4q_handle_events hasn't run yet
+    das4q_async_op_t* done_head;
+    das4q_async_op_t* done_tail;
+
+    uint8_t ack[128];
+    int ack_len;
+} das4q_async_t;
+
+static void das4q_async_cb(struct libusb_transfer* xfer);
+
+static das4q_async_t* das4q_async_get(das4q_priv_t* priv) {
+    if (priv->async != NULL) {
+        return priv->async;
+    }
+
+    das4q_async_t* async = calloc(1, sizeof(das4q_async_t));
+    if (async == NULL) {
+        return NULL;
+    }
+    async->xfer = libusb_alloc_transfer(0);
+    if (async->xfer == NULL) {
+        free(async);
+        return NULL;
+    }
+    async->priv = priv;
+    priv->async = async;
+    return async;
+}
+
+static int das4q_async_submit(das4q_async_t* async, bool in) {
+    uint8_t request_type = LIBUSB_REQUEST_TYPE_CLASS |
+                           LIBUSB_RECIPIENT_INTERFACE |
+                           (in ? LIBUSB_ENDPOINT_IN : LIBUSB_ENDPOINT_OUT);
+
+    libusb_fill_control_setup(async->buffer, request_type,
+                              in ? HID_GET_REPORT : HID_SET_REPORT,
+                              HID_REPORT_TYPE_FEATURE << 8 | 0x01, 1, 8);
+    libusb_fill_control_transfer(async->xfer, async->priv->handle,
+                                 async->buffer, das4q_async_cb, async,
+                                 das4q_io_timeout_ms(async->priv));
+    async->reading = in;
+    async->submit_us = das4q_stats_now_us();
+
+    int ret = libusb_submit_transfer(async->xfer);
+    if (ret < 0) {
+        DAS4Q_ERROR("Failed to submit transfer: %s", libusb_error_name(ret));
+        return -EIO;
+    }
+    async->in_flight = true;
+    return 0;
+}
+
+static int das4q_async_send_next(das4q_async_t* async) {
+    das4q_async_op_t* op = async->head;
+    uint8_t(*encoded)[DAS4Q_KEY_CMDS_LEN] = async->priv->encoded;
+    uint8_t* usbcmd = async->buffer + LIBUSB_CONTROL_SETUP_SIZE;
+    size_t end = op->nwork * DAS4Q_KEY_CMDS_LEN;
+
+    memset(usbcmd, 0, 8);
+    usbcmd[0] = 0x01;
+    for (int i = 1; i < 8 && op->pos < end; i++, op->pos++) {
+        usbcmd[i] = encoded[op->work[op->pos / DAS4Q_KEY_CMDS_LEN]]
+                           [op->pos % DAS4Q_KEY_CMDS_LEN];
+    }
+    // das4q_async_submit fills in the setup packet and leaves the data be
+    return das4q_async_submit(async, false);
+}
+
+static void das4q_async_start(das4q_async_t* async);
+
+/*
+ * Retires the op at the head of the queue and starts the next.  Its
+ * callback waits for das4q_handle_events, since an op with nothing to
+ * send finishes inside the call that queued it.
+ */
+static void das4q_async_finish(das4q_async_t* async) {
+    das4q_async_op_t* op = async->head;
+
+    async->head = op->next;
+    if (async->head == NULL) {
+        async->tail = NULL;
+    }
+    op->next = NULL;
+    if (async->done_tail != NULL) {
+        async->done_tail->next = op;
+    } else {
+        async->done_head = op;
+    }
+    async->done_tail = op;
+
+    das4q_async_start(async);
+}
+
+// Runs the callbacks of the ops finished so far.  Ops finished by those
+// callbacks wait for the next call.
+static void das4q_async_deliver(das4q_async_t* async) {
+    das4q_async_op_t* op = async->done_head;
+
+    async->done_head = NULL;
+    async->done_tail = NULL;
+    while (op != NULL) {
+        das4q_async_op_t* next = op->next;
+        async->pending--;
+        if (op->cb != NULL) {
+            op->cb(async->priv, op->status < 0 ? op->status : op->sent,
+                   op->user_data);
+        }
+        free(op);
+        op = next;
+    }
+}
+
+// Moves on from work[cur], which either made it or didn't.
+static void das4q_async_key_done(das4q_async_t* async, bool ok) {
+    das4q_async_op_t* op = async->head;
+    das4q_map_t key = op->work[op->cur];
+
+    if (ok) {
+        das4q_shadow_set(async->priv, key, op->settings[key],
+                         op->active_settings[key]);
+        op->sent++;
+    } else {
+        async->priv->shadow_valid[key] = false;
+        // No backoff, sleeping here would stall the caller's event loop
+        if (++op->tries[key] < async->priv->retry.key_attempts) {
+            DAS4Q_STATS_ADD(async->priv, key_retries, 1);
+            op->work[op->nwork++] = key;
+        } else {
+            DAS4Q_STATS_ADD(async->priv, keys_failed, 1);
+            op->status = -EIO;
+        }
+    }
+    op->cur++;
+
+    if (op->cur >= op->nwork) {
+        das4q_async_finish(async);
+        return;
+    }
+    if (!ok) {
+        // Start the retry on a fresh report
+        op->pos = op->cur * DAS4Q_KEY_CMDS_LEN;
+    }
+    if (das4q_async_send_next(async) < 0) {
+        op->status = -EIO;
+        das4q_async_finish(async);
+    }
+}
+
+static bool das4q_async_check_ack(das4q_async_t* async) {
+    const uint8_t success_packet[] = {0xed, 0x03, 0x78, 0x00, 0x96};
+
+    for (int i = 0; i < async->ack_len; i++) {
+        if (async->ack[i] == 0xed) {
+            bool ok = i + (int)sizeof(success_packet) <= async->ack_len &&
+                      memcmp(async->ack + i, success_packet,
+                             sizeof(success_packet)) == 0;
+            if (!ok) {
+                DAS4Q_STATS_ADD(async->priv, ack_mismatches, 1);
+            }
+            return ok;
+        }
+    }
+    DAS4Q_STATS_ADD(async->priv, ack_timeouts, 1);
+    return false;
+}
+
+static void das4q_async_cb(struct libusb_transfer* xfer) {
+    das4q_async_t* async = xfer->user_data;
+    das4q_async_op_t* op = async->head;
+    bool ok = xfer->status == LIBUSB_TRANSFER_COMPLETED;
+
+    async->in_flight = false;
+    if (xfer->status == LIBUSB_TRANSFER_CANCELLED || op == NULL) {
+        return;
+    }
+    // Counted the way the blocking calls see it
+    int ret = xfer->actual_length;
+    if (xfer->status == LIBUSB_TRANSFER_TIMED_OUT) {
+        ret = LIBUSB_ERROR_TIMEOUT;
+    } else if (!ok) {
+        ret = LIBUSB_ERROR_IO;
+    }
+    das4q_stats_transfer(async->priv, async->reading, ret, async->submit_us);
+
+    if (!async->reading) {
+        if (!ok || xfer->actual_length != 8) {
+            das4q_async_key_done(async, false);
+            return;
+        }
+        if (op->pos < (op->cur + 1) * DAS4Q_KEY_CMDS_LEN) {
+            ok = das4q_async_send_next(async) == 0;
+        } else {
+            async->ack_len = 0;
+            ok = das4q_async_submit(async, true) == 0;
+        }
+        if (!ok) {
+            das4q_async_key_done(async, false);
+        }
+        return;
+    }
+
+    if (!ok) {
+        das4q_async_key_done(async, false);
+        return;
+    }
+
+    // Same as read_get_report, keep reading until an empty chunk
+    const uint8_t empty[8] = {0};
+    uint8_t* chunk = libusb_control_transfer_get_data(xfer);
+    bool done = xfer->actual_length <= 0 || memcmp(chunk, empty, 8) == 0;
+    if (xfer->actual_length > 0 &&
+        async->ack_len + xfer->actual_length <= (int)sizeof(async->ack)) {
+        memcpy(async->ack + async->ack_len, chunk, xfer->actual_length);
+        async->ack_len += xfer->actual_length;
+    } else {
+        done = true;
+    }
+
+    if (!done && das4q_async_submit(async, true) == 0) {
+        return;
+    }
+    das4q_async_key_done(async, das4q_async_check_ack(async));
+}
+
+// Kicks off the op at the head of the queue, if nothing is running.
+static void das4q_async_start(das4q_async_t* async) {
+    while (async->head != NULL && !async->in_flight) {
+        das4q_async_op_t* op = async->head;
+
+        if (op->diff) {
+            op->nwork = das4q_diff_frame(async->priv, op->settings,
+                                         op->active_settings, op->work);
+        }
+        // Only one op runs at a time, so it has priv->encoded to itself
+        for (int i = 0; i < op->nwork; i++) {
+            das4q_map_t key = op->work[i];
+            das4q_encode_key(async->priv, key, op->settings[key],
+                             op->active_settings[key]);
+            das4q_cache_set(async->priv, key, op->settings[key],
+                            op->active_settings[key]);
+        }
+
+        if (op->nwork == 0) {
+            // Nothing to send, das4q_async_finish starts the next one.
+            das4q_async_finish(async);
+            return;
+        }
+        if (das4q_async_send_next(async) < 0) {
+            op->status = -EIO;
+            das4q_async_finish(async);
+            return;
+        }
+    }
+}
+
+static int das4q_async_queue(das4q_priv_t* priv, das4q_async_op_t* op) {
+    // Only libusb can do this without blocking
+    if (priv->handle == NULL) {
+        free(op);
+        return -ENOTSUP;
+    }
+
+    das4q_async_t* async = das4q_async_get(priv);
+    if (async == NULL) {
+        free(op);
+        return -ENOMEM;
+    }
+
+    if (async->tail != NULL) {
+        async->tail->next = op;
+    } else {
+        async->head = op;
+    }
+    async->tail = op;
+    async->pending++;
+
+    das4q_async_start(async);
+    return 0;
+}
+
+int das4q_update_frame_async(
+    das4q_handle handle, const das4q_setting_t settings[DAS4Q_NUM_KEYS],
+    const das4q_active_setting_t active_settings[DAS4Q_NUM_KEYS],
+    das4q_done_cb cb, void* user_data) {
+    das4q_async_op_t* op = calloc(1, sizeof(das4q_async_op_t));
+    if (op == NULL) {
+        return -ENOMEM;
+    }
+
+    op->cb = cb;
+    op->user_data = user_data;
+    op->diff = true;
+    memcpy(op->settings, settings, sizeof(op->settings));
+    memcpy(op->active_settings, active_settings,
+           sizeof(op->active_settings));
+    return das4q_async_queue(handle, op);
+}
+
+int das4q_set_key_backlight_async(das4q_handle handle, das4q_map_t key,
+                                  das4q_setting_t setting,
+                                  das4q_active_setting_t active,
+                                  das4q_done_cb cb, void* user_data) {
+    if (key >= DAS4Q_NUM_KEYS) {
+        return -EINVAL;
+    }
+
+    das4q_async_op_t* op = calloc(1, sizeof(das4q_async_op_t));
+    if (op == NULL) {
+        return -ENOMEM;
+    }
+
+    op->cb = cb;
+    op->user_data = user_data;
+    op->settings[key] = setting;
+    op->active_settings[key] = active;
+    op->work[0] = key;
+    op->nwork = 1;
+    return das4q_async_queue(handle, op);
+}
+
+int das4q_async_pending(das4q_handle handle) {
+    das4q_priv_t* priv = handle;
+    return priv->async != NULL ? priv->async->pending : 0;
+}
+
+int das4q_get_pollfds(das4q_handle handle, struct pollfd* fds, int nfds) {
+    das4q_priv_t* priv = handle;
+    const struct libusb_pollfd** usbfds;
+    int total = 0;
+
+    if (priv->ctx == NULL) {
+        return -ENOTSUP;
+    }
+    usbfds = libusb_get_pollfds(priv->ctx);
+    if (usbfds == NULL) {
+        return -ENOTSUP;
+    }
+    for (; usbfds[total] != NULL; total++) {
+        if (total < nfds) {
+            fds[total].fd = usbfds[total]->fd;
+            fds[total].events = usbfds[total]->events;
+            fds[total].revents = 0;
+        }
+    }
+    libusb_free_pollfds(usbfds);
+    return total;
+}
+
+void das4q_set_pollfd_notifiers(das4q_handle handle,
+                                das4q_pollfd_added_cb added,
+                                das4q_pollfd_removed_cb removed,
+                                void* user_data) {
+    das4q_priv_t* priv = handle;
+    if (priv->ctx != NULL) {
+        libusb_set_pollfd_notifiers(priv->ctx, added, removed, user_data);
+    }
+}
+
+int das4q_get_timeout(das4q_handle handle) {
+    das4q_priv_t* priv = handle;
+    struct timeval tv;
+
+    if (priv->ctx == NULL) {
+        return -1;
+    }
+    if (priv->async != NULL && priv->async->done_head != NULL) {
+        // Callbacks to run
+        return 0;
+    }
+    int ret = libusb_get_next_timeout(priv->ctx, &tv);
+    if (ret <= 0) {
+        return -1;
+    }
+    // Round up, waking early just means another trip round the loop
+    return tv.tv_sec * 1000 + (tv.tv_usec + 999) / 1000;
+}
+
+int das4q_handle_events(das4q_handle handle) {
+    das4q_priv_t* priv = handle;
+    struct timeval tv = {0, 0};
+
+    if (priv->ctx == NULL) {
+        return -ENOTSUP;
+    }
+    int ret = libusb_handle_events_timeout_completed(priv->ctx, &tv, NULL);
+    if (ret < 0) {
+        DAS4Q_ERROR("Failed to handle events: %s", libusb_error_name(ret));
+        return -EIO;
+    }
+    if (priv->async != NULL) {
+        das4q_async_deliver(priv->async);
+    }
+    das4q_hotplug_process(priv);
+    return 0;
+}
+
+void das4q_async_close(das4q_priv_t* priv) {
+    das4q_async_t* async = priv->async;
+    if (async == NULL) {
+        return;
+    }
+
+    if (async->in_flight && libusb_cancel_transfer(async->xfer) == 0) {
+        while (async->in_flight) {
+            libusb_handle_events_timeout_completed(priv->ctx, NULL, NULL);
+        }
+    }
+    libusb_free_transfer(async->xfer);
+
+    // Finished ones get their result, the rest never ran
+    das4q_async_deliver(async);
+    while (async->head != NULL) {
+        das4q_async_op_t* op = async->head;
+        async->head = op->next;
+        if (op->cb != NULL) {
+            op->cb(priv, -ECANCELED, op->user_data);
+        }
+        free(op);
+    }
+    free(async);
+    priv->async = NULL;
+}
@@ -0,0 +1,346 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "das4q_comp.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "das4q_planes.h"
+#include "das4q_priv.h"
+
+typedef struct das4q_comp_layer {
+    char name[DAS4Q_COMP_NAME_LEN];
+    int priority;
+
+    das4q_planes_t color;
+    das4q_keymode_t mode[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t active[DAS4Q_NUM_KEYS];
+    uint8_t alpha[DAS4Q_NUM_KEYS];
+    uint8_t opacity;
+    // alpha scaled by opacity, what the blend actually uses
+    uint8_t weight[DAS4Q_PLANE_LEN] __attribute__((aligned(32)));
+
+    // Timer wheel slot, while the layer has a lifetime
+    uint64_t expires_tick;
+    struct das4q_comp_layer* wheel_next;
+    struct das4q_comp_layer** wheel_prev;
+} das4q_comp_layer_t;
+
+struct das4q_comp {
+    das4q_priv_t* priv;
+    int fd;
+
+    // Bottom to top
+    das4q_comp_layer_t* layers[DAS4Q_COMP_MAX_LAYERS];
+    int nlayers;
+
+    /*
+     * Hashed timer wheel.  A layer due at tick t hangs off slot
+     * t % DAS4Q_COMP_WHEEL_SLOTS, and is only dropped when the wheel
+     * passes that slot on or after t.  Adding and removing are O(1), and
+     * each tick only looks at the layers in one slot.
+     */
+    das4q_comp_layer_t* wheel[DAS4Q_COMP_WHEEL_SLOTS];
+    int nwheel;
+    struct timespec start;
+    uint64_t tick;  // Last tick processed
+
+    // Keys some layer has covered at some point
+    bool touched[DAS4Q_NUM_KEYS];
+
+    das4q_planes_t out;
+    das4q_setting_t frame[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t aframe[DAS4Q_NUM_KEYS];
+};
+
+static uint64_t das4q_comp_now_tick(das4q_comp_t* comp) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t ms = (uint64_t)(now.tv_sec - comp->start.tv_sec) * 1000 +
+                  (now.tv_nsec - comp->start.tv_nsec) / 1000000;
+    return ms / DAS4Q_COMP_TICK_MS;
+}
+
+// Ticks while anything is on the wheel, stays quiet otherwise
+static int das4q_comp_arm(das4q_comp_t* comp) {
+    struct itimerspec spec = {0};
+    if (comp->nwheel > 0) {
+        spec.it_interval.tv_nsec = DAS4Q_COMP_TICK_MS * 1000000L;
+        spec.it_value = spec.it_interval;
+    }
+    if (timerfd_settime(comp->fd, 0, &spec, NULL) < 0) {
+        return -errno;
+    }
+    return 0;
+}
+
+static void das4q_comp_wheel_remove(das4q_comp_t* comp,
+                                    das4q_comp_layer_t* layer) {
+    if (layer->wheel_prev == NULL) {
+        return;
+    }
+    *layer->wheel_prev = layer->wheel_next;
+    if (layer->wheel_next != NULL) {
+        layer->wheel_next->wheel_prev = layer->wheel_prev;
+    }
+    layer->wheel_next = NULL;
+    layer->wheel_prev = NULL;
+    if (--comp->nwheel == 0) {
+        das4q_comp_arm(comp);
+    }
+}
+
+static void das4q_comp_wheel_add(das4q_comp_t* comp,
+                                 das4q_comp_layer_t* layer, uint32_t ttl_ms) {
+    uint64_t ticks = (ttl_ms + DAS4Q_COMP_TICK_MS - 1) / DAS4Q_COMP_TICK_MS;
+    layer->expires_tick = das4q_comp_now_tick(comp) + ticks;
+
+    das4q_comp_layer_t** slot =
+        &comp->wheel[layer->expires_tick % DAS4Q_COMP_WHEEL_SLOTS];
+    layer->wheel_next = *slot;
+    layer->wheel_prev = slot;
+    if (*slot != NULL) {
+        (*slot)->wheel_prev = &layer->wheel_next;
+    }
+    *slot = layer;
+    if (comp->nwheel++ == 0) {
+        das4q_comp_arm(comp);
+    }
+}
+
+static int das4q_comp_find(das4q_comp_t* comp, const char* name) {
+    for (int i = 0; i < comp->nlayers; i++) {
+        if (strcmp(comp->layers[i]->name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void das4q_comp_weigh(das4q_comp_layer_t* layer) {
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        uint32_t x = layer->alpha[i] * layer->opacity + 128;
+        layer->weight[i] = (x + (x >> 8)) >> 8;
+    }
+}
+
+das4q_comp_t* das4q_comp_new(das4q_handle handle) {
+    das4q_comp_t* comp = calloc(1, sizeof(das4q_comp_t));
+    if (comp == NULL) {
+        return NULL;
+    }
+    comp->fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (comp->fd < 0) {
+        free(comp);
+        return NULL;
+    }
+    comp->priv = handle;
+    clock_gettime(CLOCK_MONOTONIC, &comp->start);
+    return comp;
+}
+
+void das4q_comp_free(das4q_comp_t* comp) {
+    if (comp == NULL) {
+        return;
+    }
+    for (int i = 0; i < comp->nlayers; i++) {
+        free(comp->layers[i]);
+    }
+    close(comp->fd);
+    free(comp);
+}
+
+int das4q_comp_set_layer(das4q_comp_t* comp, const char* name, int priority,
+                         const das4q_setting_t settings[DAS4Q_NUM_KEYS],
+                         const das4q_active_setting_t
+                             active_settings[DAS4Q_NUM_KEYS],
+                         const uint8_t alpha[DAS4Q_NUM_KEYS],
+                         uint32_t ttl_ms) {
+    das4q_comp_layer_t* layer;
+    int idx;
+
+    if (name == NULL || name[0] == '\0' ||
+        strlen(name) >= DAS4Q_COMP_NAME_LEN) {
+        return -EINVAL;
+    }
+
+    idx = das4q_comp_find(comp, name);
+    if (idx >= 0) {
+        // Take it out, it goes back in wherever its priority puts it
+        layer = comp->layers[idx];
+        memmove(&comp->layers[idx], &comp->layers[idx + 1],
+                (comp->nlayers - idx - 1) * sizeof(comp->layers[0]));
+        comp->nlayers--;
+        das4q_comp_wheel_remove(comp, layer);
+    } else {
+        if (comp->nlayers >= DAS4Q_COMP_MAX_LAYERS) {
+            return -ENOSPC;
+        }
+        layer = calloc(1, sizeof(das4q_comp_layer_t));
+        if (layer == NULL) {
+            return -ENOMEM;
+        }
+        strcpy(layer->name, name);
+        layer->opacity = 255;
+    }
+
+    layer->priority = priority;
+    das4q_planes_from_frame(&layer->color, settings);
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        layer->mode[i] = settings[i].mode;
+        layer->alpha[i] = alpha != NULL ? alpha[i] : 255;
+    }
+    if (active_settings != NULL) {
+        memcpy(layer->active, active_settings, sizeof(layer->active));
+    } else {
+        memset(layer->active, 0, sizeof(layer->active));
+    }
+    das4q_comp_weigh(layer);
+
+    // Above everything of the same priority
+    idx = comp->nlayers;
+    while (idx > 0 && comp->layers[idx - 1]->priority > priority) {
+        idx--;
+    }
+    memmove(&comp->layers[idx + 1], &comp->layers[idx],
+            (comp->nlayers - idx) * sizeof(comp->layers[0]));
+    comp->layers[idx] = layer;
+    comp->nlayers++;
+
+    if (ttl_ms > 0) {
+        das4q_comp_wheel_add(comp, layer, ttl_ms);
+    }
+    return 0;
+}
+
+int das4q_comp_set_opacity(das4q_comp_t* comp, const char* name,
+                           uint8_t opacity) {
+    int idx = das4q_comp_find(comp, name);
+    if (idx < 0) {
+        return -ENOENT;
+    }
+    comp->layers[idx]->opacity = opacity;
+    das4q_comp_weigh(comp->layers[idx]);
+    return 0;
+}
+
+static void das4q_comp_drop(das4q_comp_t* comp, int idx) {
+    das4q_comp_layer_t* layer = comp->layers[idx];
+    das4q_comp_wheel_remove(comp, layer);
+    memmove(&comp->layers[idx], &comp->layers[idx + 1],
+            (comp->nlayers - idx - 1) * sizeof(comp->layers[0]));
+    comp->nlayers--;
+    free(layer);
+}
+
+int das4q_comp_remove_layer(das4q_comp_t* comp, const char* name) {
+    int idx = das4q_comp_find(comp, name);
+    if (idx < 0) {
+        return -ENOENT;
+    }
+    das4q_comp_drop(comp, idx);
+    return 0;
+}
+
+int das4q_comp_commit(das4q_comp_t* comp) {
+    static const das4q_rgb_t black = {0};
+    das4q_map_t keys[DAS4Q_NUM_KEYS];
+    int nkeys = 0;
+
+    das4q_planes_fill(&comp->out, black);
+    for (int l = 0; l < comp->nlayers; l++) {
+        das4q_planes_blend_mask(&comp->out, &comp->layers[l]->color,
+                                comp->layers[l]->weight);
+    }
+    das4q_planes_to_frame(&comp->out, comp->frame, DAS4Q_MODE_SOLID);
+    memset(comp->aframe, 0, sizeof(comp->aframe));
+
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        for (int l = comp->nlayers - 1; l >= 0; l--) {
+            const das4q_comp_layer_t* layer = comp->layers[l];
+            if (layer->weight[i] > 0) {
+                comp->frame[i].mode = layer->mode[i];
+                comp->aframe[i] = layer->active[i];
+                comp->touched[i] = true;
+                break;
+            }
+        }
+    }
+
+    // Only what's actually different from what the keyboard has
+    nkeys = das4q_diff_frame(comp->priv, comp->frame, comp->aframe, keys);
+    int n = 0;
+    for (int i = 0; i < nkeys; i++) {
+        if (comp->touched[keys[i]]) {
+            keys[n++] = keys[i];
+        }
+    }
+    if (n == 0) {
+        return 0;
+    }
+    int ret = das4q_stream_keys(comp->priv, keys, n, comp->frame,
+                                comp->aframe);
+    if (ret >= 0 && !das4q_apply_changes(comp->priv)) {
+        ret = -EIO;
+    }
+    return ret;
+}
+
+int das4q_comp_get_fd(das4q_comp_t* comp) { return comp->fd; }
+
+int das4q_comp_dispatch(das4q_comp_t* comp) {
+    uint64_t expirations;
+    int dropped = 0;
+
+    if (read(comp->fd, &expirations, sizeof(expirations)) < 0 &&
+        errno != EAGAIN) {
+        return -errno;
+    }
+
+    // Going by the clock rather than the timerfd count, so a late call
+    // still catches up.  One lap of the wheel visits every slot.
+    uint64_t now = das4q_comp_now_tick(comp);
+    uint64_t from = comp->tick + 1;
+    if (now >= DAS4Q_COMP_WHEEL_SLOTS && from < now - DAS4Q_COMP_WHEEL_SLOTS) {
+        from = now - DAS4Q_COMP_WHEEL_SLOTS + 1;
+    }
+    for (uint64_t t = from; t <= now; t++) {
+        das4q_comp_layer_t* layer = comp->wheel[t % DAS4Q_COMP_WHEEL_SLOTS];
+        while (layer != NULL) {
+            das4q_comp_layer_t* next = layer->wheel_next;
+            if (layer->expires_tick <= now) {
+                das4q_comp_drop(comp, das4q_comp_find(comp, layer->name));
+                dropped++;
+            }
+            layer = next;
+        }
+    }
+    if (now > comp->tick) {
+        comp->tick = now;
+    }
+
+    if (dropped > 0) {
+        int ret = das4q_comp_commit(comp);
+        if (ret < 0) {
+            return ret;
+        }
+    }
+    return dropped;
+}
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "das4q_priv.h"
+#include "libdas4q.h"
+
+/*
+ * Pre-encoded key commands.
+ *
+ * priv->encoded holds both commands for every key exactly as they go out,
+ * checksums and all, so a frame is sent straight out of it.  Updating a
+ * key only rewrites its mode, color and unk bytes.  The checksum is the
+ * XOR of every other byte, so each rewritten byte is patched into it by
+ * XORing the old value out and the new one in, without going over the
+ * command again.
+ */
+
+// Where a byte of the set and active commands sits in a key's commands
+#define DAS4Q_SET_AT(field) offsetof(das4q_set_cmd_t, field)
+#define DAS4Q_ACTIVE_AT(field) \
+    (sizeof(das4q_set_cmd_t) + offsetof(das4q_active_cmd_t, field))
+
+// What the firmware wants in unk for each active mode, zero for the rest.
+// Used when the caller leaves unk zeroed.
+static const uint8_t das4q_unk[256][3] = {
+    [DAS4Q_ACTIVE_MODE_BREATHE] = {0x03, 0xe8, 0x03},
+    [DAS4Q_ACTIVE_MODE_CYCLE] = {0x13, 0x88, 0x00},
+    [DAS4Q_ACTIVE_MODE_SOLID] = {0x07, 0xd0, 0x00},
+    [DAS4Q_ACTIVE_MODE_BLINK] = {0x01, 0xf4, 0x03},
+};
+
+const uint8_t* das4q_active_unk(const das4q_active_setting_t* active) {
+    if (active->unk[0] | active->unk[1] | active->unk[2]) {
+        return active->unk;
+    }
+    return das4q_unk[(uint8_t)active->mode];
+}
+
+static inline void das4q_patch(uint8_t* cmds, size_t csum, size_t at,
+                               uint8_t value) {
+    cmds[csum] ^= cmds[at] ^ value;
+    cmds[at] = value;
+}
+
+void das4q_encode_init(das4q_priv_t* priv) {
+    for (int key = 0; key < DAS4Q_NUM_KEYS; key++) {
+        das4q_set_cmd_t cmd1;
+        das4q_active_cmd_t cmd2;
+        das4q_build_key_cmds(key, (das4q_setting_t){0},
+                             (das4q_active_setting_t){0}, &cmd1, &cmd2);
+        memcpy(priv->encoded[key], &cmd1, sizeof(cmd1));
+        memcpy(priv->encoded[key] + sizeof(cmd1), &cmd2, sizeof(cmd2));
+    }
+}
+
+uint8_t* das4q_encode_key(das4q_priv_t* priv, das4q_map_t key,
+                          das4q_setting_t setting,
+                          das4q_active_setting_t active_setting) {
+    const size_t set_csum = DAS4Q_SET_AT(csum);
+    const size_t active_csum = DAS4Q_ACTIVE_AT(csum);
+    const uint8_t* unk = das4q_active_unk(&active_setting);
+    uint8_t* cmds = priv->encoded[key];
+
+    das4q_patch(cmds, set_csum, DAS4Q_SET_AT(mode), setting.mode);
+    das4q_patch(cmds, set_csum, DAS4Q_SET_AT(red), setting.red);
+    das4q_patch(cmds, set_csum, DAS4Q_SET_AT(green), setting.green);
+    das4q_patch(cmds, set_csum, DAS4Q_SET_AT(blue), setting.blue);
+
+    das4q_patch(cmds, active_csum, DAS4Q_ACTIVE_AT(mode),
+                active_setting.mode);
+    das4q_patch(cmds, active_csum, DAS4Q_ACTIVE_AT(red), active_setting.red);
+    das4q_patch(cmds, active_csum, DAS4Q_ACTIVE_AT(green),
+                active_setting.green);
+    das4q_patch(cmds, active_csum, DAS4Q_ACTIVE_AT(blue),
+                active_setting.blue);
+    for (int i = 0; i < 3; i++) {
+        das4q_patch(cmds, active_csum, DAS4Q_ACTIVE_AT(unk) + i, unk[i]);
+    }
+    return cmds;
+}
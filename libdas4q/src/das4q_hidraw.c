@@ -0,0 +1,189 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <limits.h>
+#include <linux/hidraw.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+#include "das4q_priv.h"
+#include "das4q_transport.h"
+
+/*
+ * Talks to the keyboard through a /dev/hidrawN node with the feature
+ * report ioctls.  No libusb context, no bus scan and no kernel driver
+ * detach, udev can hand over the exact node.
+ */
+
+typedef struct das4q_hidraw {
+    int fd;
+} das4q_hidraw_t;
+
+static int das4q_hidraw_set_report(void* ctx, const uint8_t* buff, int len) {
+    das4q_hidraw_t* hidraw = ctx;
+    int ret = ioctl(hidraw->fd, HIDIOCSFEATURE(len), buff);
+    if (ret < 0) {
+        ret = -errno;
+        DAS4Q_DEBUG("HIDIOCSFEATURE: %s", strerror(-ret));
+    }
+    return ret;
+}
+
+static int das4q_hidraw_get_report(void* ctx, uint8_t* buff, int len) {
+    das4q_hidraw_t* hidraw = ctx;
+
+    // The report ID goes in, the report comes back in its place, same as
+    // libusb hands back.
+    buff[0] = 0x01;
+    int ret = ioctl(hidraw->fd, HIDIOCGFEATURE(len), buff);
+    if (ret < 0) {
+        ret = -errno;
+        DAS4Q_DEBUG("HIDIOCGFEATURE: %s", strerror(-ret));
+    }
+    return ret;
+}
+
+static void das4q_hidraw_close(void* ctx) {
+    das4q_hidraw_t* hidraw = ctx;
+    close(hidraw->fd);
+    free(hidraw);
+}
+
+static const das4q_transport_t das4q_hidraw_transport = {
+    .name = "hidraw",
+    .set_report = das4q_hidraw_set_report,
+    .get_report = das4q_hidraw_get_report,
+    .close = das4q_hidraw_close,
+};
+
+/*
+ * The keyboard has several HID interfaces, only the one with feature
+ * report 1 takes lighting commands.  Walks the short items of the report
+ * descriptor looking for a Report ID 1 followed by a Feature item.
+ */
+static bool das4q_hidraw_has_feature_report(int fd) {
+    struct hidraw_report_descriptor desc = {0};
+    bool report_1 = false;
+
+    if (ioctl(fd, HIDIOCGRDESCSIZE, &desc.size) < 0 ||
+        ioctl(fd, HIDIOCGRDESC, &desc) < 0) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < desc.size;) {
+        uint8_t prefix = desc.value[i];
+        uint32_t size = prefix & 0x03;
+        if (size == 3) {
+            size = 4;
+        }
+        if (prefix == 0xfe) {
+            // Long item, skip the lot
+            if (i + 1 >= desc.size) {
+                break;
+            }
+            i += 3 + desc.value[i + 1];
+            continue;
+        }
+        if (i + size >= desc.size) {
+            break;
+        }
+
+        switch (prefix & 0xfc) {
+            case 0x84:  // Report ID
+                report_1 = size > 0 && desc.value[i + 1] == 0x01;
+                break;
+            case 0xb0:  // Feature
+                if (report_1) {
+                    return true;
+                }
+                break;
+        }
+        i += 1 + size;
+    }
+    return false;
+}
+
+/*
+ * Finds the USB device behind a hidraw node.  Its sysfs device is the HID
+ * device, under the interface, under the USB device whose name is the
+ * port, e.g. .../3-2/3-2:1.1/0003:24F0:2037.0005.
+ */
+static void das4q_hidraw_locate(int fd, das4q_usb_location_t* location) {
+    struct stat st;
+    char path[PATH_MAX];
+    char real[PATH_MAX];
+
+    memset(location, 0, sizeof(*location));
+    if (fstat(fd, &st) < 0) {
+        return;
+    }
+    snprintf(path, sizeof(path), "/sys/dev/char/%u:%u/device/../..",
+             major(st.st_rdev), minor(st.st_rdev));
+    if (realpath(path, real) == NULL ||
+        !das4q_usb_location_parse(basename(real), location)) {
+        DAS4Q_DEBUG("No USB device behind hidraw %u:%u", major(st.st_rdev),
+                    minor(st.st_rdev));
+    }
+}
+
+int das4q_hidraw_open(const char* path, const das4q_transport_t** transport,
+                      void** ctx, das4q_usb_location_t* location) {
+    struct hidraw_devinfo info;
+
+    int fd = open(path, O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        int ret = -errno;
+        DAS4Q_ERROR("Failed to open %s: %s", path, strerror(-ret));
+        return ret;
+    }
+
+    if (ioctl(fd, HIDIOCGRAWINFO, &info) < 0) {
+        int ret = -errno;
+        DAS4Q_ERROR("%s is not a hidraw node: %s", path, strerror(-ret));
+        close(fd);
+        return ret;
+    }
+    if ((uint16_t)info.vendor != 0x24f0 || (uint16_t)info.product != 0x2037) {
+        DAS4Q_ERROR("%s is %04x:%04x, not a DAS 4Q", path,
+                    (uint16_t)info.vendor, (uint16_t)info.product);
+        close(fd);
+        return -ENODEV;
+    }
+    if (!das4q_hidraw_has_feature_report(fd)) {
+        DAS4Q_ERROR("%s isn't the lighting interface", path);
+        close(fd);
+        return -ENODEV;
+    }
+
+    das4q_hidraw_t* hidraw = calloc(1, sizeof(das4q_hidraw_t));
+    if (hidraw == NULL) {
+        close(fd);
+        return -ENOMEM;
+    }
+    hidraw->fd = fd;
+    das4q_hidraw_locate(fd, location);
+
+    *transport = &das4q_hidraw_transport;
+    *ctx = hidraw;
+    return 0;
+}
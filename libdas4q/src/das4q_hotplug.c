@@ -0,0 +1,214 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <errno.h>
+#include <libusb-1.0/libusb.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "das4q_priv.h"
+#include "libdas4q.h"
+
+/*
+ * Replug handling.
+ *
+ * libusb calls das4q_hotplug_event from inside its event handling, where
+ * the docs say not to do any I/O on the device.  So the event is only
+ * noted down, and das4q_hotplug_process does the actual work on the way
+ * out of das4q_handle_events.
+ */
+
+typedef struct das4q_hotplug {
+    das4q_priv_t* priv;
+    libusb_hotplug_callback_handle cb_handle;
+    das4q_hotplug_cb cb;
+    void* user_data;
+
+    // Set by the libusb callback, cleared once handled
+    libusb_device* arrived;
+    struct timespec arrived_at;
+    bool left;
+} das4q_hotplug_t;
+
+static uint64_t das4q_elapsed_us(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - start->tv_sec) * 1000000 +
+           (now.tv_nsec - start->tv_nsec) / 1000;
+}
+
+static int LIBUSB_CALL das4q_hotplug_event(libusb_context* ctx,
+                                           libusb_device* dev,
+                                           libusb_hotplug_event event,
+                                           void* user_data) {
+    das4q_hotplug_t* hotplug = user_data;
+    (void)ctx;
+
+    if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED) {
+        if (hotplug->arrived != NULL) {
+            libusb_unref_device(hotplug->arrived);
+        }
+        hotplug->arrived = libusb_ref_device(dev);
+        clock_gettime(CLOCK_MONOTONIC, &hotplug->arrived_at);
+    } else if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT) {
+        // Every 4Q comes through here, only this handle's own counts
+        das4q_priv_t* priv = hotplug->priv;
+        if (priv->handle != NULL && dev == libusb_get_device(priv->handle)) {
+            hotplug->left = true;
+        }
+    }
+    // Keep the callback registered
+    return 0;
+}
+
+static void das4q_hotplug_left(das4q_priv_t* priv) {
+    das4q_hotplug_t* hotplug = priv->hotplug;
+
+    hotplug->left = false;
+    if (priv->handle == NULL) {
+        return;
+    }
+
+    // Whatever was queued isn't getting through now
+    das4q_async_close(priv);
+    libusb_close(priv->handle);
+    priv->handle = NULL;
+    das4q_invalidate_frame(priv);
+
+    DAS4Q_INFO("Keyboard unplugged");
+    if (hotplug->cb != NULL) {
+        hotplug->cb(priv, false, 0, hotplug->user_data);
+    }
+}
+
+static void das4q_hotplug_arrived(das4q_priv_t* priv) {
+    das4q_hotplug_t* hotplug = priv->hotplug;
+    libusb_device* dev = hotplug->arrived;
+
+    hotplug->arrived = NULL;
+    if (priv->handle != NULL) {
+        // Already have one, this is a second keyboard
+        libusb_unref_device(dev);
+        return;
+    }
+
+    das4q_usb_location_t location;
+    das4q_usb_locate(dev, &location);
+    if (priv->pinned && !das4q_usb_location_equal(&location, &priv->location)) {
+        // Another keyboard's handle will pick this one up
+        libusb_unref_device(dev);
+        return;
+    }
+
+    int ret = libusb_open(dev, &priv->handle);
+    libusb_unref_device(dev);
+    if (ret < 0) {
+        DAS4Q_ERROR("Failed to reopen keyboard: %s", libusb_error_name(ret));
+        priv->handle = NULL;
+        return;
+    }
+    if (!das4q_usb_claim(priv->handle)) {
+        libusb_close(priv->handle);
+        priv->handle = NULL;
+        return;
+    }
+    priv->location = location;
+
+    das4q_start_device(priv);
+    if (das4q_replay_frame(priv) < 0) {
+        DAS4Q_WARN("Some keys failed to replay");
+    }
+
+    uint64_t us = das4q_elapsed_us(&hotplug->arrived_at);
+    DAS4Q_INFO("Keyboard back, lights restored in %llu.%03llu ms",
+               (unsigned long long)(us / 1000),
+               (unsigned long long)(us % 1000));
+    if (hotplug->cb != NULL) {
+        hotplug->cb(priv, true, us, hotplug->user_data);
+    }
+}
+
+void das4q_hotplug_process(das4q_priv_t* priv) {
+    das4q_hotplug_t* hotplug = priv->hotplug;
+    if (hotplug == NULL) {
+        return;
+    }
+
+    // A quick unplug and replug can land in one go, so the old handle goes
+    // first.
+    if (hotplug->left) {
+        das4q_hotplug_left(priv);
+    }
+    if (hotplug->arrived != NULL) {
+        das4q_hotplug_arrived(priv);
+    }
+}
+
+int das4q_enable_hotplug(das4q_handle handle, das4q_hotplug_cb cb,
+                         void* user_data) {
+    das4q_priv_t* priv = handle;
+
+    if (priv->ctx == NULL ||
+        !libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG)) {
+        return -ENOTSUP;
+    }
+    if (priv->hotplug != NULL) {
+        priv->hotplug->cb = cb;
+        priv->hotplug->user_data = user_data;
+        return 0;
+    }
+
+    das4q_hotplug_t* hotplug = calloc(1, sizeof(das4q_hotplug_t));
+    if (hotplug == NULL) {
+        return -ENOMEM;
+    }
+    hotplug->priv = priv;
+    hotplug->cb = cb;
+    hotplug->user_data = user_data;
+
+    int ret = libusb_hotplug_register_callback(
+        priv->ctx,
+        LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED | LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT,
+        0, 0x24f0, 0x2037, LIBUSB_HOTPLUG_MATCH_ANY, das4q_hotplug_event,
+        hotplug, &hotplug->cb_handle);
+    if (ret != LIBUSB_SUCCESS) {
+        DAS4Q_ERROR("Failed to register hotplug callback: %s",
+                    libusb_error_name(ret));
+        free(hotplug);
+        return -EIO;
+    }
+    priv->hotplug = hotplug;
+    return 0;
+}
+
+bool das4q_is_connected(das4q_handle handle) {
+    das4q_priv_t* priv = handle;
+    // Other transports don't know, and have to be assumed present
+    return priv->ctx == NULL || priv->handle != NULL;
+}
+
+void das4q_hotplug_close(das4q_priv_t* priv) {
+    das4q_hotplug_t* hotplug = priv->hotplug;
+    if (hotplug == NULL) {
+        return;
+    }
+
+    libusb_hotplug_deregister_callback(priv->ctx, hotplug->cb_handle);
+    if (hotplug->arrived != NULL) {
+        libusb_unref_device(hotplug->arrived);
+    }
+    free(hotplug);
+    priv->hotplug = NULL;
+}
@@ -0,0 +1,247 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+#include "das4q_priv.h"
+#include "libdas4q.h"
+
+/*
+ * Cache of keyboards that have passed the version check.
+ *
+ * One line per USB port: the port's sysfs name, the keyboard's serial and
+ * the firmware version it reported, e.g.
+ *
+ *   3-2.1 A1B2C3 S2716V21/S2749V31m
+ *
+ * Both the port and the serial come from sysfs, which the kernel filled in
+ * at enumeration, so looking a keyboard up costs no transfers at all.  A
+ * different keyboard in the same port has a different serial and gets
+ * checked again.  The file is flocked so udev starting several das_udevs
+ * at once can't lose lines.
+ */
+
+// Lines kept in the cache, more than anyone has keyboards
+#define DAS4Q_IDENTITY_MAX 64
+#define DAS4Q_IDENTITY_LINE 160
+
+static pthread_mutex_t das4q_identity_lock = PTHREAD_MUTEX_INITIALIZER;
+static char das4q_identity_path[PATH_MAX] = DAS4Q_IDENTITY_CACHE;
+static bool das4q_identity_enabled = true;
+
+void das4q_set_identity_cache(const char* path) {
+    pthread_mutex_lock(&das4q_identity_lock);
+    das4q_identity_enabled = path != NULL;
+    if (path != NULL) {
+        snprintf(das4q_identity_path, sizeof(das4q_identity_path), "%s",
+                 path);
+    }
+    pthread_mutex_unlock(&das4q_identity_lock);
+}
+
+bool das4q_usb_location_name(const das4q_usb_location_t* location,
+                             char* name, size_t len) {
+    if (location->bus == 0 || location->nports == 0) {
+        return false;
+    }
+    int pos = snprintf(name, len, "%u", location->bus);
+    for (int i = 0; i < location->nports && pos > 0 && (size_t)pos < len;
+         i++) {
+        pos += snprintf(name + pos, len - pos, "%c%u", i == 0 ? '-' : '.',
+                        location->ports[i]);
+    }
+    return pos > 0 && (size_t)pos < len;
+}
+
+bool das4q_usb_location_parse(const char* name,
+                              das4q_usb_location_t* location) {
+    char* end;
+
+    memset(location, 0, sizeof(*location));
+    unsigned long bus = strtoul(name, &end, 10);
+    if (end == name || *end != '-' || bus == 0 || bus > 0xff) {
+        return false;
+    }
+    location->bus = bus;
+    while (*end == '-' || *end == '.') {
+        const char* start = end + 1;
+        unsigned long port = strtoul(start, &end, 10);
+        if (end == start || port > 0xff ||
+            location->nports >= sizeof(location->ports)) {
+            return false;
+        }
+        location->ports[location->nports++] = port;
+    }
+    // Interfaces carry on with ":config.interface", that's not a device
+    return *end == '\0' && location->nports > 0;
+}
+
+/*
+ * The cache key for a keyboard: its port, and its serial out of sysfs, or
+ * "-" if it has none.
+ */
+static bool das4q_identity_key(das4q_priv_t* priv, char* name,
+                               size_t name_len, char* serial,
+                               size_t serial_len) {
+    char path[PATH_MAX];
+
+    if (!das4q_usb_location_name(&priv->location, name, name_len)) {
+        return false;
+    }
+    snprintf(serial, serial_len, "-");
+    snprintf(path, sizeof(path), "/sys/bus/usb/devices/%s/serial", name);
+    FILE* file = fopen(path, "re");
+    if (file == NULL) {
+        return true;
+    }
+    if (fgets(serial, serial_len, file) == NULL) {
+        snprintf(serial, serial_len, "-");
+    }
+    fclose(file);
+
+    // One word, so it can't throw the line's fields out
+    for (char* c = serial; *c != '\0'; c++) {
+        if (*c == '\n') {
+            *c = '\0';
+            break;
+        }
+        if (*c <= ' ' || *c > '~') {
+            *c = '_';
+        }
+    }
+    if (serial[0] == '\0') {
+        snprintf(serial, serial_len, "-");
+    }
+    return true;
+}
+
+// Opens the cache with the lock taken.  returns: NULL if caching is off.
+static FILE* das4q_identity_open(bool write) {
+    FILE* file = NULL;
+
+    pthread_mutex_lock(&das4q_identity_lock);
+    if (das4q_identity_enabled) {
+        int fd = write ? open(das4q_identity_path,
+                              O_RDWR | O_CREAT | O_CLOEXEC, 0644)
+                       : open(das4q_identity_path, O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            file = fdopen(fd, write ? "r+" : "r");
+            if (file == NULL) {
+                close(fd);
+            }
+        } else if (write || errno != ENOENT) {
+            DAS4Q_DEBUG("Can't open %s: %s", das4q_identity_path,
+                        strerror(errno));
+        }
+    }
+    pthread_mutex_unlock(&das4q_identity_lock);
+
+    if (file != NULL && flock(fileno(file), write ? LOCK_EX : LOCK_SH) < 0) {
+        fclose(file);
+        return NULL;
+    }
+    return file;
+}
+
+bool das4q_identity_cached(das4q_priv_t* priv) {
+    char name[32];
+    char serial[64];
+    char line[DAS4Q_IDENTITY_LINE];
+    bool found = false;
+
+    if (!das4q_identity_key(priv, name, sizeof(name), serial,
+                            sizeof(serial))) {
+        return false;
+    }
+    FILE* file = das4q_identity_open(false);
+    if (file == NULL) {
+        return false;
+    }
+    while (!found && fgets(line, sizeof(line), file) != NULL) {
+        char line_name[32];
+        char line_serial[64];
+        char line_version[64];
+        if (sscanf(line, "%31s %63s %63s", line_name, line_serial,
+                   line_version) == 3 &&
+            strcmp(line_name, name) == 0 &&
+            strcmp(line_serial, serial) == 0 &&
+            strcmp(line_version, DAS4Q_FIRMWARE_VERSION) == 0) {
+            found = true;
+        }
+    }
+    fclose(file);
+
+    if (found) {
+        DAS4Q_INFO("Version %s, cached for %s", DAS4Q_FIRMWARE_VERSION,
+                   name);
+    }
+    return found;
+}
+
+void das4q_identity_store(das4q_priv_t* priv) {
+    char name[32];
+    char serial[64];
+    char(*lines)[DAS4Q_IDENTITY_LINE];
+    int nlines = 0;
+
+    if (!das4q_identity_key(priv, name, sizeof(name), serial,
+                            sizeof(serial))) {
+        return;
+    }
+    lines = malloc(DAS4Q_IDENTITY_MAX * sizeof(*lines));
+    if (lines == NULL) {
+        return;
+    }
+    FILE* file = das4q_identity_open(true);
+    if (file == NULL) {
+        goto cleanup;
+    }
+
+    // Everything but this port's old line, dropping the oldest if full
+    size_t name_len = strlen(name);
+    while (fgets(lines[nlines], DAS4Q_IDENTITY_LINE, file) != NULL) {
+        char* line = lines[nlines];
+        if (strchr(line, '\n') == NULL ||
+            (strncmp(line, name, name_len) == 0 && line[name_len] == ' ')) {
+            continue;
+        }
+        if (++nlines == DAS4Q_IDENTITY_MAX) {
+            nlines--;
+            memmove(lines, lines + 1, nlines * sizeof(*lines));
+        }
+    }
+    rewind(file);
+    if (ftruncate(fileno(file), 0) < 0) {
+        goto cleanup;
+    }
+    for (int i = 0; i < nlines; i++) {
+        fputs(lines[i], file);
+    }
+    fprintf(file, "%s %s %s\n", name, serial, DAS4Q_FIRMWARE_VERSION);
+
+cleanup:
+    if (file != NULL) {
+        fclose(file);
+    }
+    free(lines);
+}
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libdas4q.h"
+
+typedef struct das4q_keyname {
+    const char* name;
+    das4q_map_t key;
+} das4q_keyname_t;
+
+#include "das4q_keynames.h"
+
+// FNV-1a, with the seed mixed into the offset basis.  gen_keynames.py has
+// to agree.
+static uint32_t das4q_keyname_hash(const char* name, uint32_t seed) {
+    uint32_t h = 0x811c9dc5 ^ seed;
+    for (; *name; name++) {
+        h ^= (uint8_t)*name;
+        h *= 0x01000193;
+    }
+    return h;
+}
+
+bool das4q_key_from_name(const char* name, das4q_map_t* key) {
+    uint32_t bucket = das4q_keyname_hash(name, 0) % DAS4Q_KEYNAME_BUCKETS;
+    uint32_t slot = das4q_keyname_hash(name, das4q_keyname_seeds[bucket]) %
+                    DAS4Q_KEYNAME_SLOTS;
+    const das4q_keyname_t* entry = &das4q_keyname_slots[slot];
+
+    if (entry->name == NULL || strcmp(entry->name, name) != 0) {
+        return false;
+    }
+    *key = entry->key;
+    return true;
+}
+
+const char* das4q_key_name(das4q_map_t key) {
+    if (key >= DAS4Q_NUM_KEYS) {
+        return NULL;
+    }
+    return das4q_key_names[key];
+}
@@ -0,0 +1,262 @@
+// Generated by scripts/gen_keynames.py from keymap.h.  Don't edit,
+// rerun the script when keymap.h changes.
+
+#ifndef DAS4Q_KEYNAMES_H
+#define DAS4Q_KEYNAMES_H
+
+#define DAS4Q_KEYNAME_BUCKETS 54
+#define DAS4Q_KEYNAME_SLOTS 128
+
+static const uint16_t das4q_keyname_seeds[DAS4Q_KEYNAME_BUCKETS] = {
+    7, 1, 1, 1, 4, 17, 1, 1,
+    2, 2, 3, 1, 2, 5, 22, 2,
+    1, 27, 1, 9, 1, 3, 1, 0,
+    10, 3, 6, 1, 11, 0, 5, 1,
+    1, 1, 4, 0, 7, 14, 0, 0,
+    6, 6, 5, 6, 14, 2, 14, 4,
+    0, 5, 0, 8, 1, 5,
+};
+
+static const das4q_keyname_t das4q_keyname_slots[DAS4Q_KEYNAME_SLOTS] = {
+    {"KEY_T", 0x21},
+    {"KET_L_CTRL", 0x00},
+    {"KEY_R_ALT", 0x3c},
+    {"KEY_N", 0x2b},
+    {"KEY_8", 0x34},
+    {"KEY_S", 0x0e},
+    {"KEY_R_SUPER", 0x42},
+    {NULL, 0},
+    {"KEY_L_SUPER", 0x06},
+    {NULL, 0},
+    {"KEY_Z", 0x0d},
+    {"KEY_F2", 0x17},
+    {"KEY_R_SHIFT", 0x4f},
+    {"KEY_NUM_PERIOD", 0x72},
+    {"KEY_F12", 0x53},
+    {"KEY_F10", 0x47},
+    {"KEY_NUM_1", 0x67},
+    {"KEY_NUM_PLUS", 0x7b},
+    {"KEY_F", 0x1a},
+    {"KEY_U", 0x2d},
+    {"KEY_O", 0x39},
+    {"KEY_F8", 0x3b},
+    {NULL, 0},
+    {"KEY_9", 0x3a},
+    {"KEY_BACKLIGHT_CTRL", 0x7f},
+    {"KEY_NUM_9", 0x75},
+    {NULL, 0},
+    {"KEY_INSERT", 0x58},
+    {"KEY_PAGE_UP", 0x64},
+    {"KEY_APOSTROPHE", 0x44},
+    {"KEY_5", 0x22},
+    {"KEY_ARROW_LEFT", 0x54},
+    {"KEY_NUM_6", 0x74},
+    {NULL, 0},
+    {"KEY_P", 0x3f},
+    {"KEY_NUM_0", 0x66},
+    {"KEY_Y", 0x27},
+    {NULL, 0},
+    {"KEY_TILDE", 0x04},
+    {"KEY_F4", 0x23},
+    {"KEY_3", 0x16},
+    {"KEY_D", 0x14},
+    {NULL, 0},
+    {"KEY_BACKSPACE", 0x52},
+    {"KEY_L_ALT", 0x0c},
+    {"KEY_DASH_UNDERSCORE", 0x46},
+    {"KEY_M", 0x31},
+    {NULL, 0},
+    {"KEY_F9", 0x41},
+    {NULL, 0},
+    {"KEY_Q", 0x09},
+    {"KEY_ARROW_UP", 0x5b},
+    {"KEY_PAGE_DOWN", 0x63},
+    {NULL, 0},
+    {"KEY_F1", 0x11},
+    {"KEY_R", 0x1b},
+    {"KEY_H", 0x26},
+    {"KEY_W", 0x0f},
+    {"KEY_J", 0x2c},
+    {"KEY_F6", 0x2f},
+    {NULL, 0},
+    {"KEY_R_CTRL", 0x4e},
+    {"KEY_MEDIA_PLAY_PAUSE", 0x80},
+    {"KEY_NUM_SLASH", 0x70},
+    {"KEY_HOME", 0x5e},
+    {"KEY_NUM_ENTER", 0x7a},
+    {"KEY_L_CTRL", 0x00},
+    {"KEY_E", 0x15},
+    {"KEY_ARROW_RIGHT", 0x60},
+    {NULL, 0},
+    {"KEY_1", 0x0a},
+    {"KEY_NUM_2", 0x6d},
+    {"KEY_L", 0x38},
+    {"KEY_CAPSLOCK", 0x02},
+    {"KEY_PERIOD", 0x3d},
+    {"KEY_SPACE", 0x24},
+    {"KEY_B", 0x25},
+    {"KEY_F7", 0x35},
+    {"KEY_F5", 0x29},
+    {NULL, 0},
+    {"KEY_L_BRACKET", 0x45},
+    {"KEY_X", 0x13},
+    {"KEY_I", 0x33},
+    {"KEY_EQUALS_PLUS", 0x4c},
+    {"KEY_C", 0x19},
+    {"KEY_V", 0x1f},
+    {NULL, 0},
+    {"KEY_SLEEP", 0x7e},
+    {"KEY_NUM_3", 0x73},
+    {"KEY_7", 0x2e},
+    {"KEY_META", 0x48},
+    {"KEY_NUM_MINUS", 0x7c},
+    {"KEY_NUM_5", 0x6e},
+    {"KEY_SEMICOLON", 0x3e},
+    {NULL, 0},
+    {"KEY_DELETE", 0x57},
+    {"KEY_PRINT_SCR", 0x59},
+    {"KEY_NUM_8", 0x6f},
+    {"KEY_2", 0x10},
+    {NULL, 0},
+    {NULL, 0},
+    {"KEY_COMMA", 0x37},
+    {"KEY_ARROW_DOWN", 0x5a},
+    {"KEY_ESCAPE", 0x05},
+    {"KEY_SCROLL_LOCK", 0x5f},
+    {"KEY_G", 0x20},
+    {NULL, 0},
+    {"KEY_NUMLOCK", 0x6a},
+    {"KEY_MEDIA_NEXT_TRACK", 0x81},
+    {"KEY_SLASH", 0x43},
+    {"KEY_NUM_7", 0x69},
+    {"KEY_NUM_4", 0x68},
+    {"KEY_BACKSLASH", 0x51},
+    {"KEY_K", 0x32},
+    {"KEY_ENTER", 0x50},
+    {"KEY_6", 0x28},
+    {"KEY_R_BRACKET", 0x4b},
+    {NULL, 0},
+    {"KEY_4", 0x1c},
+    {"KEY_L_SHIFT", 0x01},
+    {"KEY_F11", 0x4d},
+    {"KEY_NUM_STAR", 0x76},
+    {"KEY_END", 0x5d},
+    {"KEY_PAUSE", 0x65},
+    {"KEY_TAB", 0x03},
+    {"KEY_0", 0x40},
+    {"KEY_A", 0x08},
+    {"KEY_F3", 0x1d},
+};
+
+static const char* const das4q_key_names[DAS4Q_NUM_KEYS] = {
+    [0x00] = "KET_L_CTRL",
+    [0x01] = "KEY_L_SHIFT",
+    [0x02] = "KEY_CAPSLOCK",
+    [0x03] = "KEY_TAB",
+    [0x04] = "KEY_TILDE",
+    [0x05] = "KEY_ESCAPE",
+    [0x06] = "KEY_L_SUPER",
+    [0x08] = "KEY_A",
+    [0x09] = "KEY_Q",
+    [0x0a] = "KEY_1",
+    [0x0c] = "KEY_L_ALT",
+    [0x0d] = "KEY_Z",
+    [0x0e] = "KEY_S",
+    [0x0f] = "KEY_W",
+    [0x10] = "KEY_2",
+    [0x11] = "KEY_F1",
+    [0x13] = "KEY_X",
+    [0x14] = "KEY_D",
+    [0x15] = "KEY_E",
+    [0x16] = "KEY_3",
+    [0x17] = "KEY_F2",
+    [0x19] = "KEY_C",
+    [0x1a] = "KEY_F",
+    [0x1b] = "KEY_R",
+    [0x1c] = "KEY_4",
+    [0x1d] = "KEY_F3",
+    [0x1f] = "KEY_V",
+    [0x20] = "KEY_G",
+    [0x21] = "KEY_T",
+    [0x22] = "KEY_5",
+    [0x23] = "KEY_F4",
+    [0x24] = "KEY_SPACE",
+    [0x25] = "KEY_B",
+    [0x26] = "KEY_H",
+    [0x27] = "KEY_Y",
+    [0x28] = "KEY_6",
+    [0x29] = "KEY_F5",
+    [0x2b] = "KEY_N",
+    [0x2c] = "KEY_J",
+    [0x2d] = "KEY_U",
+    [0x2e] = "KEY_7",
+    [0x2f] = "KEY_F6",
+    [0x31] = "KEY_M",
+    [0x32] = "KEY_K",
+    [0x33] = "KEY_I",
+    [0x34] = "KEY_8",
+    [0x35] = "KEY_F7",
+    [0x37] = "KEY_COMMA",
+    [0x38] = "KEY_L",
+    [0x39] = "KEY_O",
+    [0x3a] = "KEY_9",
+    [0x3b] = "KEY_F8",
+    [0x3c] = "KEY_R_ALT",
+    [0x3d] = "KEY_PERIOD",
+    [0x3e] = "KEY_SEMICOLON",
+    [0x3f] = "KEY_P",
+    [0x40] = "KEY_0",
+    [0x41] = "KEY_F9",
+    [0x42] = "KEY_R_SUPER",
+    [0x43] = "KEY_SLASH",
+    [0x44] = "KEY_APOSTROPHE",
+    [0x45] = "KEY_L_BRACKET",
+    [0x46] = "KEY_DASH_UNDERSCORE",
+    [0x47] = "KEY_F10",
+    [0x48] = "KEY_META",
+    [0x4b] = "KEY_R_BRACKET",
+    [0x4c] = "KEY_EQUALS_PLUS",
+    [0x4d] = "KEY_F11",
+    [0x4e] = "KEY_R_CTRL",
+    [0x4f] = "KEY_R_SHIFT",
+    [0x50] = "KEY_ENTER",
+    [0x51] = "KEY_BACKSLASH",
+    [0x52] = "KEY_BACKSPACE",
+    [0x53] = "KEY_F12",
+    [0x54] = "KEY_ARROW_LEFT",
+    [0x57] = "KEY_DELETE",
+    [0x58] = "KEY_INSERT",
+    [0x59] = "KEY_PRINT_SCR",
+    [0x5a] = "KEY_ARROW_DOWN",
+    [0x5b] = "KEY_ARROW_UP",
+    [0x5d] = "KEY_END",
+    [0x5e] = "KEY_HOME",
+    [0x5f] = "KEY_SCROLL_LOCK",
+    [0x60] = "KEY_ARROW_RIGHT",
+    [0x63] = "KEY_PAGE_DOWN",
+    [0x64] = "KEY_PAGE_UP",
+    [0x65] = "KEY_PAUSE",
+    [0x66] = "KEY_NUM_0",
+    [0x67] = "KEY_NUM_1",
+    [0x68] = "KEY_NUM_4",
+    [0x69] = "KEY_NUM_7",
+    [0x6a] = "KEY_NUMLOCK",
+    [0x6d] = "KEY_NUM_2",
+    [0x6e] = "KEY_NUM_5",
+    [0x6f] = "KEY_NUM_8",
+    [0x70] = "KEY_NUM_SLASH",
+    [0x72] = "KEY_NUM_PERIOD",
+    [0x73] = "KEY_NUM_3",
+    [0x74] = "KEY_NUM_6",
+    [0x75] = "KEY_NUM_9",
+    [0x76] = "KEY_NUM_STAR",
+    [0x7a] = "KEY_NUM_ENTER",
+    [0x7b] = "KEY_NUM_PLUS",
+    [0x7c] = "KEY_NUM_MINUS",
+    [0x7e] = "KEY_SLEEP",
+    [0x7f] = "KEY_BACKLIGHT_CTRL",
+    [0x80] = "KEY_MEDIA_PLAY_PAUSE",
+    [0x81] = "KEY_MEDIA_NEXT_TRACK",
+};
+
+#endif  // DAS4Q_KEYNAMES_H
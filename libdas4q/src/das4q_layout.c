@@ -0,0 +1,51 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "das4q_layout.h"
+
+#include <stddef.h>
+
+#include "das4q_layout_table.h"
+
+const das4q_key_geometry_t* das4q_key_geometry(das4q_map_t key) {
+    if (key >= DAS4Q_NUM_KEYS || das4q_layout_keys[key].w == 0) {
+        return NULL;
+    }
+    return &das4q_layout_keys[key];
+}
+
+int das4q_key_neighbours(das4q_map_t key, const das4q_map_t** neighbours) {
+    if (key >= DAS4Q_NUM_KEYS) {
+        *neighbours = NULL;
+        return 0;
+    }
+    *neighbours = &das4q_layout_neighbours[das4q_layout_neighbour_start[key]];
+    return das4q_layout_neighbour_start[key + 1] -
+           das4q_layout_neighbour_start[key];
+}
+
+uint8_t das4q_key_distance(das4q_map_t a, das4q_map_t b) {
+    if (a >= DAS4Q_NUM_KEYS || b >= DAS4Q_NUM_KEYS) {
+        return DAS4Q_LAYOUT_NO_KEY;
+    }
+    return das4q_layout_distance[a][b];
+}
+
+const uint8_t* das4q_key_distances(das4q_map_t origin) {
+    if (origin >= DAS4Q_NUM_KEYS) {
+        return NULL;
+    }
+    return das4q_layout_distance[origin];
+}
@@ -0,0 +1,2143 @@
+// Generated by scripts/gen_layout.py from keymap.h.  Don't edit,
+// rerun the script when keymap.h or the layout changes.
+
+#ifndef DAS4Q_LAYOUT_TABLE_H
+#define DAS4Q_LAYOUT_TABLE_H
+
+#if DAS4Q_LAYOUT_UNIT != 8 || DAS4Q_MAX_NEIGHBOURS != 16
+#error das4q_layout.h and gen_layout.py disagree
+#endif
+
+static const das4q_key_geometry_t das4q_layout_keys[DAS4Q_NUM_KEYS] = {
+    [KET_L_CTRL] = {0, 44, 10, 8, 5, 48},
+    [KEY_L_SHIFT] = {0, 36, 18, 8, 9, 40},
+    [KEY_CAPSLOCK] = {0, 28, 14, 8, 7, 32},
+    [KEY_TAB] = {0, 20, 12, 8, 6, 24},
+    [KEY_TILDE] = {0, 12, 8, 8, 4, 16},
+    [KEY_ESCAPE] = {0, 0, 8, 8, 4, 4},
+    [KEY_L_SUPER] = {10, 44, 10, 8, 15, 48},
+    [0x07] = {9, 36, 9, 8, 13, 40},
+    [KEY_A] = {14, 28, 8, 8, 18, 32},
+    [KEY_Q] = {12, 20, 8, 8, 16, 24},
+    [KEY_1] = {8, 12, 8, 8, 12, 16},
+    [KEY_L_ALT] = {20, 44, 10, 8, 25, 48},
+    [KEY_Z] = {18, 36, 8, 8, 22, 40},
+    [KEY_S] = {22, 28, 8, 8, 26, 32},
+    [KEY_W] = {20, 20, 8, 8, 24, 24},
+    [KEY_2] = {16, 12, 8, 8, 20, 16},
+    [KEY_F1] = {16, 0, 8, 8, 20, 4},
+    [0x12] = {30, 44, 8, 8, 34, 48},
+    [KEY_X] = {26, 36, 8, 8, 30, 40},
+    [KEY_D] = {30, 28, 8, 8, 34, 32},
+    [KEY_E] = {28, 20, 8, 8, 32, 24},
+    [KEY_3] = {24, 12, 8, 8, 28, 16},
+    [KEY_F2] = {24, 0, 8, 8, 28, 4},
+    [0x18] = {37, 44, 8, 8, 41, 48},
+    [KEY_C] = {34, 36, 8, 8, 38, 40},
+    [KEY_F] = {38, 28, 8, 8, 42, 32},
+    [KEY_R] = {36, 20, 8, 8, 40, 24},
+    [KEY_4] = {32, 12, 8, 8, 36, 16},
+    [KEY_F3] = {32, 0, 8, 8, 36, 4},
+    [0x1e] = {44, 44, 8, 8, 48, 48},
+    [KEY_V] = {42, 36, 8, 8, 46, 40},
+    [KEY_G] = {46, 28, 8, 8, 50, 32},
+    [KEY_T] = {44, 20, 8, 8, 48, 24},
+    [KEY_5] = {40, 12, 8, 8, 44, 16},
+    [KEY_F4] = {40, 0, 8, 8, 44, 4},
+    [KEY_SPACE] = {30, 44, 50, 8, 55, 48},
+    [KEY_B] = {50, 36, 8, 8, 54, 40},
+    [KEY_H] = {54, 28, 8, 8, 58, 32},
+    [KEY_Y] = {52, 20, 8, 8, 56, 24},
+    [KEY_6] = {48, 12, 8, 8, 52, 16},
+    [KEY_F5] = {52, 0, 8, 8, 56, 4},
+    [0x2a] = {58, 44, 8, 8, 62, 48},
+    [KEY_N] = {58, 36, 8, 8, 62, 40},
+    [KEY_J] = {62, 28, 8, 8, 66, 32},
+    [KEY_U] = {60, 20, 8, 8, 64, 24},
+    [KEY_7] = {56, 12, 8, 8, 60, 16},
+    [KEY_F6] = {60, 0, 8, 8, 64, 4},
+    [0x30] = {65, 44, 8, 8, 69, 48},
+    [KEY_M] = {66, 36, 8, 8, 70, 40},
+    [KEY_K] = {70, 28, 8, 8, 74, 32},
+    [KEY_I] = {68, 20, 8, 8, 72, 24},
+    [KEY_8] = {64, 12, 8, 8, 68, 16},
+    [KEY_F7] = {68, 0, 8, 8, 72, 4},
+    [0x36] = {72, 44, 8, 8, 76, 48},
+    [KEY_COMMA] = {74, 36, 8, 8, 78, 40},
+    [KEY_L] = {78, 28, 8, 8, 82, 32},
+    [KEY_O] = {76, 20, 8, 8, 80, 24},
+    [KEY_9] = {72, 12, 8, 8, 76, 16},
+    [KEY_F8] = {76, 0, 8, 8, 80, 4},
+    [KEY_R_ALT] = {80, 44, 10, 8, 85, 48},
+    [KEY_PERIOD] = {82, 36, 8, 8, 86, 40},
+    [KEY_SEMICOLON] = {86, 28, 8, 8, 90, 32},
+    [KEY_P] = {84, 20, 8, 8, 88, 24},
+    [KEY_0] = {80, 12, 8, 8, 84, 16},
+    [KEY_F9] = {88, 0, 8, 8, 92, 4},
+    [KEY_R_SUPER] = {90, 44, 10, 8, 95, 48},
+    [KEY_SLASH] = {90, 36, 8, 8, 94, 40},
+    [KEY_APOSTROPHE] = {94, 28, 8, 8, 98, 32},
+    [KEY_L_BRACKET] = {92, 20, 8, 8, 96, 24},
+    [KEY_DASH_UNDERSCORE] = {88, 12, 8, 8, 92, 16},
+    [KEY_F10] = {96, 0, 8, 8, 100, 4},
+    [KEY_META] = {100, 44, 10, 8, 105, 48},
+    [0x49] = {98, 36, 8, 8, 102, 40},
+    [0x4a] = {102, 28, 8, 8, 106, 32},
+    [KEY_R_BRACKET] = {100, 20, 8, 8, 104, 24},
+    [KEY_EQUALS_PLUS] = {96, 12, 8, 8, 100, 16},
+    [KEY_F11] = {104, 0, 8, 8, 108, 4},
+    [KEY_R_CTRL] = {110, 44, 10, 8, 115, 48},
+    [KEY_R_SHIFT] = {98, 36, 22, 8, 109, 40},
+    [KEY_ENTER] = {102, 28, 18, 8, 111, 32},
+    [KEY_BACKSLASH] = {108, 20, 12, 8, 114, 24},
+    [KEY_BACKSPACE] = {104, 12, 16, 8, 112, 16},
+    [KEY_F12] = {112, 0, 8, 8, 116, 4},
+    [KEY_ARROW_LEFT] = {122, 44, 8, 8, 126, 48},
+    [KEY_DELETE] = {122, 20, 8, 8, 126, 24},
+    [KEY_INSERT] = {122, 12, 8, 8, 126, 16},
+    [KEY_PRINT_SCR] = {122, 0, 8, 8, 126, 4},
+    [KEY_ARROW_DOWN] = {130, 44, 8, 8, 134, 48},
+    [KEY_ARROW_UP] = {130, 36, 8, 8, 134, 40},
+    [KEY_END] = {130, 20, 8, 8, 134, 24},
+    [KEY_HOME] = {130, 12, 8, 8, 134, 16},
+    [KEY_SCROLL_LOCK] = {130, 0, 8, 8, 134, 4},
+    [KEY_ARROW_RIGHT] = {138, 44, 8, 8, 142, 48},
+    [KEY_PAGE_DOWN] = {138, 20, 8, 8, 142, 24},
+    [KEY_PAGE_UP] = {138, 12, 8, 8, 142, 16},
+    [KEY_PAUSE] = {138, 0, 8, 8, 142, 4},
+    [KEY_NUM_0] = {148, 44, 16, 8, 156, 48},
+    [KEY_NUM_1] = {148, 36, 8, 8, 152, 40},
+    [KEY_NUM_4] = {148, 28, 8, 8, 152, 32},
+    [KEY_NUM_7] = {148, 20, 8, 8, 152, 24},
+    [KEY_NUMLOCK] = {148, 12, 8, 8, 152, 16},
+    [0x6c] = {156, 44, 8, 8, 160, 48},
+    [KEY_NUM_2] = {156, 36, 8, 8, 160, 40},
+    [KEY_NUM_5] = {156, 28, 8, 8, 160, 32},
+    [KEY_NUM_8] = {156, 20, 8, 8, 160, 24},
+    [KEY_NUM_SLASH] = {156, 12, 8, 8, 160, 16},
+    [KEY_NUM_PERIOD] = {164, 44, 8, 8, 168, 48},
+    [KEY_NUM_3] = {164, 36, 8, 8, 168, 40},
+    [KEY_NUM_6] = {164, 28, 8, 8, 168, 32},
+    [KEY_NUM_9] = {164, 20, 8, 8, 168, 24},
+    [KEY_NUM_STAR] = {164, 12, 8, 8, 168, 16},
+    [KEY_NUM_ENTER] = {172, 36, 8, 16, 176, 44},
+    [KEY_NUM_PLUS] = {172, 20, 8, 16, 176, 28},
+    [KEY_NUM_MINUS] = {172, 12, 8, 8, 176, 16},
+    [KEY_SLEEP] = {148, 0, 8, 8, 152, 4},
+    [KEY_BACKLIGHT_CTRL] = {156, 0, 8, 8, 160, 4},
+    [KEY_MEDIA_PLAY_PAUSE] = {164, 0, 8, 8, 168, 4},
+    [KEY_MEDIA_NEXT_TRACK] = {172, 0, 8, 8, 176, 4},
+};
+
+// das4q_layout_neighbours[das4q_layout_neighbour_start[k]] onwards, up to
+// das4q_layout_neighbour_start[k + 1]
+static const uint16_t das4q_layout_neighbour_start[DAS4Q_NUM_KEYS + 1] = {
+    0, 3, 10, 15, 20, 23, 25, 30,
+    37, 45, 52, 58, 58, 65, 72, 79,
+    86, 92, 96, 101, 109, 116, 123, 130,
+    135, 141, 149, 156, 163, 170, 175, 180,
+    187, 194, 201, 207, 211, 227, 234, 241,
+    248, 254, 257, 262, 269, 276, 283, 289,
+    293, 299, 307, 314, 321, 327, 331, 337,
+    345, 352, 359, 365, 368, 374, 382, 389,
+    396, 402, 406, 412, 420, 429, 437, 443,
+    448, 453, 460, 467, 474, 481, 485, 488,
+    497, 505, 511, 520, 524, 528, 528, 528,
+    534, 542, 547, 550, 553, 553, 558, 566,
+    571, 575, 575, 575, 581, 589, 594, 600,
+    606, 612, 619, 627, 627, 632, 640, 648,
+    656, 664, 664, 669, 677, 684, 691, 699,
+    699, 699, 699, 703, 709, 714, 714, 719,
+    724, 729, 732, 732, 732,
+};
+
+static const das4q_map_t das4q_layout_neighbours[732] = {
+    // KET_L_CTRL
+    KEY_L_SHIFT, KEY_L_SUPER, 0x07,
+    // KEY_L_SHIFT
+    KET_L_CTRL, KEY_CAPSLOCK, KEY_L_SUPER, 0x07, KEY_A, KEY_L_ALT, KEY_Z,
+    // KEY_CAPSLOCK
+    KEY_L_SHIFT, KEY_TAB, 0x07, KEY_A, KEY_Q,
+    // KEY_TAB
+    KEY_CAPSLOCK, KEY_TILDE, KEY_A, KEY_Q, KEY_1,
+    // KEY_TILDE
+    KEY_TAB, KEY_ESCAPE, KEY_1,
+    // KEY_ESCAPE
+    KEY_TILDE, KEY_1,
+    // KEY_L_SUPER
+    KET_L_CTRL, KEY_L_SHIFT, 0x07, KEY_L_ALT, KEY_Z,
+    // 0x07
+    KET_L_CTRL, KEY_L_SHIFT, KEY_CAPSLOCK, KEY_L_SUPER, KEY_A, KEY_L_ALT,
+    KEY_Z,
+    // KEY_A
+    KEY_L_SHIFT, KEY_CAPSLOCK, KEY_TAB, 0x07, KEY_Q, KEY_Z, KEY_S, KEY_W,
+    // KEY_Q
+    KEY_CAPSLOCK, KEY_TAB, KEY_A, KEY_1, KEY_S, KEY_W, KEY_2,
+    // KEY_1
+    KEY_TAB, KEY_TILDE, KEY_ESCAPE, KEY_Q, KEY_2, KEY_F1,
+    // KEY_L_ALT
+    KEY_L_SHIFT, KEY_L_SUPER, 0x07, KEY_Z, 0x12, KEY_X, KEY_SPACE,
+    // KEY_Z
+    KEY_L_SHIFT, KEY_L_SUPER, 0x07, KEY_A, KEY_L_ALT, KEY_S, KEY_X,
+    // KEY_S
+    KEY_A, KEY_Q, KEY_Z, KEY_W, KEY_X, KEY_D, KEY_E,
+    // KEY_W
+    KEY_A, KEY_Q, KEY_S, KEY_2, KEY_D, KEY_E, KEY_3,
+    // KEY_2
+    KEY_Q, KEY_1, KEY_W, KEY_F1, KEY_3, KEY_F2,
+    // KEY_F1
+    KEY_1, KEY_2, KEY_3, KEY_F2,
+    // 0x12
+    KEY_L_ALT, KEY_X, 0x18, KEY_C, KEY_SPACE,
+    // KEY_X
+    KEY_L_ALT, KEY_Z, KEY_S, 0x12, KEY_D, 0x18, KEY_C, KEY_SPACE,
+    // KEY_D
+    KEY_S, KEY_W, KEY_X, KEY_E, KEY_C, KEY_F, KEY_R,
+    // KEY_E
+    KEY_S, KEY_W, KEY_D, KEY_3, KEY_F, KEY_R, KEY_4,
+    // KEY_3
+    KEY_W, KEY_2, KEY_F1, KEY_E, KEY_F2, KEY_4, KEY_F3,
+    // KEY_F2
+    KEY_2, KEY_F1, KEY_3, KEY_4, KEY_F3,
+    // 0x18
+    0x12, KEY_X, KEY_C, 0x1e, KEY_V, KEY_SPACE,
+    // KEY_C
+    0x12, KEY_X, KEY_D, 0x18, KEY_F, 0x1e, KEY_V, KEY_SPACE,
+    // KEY_F
+    KEY_D, KEY_E, KEY_C, KEY_R, KEY_V, KEY_G, KEY_T,
+    // KEY_R
+    KEY_D, KEY_E, KEY_F, KEY_4, KEY_G, KEY_T, KEY_5,
+    // KEY_4
+    KEY_E, KEY_3, KEY_F2, KEY_R, KEY_F3, KEY_5, KEY_F4,
+    // KEY_F3
+    KEY_3, KEY_F2, KEY_4, KEY_5, KEY_F4,
+    // 0x1e
+    0x18, KEY_C, KEY_V, KEY_SPACE, KEY_B,
+    // KEY_V
+    0x18, KEY_C, KEY_F, 0x1e, KEY_G, KEY_SPACE, KEY_B,
+    // KEY_G
+    KEY_F, KEY_R, KEY_V, KEY_T, KEY_B, KEY_H, KEY_Y,
+    // KEY_T
+    KEY_F, KEY_R, KEY_G, KEY_5, KEY_H, KEY_Y, KEY_6,
+    // KEY_5
+    KEY_R, KEY_4, KEY_F3, KEY_T, KEY_F4, KEY_6,
+    // KEY_F4
+    KEY_4, KEY_F3, KEY_5, KEY_6,
+    // KEY_SPACE
+    KEY_L_ALT, 0x12, KEY_X, 0x18, KEY_C, 0x1e, KEY_V, KEY_B, 0x2a, KEY_N, 0x30,
+    KEY_M, 0x36, KEY_COMMA, KEY_R_ALT, KEY_PERIOD,
+    // KEY_B
+    0x1e, KEY_V, KEY_G, KEY_SPACE, KEY_H, 0x2a, KEY_N,
+    // KEY_H
+    KEY_G, KEY_T, KEY_B, KEY_Y, KEY_N, KEY_J, KEY_U,
+    // KEY_Y
+    KEY_G, KEY_T, KEY_H, KEY_6, KEY_J, KEY_U, KEY_7,
+    // KEY_6
+    KEY_T, KEY_5, KEY_F4, KEY_Y, KEY_F5, KEY_7,
+    // KEY_F5
+    KEY_6, KEY_7, KEY_F6,
+    // 0x2a
+    KEY_SPACE, KEY_B, KEY_N, 0x30, KEY_M,
+    // KEY_N
+    KEY_SPACE, KEY_B, KEY_H, 0x2a, KEY_J, 0x30, KEY_M,
+    // KEY_J
+    KEY_H, KEY_Y, KEY_N, KEY_U, KEY_M, KEY_K, KEY_I,
+    // KEY_U
+    KEY_H, KEY_Y, KEY_J, KEY_7, KEY_K, KEY_I, KEY_8,
+    // KEY_7
+    KEY_Y, KEY_6, KEY_F5, KEY_U, KEY_F6, KEY_8,
+    // KEY_F6
+    KEY_F5, KEY_7, KEY_8, KEY_F7,
+    // 0x30
+    KEY_SPACE, 0x2a, KEY_N, KEY_M, 0x36, KEY_COMMA,
+    // KEY_M
+    KEY_SPACE, 0x2a, KEY_N, KEY_J, 0x30, KEY_K, 0x36, KEY_COMMA,
+    // KEY_K
+    KEY_J, KEY_U, KEY_M, KEY_I, KEY_COMMA, KEY_L, KEY_O,
+    // KEY_I
+    KEY_J, KEY_U, KEY_K, KEY_8, KEY_L, KEY_O, KEY_9,
+    // KEY_8
+    KEY_U, KEY_7, KEY_F6, KEY_I, KEY_F7, KEY_9,
+    // KEY_F7
+    KEY_F6, KEY_8, KEY_9, KEY_F8,
+    // 0x36
+    KEY_SPACE, 0x30, KEY_M, KEY_COMMA, KEY_R_ALT, KEY_PERIOD,
+    // KEY_COMMA
+    KEY_SPACE, 0x30, KEY_M, KEY_K, 0x36, KEY_L, KEY_R_ALT, KEY_PERIOD,
+    // KEY_L
+    KEY_K, KEY_I, KEY_COMMA, KEY_O, KEY_PERIOD, KEY_SEMICOLON, KEY_P,
+    // KEY_O
+    KEY_K, KEY_I, KEY_L, KEY_9, KEY_SEMICOLON, KEY_P, KEY_0,
+    // KEY_9
+    KEY_I, KEY_8, KEY_F7, KEY_O, KEY_F8, KEY_0,
+    // KEY_F8
+    KEY_F7, KEY_9, KEY_0,
+    // KEY_R_ALT
+    KEY_SPACE, 0x36, KEY_COMMA, KEY_PERIOD, KEY_R_SUPER, KEY_SLASH,
+    // KEY_PERIOD
+    KEY_SPACE, 0x36, KEY_COMMA, KEY_L, KEY_R_ALT, KEY_SEMICOLON, KEY_R_SUPER,
+    KEY_SLASH,
+    // KEY_SEMICOLON
+    KEY_L, KEY_O, KEY_PERIOD, KEY_P, KEY_SLASH, KEY_APOSTROPHE, KEY_L_BRACKET,
+    // KEY_P
+    KEY_L, KEY_O, KEY_SEMICOLON, KEY_0, KEY_APOSTROPHE, KEY_L_BRACKET,
+    KEY_DASH_UNDERSCORE,
+    // KEY_0
+    KEY_O, KEY_9, KEY_F8, KEY_P, KEY_F9, KEY_DASH_UNDERSCORE,
+    // KEY_F9
+    KEY_0, KEY_DASH_UNDERSCORE, KEY_F10, KEY_EQUALS_PLUS,
+    // KEY_R_SUPER
+    KEY_R_ALT, KEY_PERIOD, KEY_SLASH, KEY_META, 0x49, KEY_R_SHIFT,
+    // KEY_SLASH
+    KEY_R_ALT, KEY_PERIOD, KEY_SEMICOLON, KEY_R_SUPER, KEY_APOSTROPHE,
+    KEY_META, 0x49, KEY_R_SHIFT,
+    // KEY_APOSTROPHE
+    KEY_SEMICOLON, KEY_P, KEY_SLASH, KEY_L_BRACKET, 0x49, 0x4a, KEY_R_BRACKET,
+    KEY_R_SHIFT, KEY_ENTER,
+    // KEY_L_BRACKET
+    KEY_SEMICOLON, KEY_P, KEY_APOSTROPHE, KEY_DASH_UNDERSCORE, 0x4a,
+    KEY_R_BRACKET, KEY_EQUALS_PLUS, KEY_ENTER,
+    // KEY_DASH_UNDERSCORE
+    KEY_P, KEY_0, KEY_F9, KEY_L_BRACKET, KEY_F10, KEY_EQUALS_PLUS,
+    // KEY_F10
+    KEY_F9, KEY_DASH_UNDERSCORE, KEY_EQUALS_PLUS, KEY_F11, KEY_BACKSPACE,
+    // KEY_META
+    KEY_R_SUPER, KEY_SLASH, 0x49, KEY_R_CTRL, KEY_R_SHIFT,
+    // 0x49
+    KEY_R_SUPER, KEY_SLASH, KEY_APOSTROPHE, KEY_META, 0x4a, KEY_R_SHIFT,
+    KEY_ENTER,
+    // 0x4a
+    KEY_APOSTROPHE, KEY_L_BRACKET, 0x49, KEY_R_BRACKET, KEY_R_SHIFT, KEY_ENTER,
+    KEY_BACKSLASH,
+    // KEY_R_BRACKET
+    KEY_APOSTROPHE, KEY_L_BRACKET, 0x4a, KEY_EQUALS_PLUS, KEY_ENTER,
+    KEY_BACKSLASH, KEY_BACKSPACE,
+    // KEY_EQUALS_PLUS
+    KEY_F9, KEY_L_BRACKET, KEY_DASH_UNDERSCORE, KEY_F10, KEY_R_BRACKET,
+    KEY_F11, KEY_BACKSPACE,
+    // KEY_F11
+    KEY_F10, KEY_EQUALS_PLUS, KEY_BACKSPACE, KEY_F12,
+    // KEY_R_CTRL
+    KEY_META, KEY_R_SHIFT, KEY_ARROW_LEFT,
+    // KEY_R_SHIFT
+    KEY_R_SUPER, KEY_SLASH, KEY_APOSTROPHE, KEY_META, 0x49, 0x4a, KEY_R_CTRL,
+    KEY_ENTER, KEY_ARROW_LEFT,
+    // KEY_ENTER
+    KEY_APOSTROPHE, KEY_L_BRACKET, 0x49, 0x4a, KEY_R_BRACKET, KEY_R_SHIFT,
+    KEY_BACKSLASH, KEY_DELETE,
+    // KEY_BACKSLASH
+    0x4a, KEY_R_BRACKET, KEY_ENTER, KEY_BACKSPACE, KEY_DELETE, KEY_INSERT,
+    // KEY_BACKSPACE
+    KEY_F10, KEY_R_BRACKET, KEY_EQUALS_PLUS, KEY_F11, KEY_BACKSLASH, KEY_F12,
+    KEY_DELETE, KEY_INSERT, KEY_PRINT_SCR,
+    // KEY_F12
+    KEY_F11, KEY_BACKSPACE, KEY_INSERT, KEY_PRINT_SCR,
+    // KEY_ARROW_LEFT
+    KEY_R_CTRL, KEY_R_SHIFT, KEY_ARROW_DOWN, KEY_ARROW_UP,
+    // KEY_DELETE
+    KEY_ENTER, KEY_BACKSLASH, KEY_BACKSPACE, KEY_INSERT, KEY_END, KEY_HOME,
+    // KEY_INSERT
+    KEY_BACKSLASH, KEY_BACKSPACE, KEY_F12, KEY_DELETE, KEY_PRINT_SCR, KEY_END,
+    KEY_HOME, KEY_SCROLL_LOCK,
+    // KEY_PRINT_SCR
+    KEY_BACKSPACE, KEY_F12, KEY_INSERT, KEY_HOME, KEY_SCROLL_LOCK,
+    // KEY_ARROW_DOWN
+    KEY_ARROW_LEFT, KEY_ARROW_UP, KEY_ARROW_RIGHT,
+    // KEY_ARROW_UP
+    KEY_ARROW_LEFT, KEY_ARROW_DOWN, KEY_ARROW_RIGHT,
+    // KEY_END
+    KEY_DELETE, KEY_INSERT, KEY_HOME, KEY_PAGE_DOWN, KEY_PAGE_UP,
+    // KEY_HOME
+    KEY_DELETE, KEY_INSERT, KEY_PRINT_SCR, KEY_END, KEY_SCROLL_LOCK,
+    KEY_PAGE_DOWN, KEY_PAGE_UP, KEY_PAUSE,
+    // KEY_SCROLL_LOCK
+    KEY_INSERT, KEY_PRINT_SCR, KEY_HOME, KEY_PAGE_UP, KEY_PAUSE,
+    // KEY_ARROW_RIGHT
+    KEY_ARROW_DOWN, KEY_ARROW_UP, KEY_NUM_0, KEY_NUM_1,
+    // KEY_PAGE_DOWN
+    KEY_END, KEY_HOME, KEY_PAGE_UP, KEY_NUM_4, KEY_NUM_7, KEY_NUMLOCK,
+    // KEY_PAGE_UP
+    KEY_END, KEY_HOME, KEY_SCROLL_LOCK, KEY_PAGE_DOWN, KEY_PAUSE, KEY_NUM_7,
+    KEY_NUMLOCK, KEY_SLEEP,
+    // KEY_PAUSE
+    KEY_HOME, KEY_SCROLL_LOCK, KEY_PAGE_UP, KEY_NUMLOCK, KEY_SLEEP,
+    // KEY_NUM_0
+    KEY_ARROW_RIGHT, KEY_NUM_1, 0x6c, KEY_NUM_2, KEY_NUM_PERIOD, KEY_NUM_3,
+    // KEY_NUM_1
+    KEY_ARROW_RIGHT, KEY_NUM_0, KEY_NUM_4, 0x6c, KEY_NUM_2, KEY_NUM_5,
+    // KEY_NUM_4
+    KEY_PAGE_DOWN, KEY_NUM_1, KEY_NUM_7, KEY_NUM_2, KEY_NUM_5, KEY_NUM_8,
+    // KEY_NUM_7
+    KEY_PAGE_DOWN, KEY_PAGE_UP, KEY_NUM_4, KEY_NUMLOCK, KEY_NUM_5, KEY_NUM_8,
+    KEY_NUM_SLASH,
+    // KEY_NUMLOCK
+    KEY_PAGE_DOWN, KEY_PAGE_UP, KEY_PAUSE, KEY_NUM_7, KEY_NUM_8, KEY_NUM_SLASH,
+    KEY_SLEEP, KEY_BACKLIGHT_CTRL,
+    // 0x6c
+    KEY_NUM_0, KEY_NUM_1, KEY_NUM_2, KEY_NUM_PERIOD, KEY_NUM_3,
+    // KEY_NUM_2
+    KEY_NUM_0, KEY_NUM_1, KEY_NUM_4, 0x6c, KEY_NUM_5, KEY_NUM_PERIOD,
+    KEY_NUM_3, KEY_NUM_6,
+    // KEY_NUM_5
+    KEY_NUM_1, KEY_NUM_4, KEY_NUM_7, KEY_NUM_2, KEY_NUM_8, KEY_NUM_3,
+    KEY_NUM_6, KEY_NUM_9,
+    // KEY_NUM_8
+    KEY_NUM_4, KEY_NUM_7, KEY_NUMLOCK, KEY_NUM_5, KEY_NUM_SLASH, KEY_NUM_6,
+    KEY_NUM_9, KEY_NUM_STAR,
+    // KEY_NUM_SLASH
+    KEY_NUM_7, KEY_NUMLOCK, KEY_NUM_8, KEY_NUM_9, KEY_NUM_STAR, KEY_SLEEP,
+    KEY_BACKLIGHT_CTRL, KEY_MEDIA_PLAY_PAUSE,
+    // KEY_NUM_PERIOD
+    KEY_NUM_0, 0x6c, KEY_NUM_2, KEY_NUM_3, KEY_NUM_ENTER,
+    // KEY_NUM_3
+    KEY_NUM_0, 0x6c, KEY_NUM_2, KEY_NUM_5, KEY_NUM_PERIOD, KEY_NUM_6,
+    KEY_NUM_ENTER, KEY_NUM_PLUS,
+    // KEY_NUM_6
+    KEY_NUM_2, KEY_NUM_5, KEY_NUM_8, KEY_NUM_3, KEY_NUM_9, KEY_NUM_ENTER,
+    KEY_NUM_PLUS,
+    // KEY_NUM_9
+    KEY_NUM_5, KEY_NUM_8, KEY_NUM_SLASH, KEY_NUM_6, KEY_NUM_STAR, KEY_NUM_PLUS,
+    KEY_NUM_MINUS,
+    // KEY_NUM_STAR
+    KEY_NUM_8, KEY_NUM_SLASH, KEY_NUM_9, KEY_NUM_PLUS, KEY_NUM_MINUS,
+    KEY_BACKLIGHT_CTRL, KEY_MEDIA_PLAY_PAUSE, KEY_MEDIA_NEXT_TRACK,
+    // KEY_NUM_ENTER
+    KEY_NUM_PERIOD, KEY_NUM_3, KEY_NUM_6, KEY_NUM_PLUS,
+    // KEY_NUM_PLUS
+    KEY_NUM_3, KEY_NUM_6, KEY_NUM_9, KEY_NUM_STAR, KEY_NUM_ENTER,
+    KEY_NUM_MINUS,
+    // KEY_NUM_MINUS
+    KEY_NUM_9, KEY_NUM_STAR, KEY_NUM_PLUS, KEY_MEDIA_PLAY_PAUSE,
+    KEY_MEDIA_NEXT_TRACK,
+    // KEY_SLEEP
+    KEY_PAGE_UP, KEY_PAUSE, KEY_NUMLOCK, KEY_NUM_SLASH, KEY_BACKLIGHT_CTRL,
+    // KEY_BACKLIGHT_CTRL
+    KEY_NUMLOCK, KEY_NUM_SLASH, KEY_NUM_STAR, KEY_SLEEP, KEY_MEDIA_PLAY_PAUSE,
+    // KEY_MEDIA_PLAY_PAUSE
+    KEY_NUM_SLASH, KEY_NUM_STAR, KEY_NUM_MINUS, KEY_BACKLIGHT_CTRL,
+    KEY_MEDIA_NEXT_TRACK,
+    // KEY_MEDIA_NEXT_TRACK
+    KEY_NUM_STAR, KEY_NUM_MINUS, KEY_MEDIA_PLAY_PAUSE,
+};
+
+// Centre to centre, DAS4Q_LAYOUT_NO_KEY where either slot has no key
+static const uint8_t das4q_layout_distance[DAS4Q_NUM_KEYS][DAS4Q_NUM_KEYS] = {
+    [0x00] = {
+        0, 9, 16, 24, 32, 44, 10, 12, 21, 26, 33, 255,
+        20, 19, 26, 31, 35, 46, 29, 26, 33, 36, 39, 50,
+        36, 34, 40, 42, 45, 54, 43, 42, 48, 49, 50, 59,
+        50, 50, 55, 56, 57, 67, 57, 58, 63, 64, 64, 74,
+        64, 65, 71, 71, 71, 80, 71, 73, 79, 79, 78, 87,
+        80, 81, 86, 86, 85, 97, 90, 89, 94, 94, 93, 105,
+        100, 97, 102, 102, 100, 112, 110, 104, 107, 112, 112, 119,
+        121, 255, 255, 123, 125, 129, 129, 129, 255, 131, 133, 136,
+        137, 255, 255, 139, 141, 144, 151, 147, 148, 149, 150, 255,
+        155, 155, 156, 157, 158, 255, 163, 163, 164, 165, 166, 255,
+        255, 255, 171, 172, 174, 255, 153, 161, 169, 177, 255, 255,
+    },
+    [0x01] = {
+        9, 0, 8, 16, 25, 36, 10, 4, 12, 17, 24, 255,
+        18, 13, 19, 22, 26, 38, 26, 21, 26, 28, 31, 41,
+        33, 29, 34, 35, 36, 45, 40, 37, 42, 42, 42, 50,
+        47, 45, 50, 50, 49, 59, 54, 53, 58, 57, 56, 66,
+        61, 61, 65, 65, 64, 73, 67, 69, 73, 73, 71, 80,
+        76, 77, 81, 81, 79, 90, 86, 85, 89, 88, 86, 98,
+        96, 93, 97, 96, 94, 105, 106, 100, 102, 106, 106, 113,
+        117, 255, 255, 118, 119, 122, 125, 125, 255, 126, 127, 130,
+        133, 255, 255, 134, 135, 138, 147, 143, 143, 144, 145, 255,
+        151, 151, 151, 152, 153, 255, 159, 159, 159, 160, 161, 255,
+        255, 255, 167, 167, 169, 255, 147, 155, 163, 171, 255, 255,
+    },
+    [0x02] = {
+        16, 8, 0, 8, 16, 28, 18, 10, 11, 12, 17, 255,
+        24, 17, 19, 19, 21, 31, 31, 24, 27, 26, 26, 35,
+        38, 32, 35, 34, 33, 40, 44, 40, 43, 42, 40, 46,
+        51, 48, 51, 50, 48, 56, 57, 56, 59, 58, 55, 64,
+        64, 64, 67, 65, 63, 71, 71, 71, 75, 73, 71, 78,
+        80, 79, 83, 81, 79, 89, 89, 87, 91, 89, 86, 97,
+        99, 95, 99, 97, 94, 105, 109, 102, 104, 107, 106, 113,
+        120, 255, 255, 119, 120, 122, 128, 127, 255, 127, 128, 130,
+        136, 255, 255, 135, 136, 138, 150, 145, 145, 145, 146, 255,
+        154, 153, 153, 153, 154, 255, 162, 161, 161, 161, 162, 255,
+        255, 255, 169, 169, 170, 255, 148, 156, 163, 171, 255, 255,
+    },
+    [0x03] = {
+        24, 16, 8, 0, 8, 20, 26, 18, 14, 10, 10, 255,
+        31, 23, 22, 18, 16, 24, 37, 29, 29, 26, 23, 30,
+        42, 36, 37, 34, 31, 36, 48, 43, 45, 42, 39, 43,
+        55, 51, 53, 50, 47, 54, 61, 58, 61, 58, 55, 61,
+        67, 66, 68, 66, 63, 69, 74, 74, 76, 74, 70, 77,
+        83, 82, 84, 82, 78, 88, 92, 89, 92, 90, 86, 96,
+        102, 97, 100, 98, 94, 104, 112, 104, 105, 108, 106, 112,
+        122, 255, 255, 120, 120, 122, 130, 129, 255, 128, 128, 130,
+        138, 255, 255, 136, 136, 137, 152, 147, 146, 146, 146, 255,
+        156, 155, 154, 154, 154, 255, 164, 163, 162, 162, 162, 255,
+        255, 255, 171, 170, 170, 255, 147, 155, 163, 171, 255, 255,
+    },
+    [0x04] = {
+        32, 25, 16, 8, 0, 12, 34, 26, 21, 14, 8, 255,
+        38, 30, 27, 22, 16, 20, 44, 35, 34, 29, 24, 27,
+        49, 42, 41, 37, 32, 34, 54, 48, 49, 45, 40, 42,
+        60, 55, 56, 53, 48, 53, 66, 63, 64, 61, 56, 61,
+        72, 70, 72, 68, 64, 69, 79, 78, 80, 76, 72, 77,
+        87, 85, 87, 84, 80, 89, 96, 93, 95, 92, 88, 97,
+        106, 101, 103, 100, 96, 105, 116, 108, 108, 110, 108, 113,
+        126, 255, 255, 122, 122, 123, 134, 132, 255, 130, 130, 131,
+        142, 255, 255, 138, 138, 139, 155, 150, 149, 148, 148, 255,
+        159, 158, 157, 156, 156, 255, 167, 166, 165, 164, 164, 255,
+        255, 255, 174, 172, 172, 255, 148, 156, 164, 172, 255, 255,
+    },
+    [0x05] = {
+        44, 36, 28, 20, 12, 0, 45, 37, 31, 23, 14, 255,
+        49, 40, 36, 28, 20, 16, 53, 44, 41, 34, 27, 24,
+        57, 50, 47, 41, 34, 32, 62, 55, 54, 48, 42, 40,
+        67, 62, 61, 56, 49, 52, 73, 68, 68, 63, 57, 60,
+        78, 75, 75, 71, 65, 68, 84, 82, 83, 79, 73, 76,
+        92, 90, 90, 86, 81, 88, 101, 97, 98, 94, 89, 96,
+        110, 104, 106, 102, 97, 104, 119, 111, 111, 112, 109, 112,
+        130, 255, 255, 124, 123, 122, 137, 135, 255, 132, 131, 130,
+        145, 255, 255, 139, 139, 138, 158, 152, 151, 149, 148, 255,
+        162, 160, 158, 157, 156, 255, 170, 168, 166, 165, 164, 255,
+        255, 255, 177, 174, 172, 255, 148, 156, 164, 172, 255, 255,
+    },
+    [0x06] = {
+        10, 10, 18, 26, 34, 45, 0, 8, 16, 24, 32, 255,
+        10, 11, 19, 26, 32, 44, 19, 17, 25, 29, 35, 46,
+        26, 24, 31, 35, 38, 49, 33, 32, 38, 41, 43, 53,
+        40, 40, 46, 48, 49, 60, 47, 48, 53, 55, 55, 66,
+        54, 56, 61, 62, 62, 72, 61, 64, 69, 69, 69, 78,
+        70, 71, 77, 77, 76, 89, 80, 79, 85, 84, 83, 96,
+        90, 87, 92, 92, 91, 103, 100, 94, 97, 102, 102, 110,
+        111, 255, 255, 114, 116, 119, 119, 119, 255, 121, 123, 127,
+        127, 255, 255, 129, 131, 134, 141, 137, 138, 139, 141, 255,
+        145, 145, 146, 147, 148, 255, 153, 153, 154, 155, 156, 255,
+        255, 255, 161, 162, 164, 255, 144, 152, 159, 167, 255, 255,
+    },
+    [0x07] = {
+        12, 4, 10, 18, 26, 37, 8, 0, 9, 16, 24, 255,
+        14, 8, 15, 19, 25, 37, 22, 16, 22, 24, 28, 39,
+        29, 24, 30, 31, 33, 42, 35, 32, 37, 38, 39, 47,
+        42, 40, 45, 45, 45, 56, 49, 48, 53, 53, 52, 62,
+        56, 56, 61, 61, 60, 69, 63, 64, 69, 68, 67, 76,
+        72, 72, 77, 76, 74, 86, 82, 80, 85, 84, 82, 94,
+        92, 88, 93, 92, 90, 101, 102, 96, 98, 102, 101, 109,
+        113, 255, 255, 114, 115, 118, 121, 120, 255, 122, 123, 126,
+        129, 255, 255, 129, 131, 133, 143, 138, 139, 139, 141, 255,
+        147, 146, 147, 147, 148, 255, 155, 154, 155, 155, 156, 255,
+        255, 255, 163, 163, 164, 255, 143, 151, 159, 166, 255, 255,
+    },
+    [0x08] = {
+        21, 12, 11, 14, 21, 31, 16, 9, 0, 8, 17, 255,
+        17, 9, 8, 10, 16, 28, 23, 14, 16, 16, 19, 30,
+        28, 22, 24, 23, 24, 33, 34, 29, 32, 31, 31, 38,
+        40, 37, 40, 39, 38, 47, 47, 45, 48, 47, 45, 54,
+        53, 53, 56, 55, 52, 61, 60, 61, 64, 63, 60, 68,
+        69, 68, 72, 70, 68, 79, 79, 76, 80, 78, 76, 87,
+        88, 84, 88, 86, 84, 94, 98, 91, 93, 96, 95, 102,
+        109, 255, 255, 108, 109, 112, 117, 116, 255, 116, 117, 119,
+        125, 255, 255, 124, 125, 127, 139, 134, 134, 134, 135, 255,
+        143, 142, 142, 142, 143, 255, 151, 150, 150, 150, 151, 255,
+        255, 255, 158, 158, 159, 255, 137, 145, 153, 160, 255, 255,
+    },
+    [0x09] = {
+        26, 17, 12, 10, 14, 23, 24, 16, 8, 0, 9, 255,
+        26, 17, 13, 8, 9, 20, 30, 21, 20, 16, 14, 23,
+        35, 27, 27, 24, 22, 28, 40, 34, 35, 32, 29, 34,
+        46, 41, 43, 40, 37, 45, 52, 49, 51, 48, 45, 52,
+        58, 56, 59, 56, 53, 59, 65, 64, 66, 64, 61, 67,
+        73, 72, 74, 72, 68, 79, 83, 80, 82, 80, 76, 86,
+        92, 87, 90, 88, 84, 94, 102, 94, 95, 98, 96, 102,
+        113, 255, 255, 110, 110, 112, 120, 119, 255, 118, 118, 120,
+        128, 255, 255, 126, 126, 128, 142, 137, 136, 136, 136, 255,
+        146, 145, 144, 144, 144, 255, 154, 153, 152, 152, 152, 255,
+        255, 255, 161, 160, 160, 255, 137, 145, 153, 161, 255, 255,
+    },
+    [0x0a] = {
+        33, 24, 17, 10, 8, 14, 32, 24, 17, 9, 0, 255,
+        35, 26, 21, 14, 8, 14, 39, 30, 27, 22, 16, 20,
+        43, 35, 34, 29, 24, 27, 48, 42, 41, 37, 32, 34,
+        54, 48, 49, 45, 40, 46, 59, 55, 56, 53, 48, 53,
+        65, 63, 64, 61, 56, 61, 72, 70, 72, 68, 64, 69,
+        80, 78, 80, 76, 72, 81, 89, 85, 87, 84, 80, 89,
+        98, 93, 95, 92, 88, 97, 108, 100, 100, 102, 100, 105,
+        118, 255, 255, 114, 114, 115, 126, 124, 255, 122, 122, 123,
+        134, 255, 255, 130, 130, 131, 148, 142, 141, 140, 140, 255,
+        151, 150, 149, 148, 148, 255, 159, 158, 157, 156, 156, 255,
+        255, 255, 166, 164, 164, 255, 141, 148, 156, 164, 255, 255,
+    },
+    [0x0b] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x0c] = {
+        20, 18, 24, 31, 38, 49, 10, 14, 17, 26, 35, 255,
+        0, 9, 16, 24, 32, 44, 9, 9, 18, 25, 32, 44,
+        16, 15, 23, 28, 34, 45, 23, 22, 30, 33, 37, 48,
+        30, 30, 37, 39, 42, 54, 37, 38, 44, 46, 47, 59,
+        44, 46, 52, 53, 54, 64, 51, 54, 59, 60, 60, 70,
+        60, 62, 67, 67, 67, 80, 70, 69, 75, 75, 74, 87,
+        80, 77, 83, 83, 82, 94, 90, 84, 87, 92, 93, 101,
+        101, 255, 255, 104, 106, 110, 109, 109, 255, 112, 114, 118,
+        117, 255, 255, 119, 121, 125, 131, 127, 128, 129, 131, 255,
+        135, 135, 136, 137, 139, 255, 143, 143, 144, 145, 147, 255,
+        255, 255, 151, 152, 154, 255, 134, 142, 150, 157, 255, 255,
+    },
+    [0x0d] = {
+        19, 13, 17, 23, 30, 40, 11, 8, 9, 17, 26, 255,
+        9, 0, 9, 16, 24, 36, 14, 8, 14, 19, 25, 36,
+        21, 16, 22, 24, 28, 39, 27, 24, 29, 31, 33, 42,
+        34, 32, 37, 38, 38, 50, 41, 40, 45, 45, 45, 55,
+        48, 48, 53, 52, 52, 62, 55, 56, 61, 60, 59, 68,
+        64, 64, 68, 68, 66, 79, 73, 72, 76, 76, 74, 86,
+        83, 80, 84, 84, 82, 93, 93, 87, 89, 93, 93, 101,
+        104, 255, 255, 105, 107, 110, 112, 112, 255, 113, 115, 118,
+        120, 255, 255, 121, 122, 125, 134, 130, 130, 131, 132, 255,
+        138, 138, 138, 139, 140, 255, 146, 146, 146, 147, 148, 255,
+        255, 255, 154, 154, 156, 255, 135, 143, 150, 158, 255, 255,
+    },
+    [0x0e] = {
+        26, 19, 19, 22, 27, 36, 19, 15, 8, 13, 21, 255,
+        16, 9, 0, 8, 17, 29, 18, 9, 8, 10, 16, 28,
+        22, 14, 16, 16, 19, 30, 27, 22, 24, 23, 24, 33,
+        33, 29, 32, 31, 31, 41, 39, 37, 40, 39, 38, 47,
+        46, 45, 48, 47, 45, 54, 52, 53, 56, 55, 52, 61,
+        61, 61, 64, 63, 60, 72, 71, 68, 72, 70, 68, 79,
+        81, 76, 80, 78, 76, 87, 90, 83, 85, 88, 87, 94,
+        101, 255, 255, 100, 101, 104, 109, 108, 255, 108, 109, 112,
+        117, 255, 255, 116, 117, 119, 131, 126, 126, 126, 127, 255,
+        135, 134, 134, 134, 135, 255, 143, 142, 142, 142, 143, 255,
+        255, 255, 150, 150, 151, 255, 129, 137, 145, 153, 255, 255,
+    },
+    [0x0f] = {
+        31, 22, 19, 18, 22, 28, 26, 19, 10, 8, 14, 255,
+        24, 16, 8, 0, 9, 20, 26, 17, 13, 8, 9, 20,
+        29, 21, 20, 16, 14, 23, 34, 27, 27, 24, 22, 28,
+        39, 34, 35, 32, 29, 38, 45, 41, 43, 40, 37, 45,
+        51, 49, 51, 48, 45, 52, 57, 56, 59, 56, 53, 59,
+        66, 64, 66, 64, 61, 71, 75, 72, 74, 72, 68, 79,
+        84, 80, 82, 80, 76, 86, 94, 86, 87, 90, 88, 94,
+        105, 255, 255, 102, 102, 104, 113, 111, 255, 110, 110, 112,
+        120, 255, 255, 118, 118, 120, 134, 129, 128, 128, 128, 255,
+        138, 137, 136, 136, 136, 255, 146, 145, 144, 144, 144, 255,
+        255, 255, 153, 152, 152, 255, 130, 137, 145, 153, 255, 255,
+    },
+    [0x10] = {
+        35, 26, 21, 16, 16, 20, 32, 25, 16, 9, 8, 255,
+        32, 24, 17, 9, 0, 12, 35, 26, 21, 14, 8, 14,
+        38, 30, 27, 22, 16, 20, 43, 35, 34, 29, 24, 27,
+        47, 42, 41, 37, 32, 38, 53, 48, 49, 45, 40, 46,
+        59, 55, 56, 53, 48, 53, 64, 63, 64, 61, 56, 61,
+        72, 70, 72, 68, 64, 73, 82, 78, 80, 76, 72, 81,
+        91, 85, 87, 84, 80, 89, 100, 92, 92, 94, 92, 97,
+        111, 255, 255, 106, 106, 107, 118, 116, 255, 114, 114, 115,
+        126, 255, 255, 122, 122, 123, 140, 134, 133, 132, 132, 255,
+        144, 142, 141, 140, 140, 255, 151, 150, 149, 148, 148, 255,
+        255, 255, 158, 156, 156, 255, 133, 141, 148, 156, 255, 255,
+    },
+    [0x11] = {
+        46, 38, 31, 24, 20, 16, 44, 37, 28, 20, 14, 255,
+        44, 36, 29, 20, 12, 0, 46, 37, 31, 23, 14, 8,
+        49, 40, 36, 28, 20, 16, 52, 44, 41, 34, 27, 24,
+        56, 50, 47, 41, 34, 36, 61, 55, 54, 48, 42, 44,
+        66, 62, 61, 56, 49, 52, 71, 68, 68, 63, 57, 60,
+        78, 75, 75, 71, 65, 72, 87, 82, 83, 79, 73, 80,
+        96, 90, 90, 86, 81, 88, 105, 96, 95, 96, 93, 96,
+        115, 255, 255, 108, 107, 106, 122, 120, 255, 116, 115, 114,
+        130, 255, 255, 124, 123, 122, 143, 137, 135, 134, 133, 255,
+        147, 145, 143, 141, 141, 255, 154, 152, 151, 149, 148, 255,
+        255, 255, 161, 158, 156, 255, 132, 140, 148, 156, 255, 255,
+    },
+    [0x12] = {
+        29, 26, 31, 37, 44, 53, 19, 22, 23, 30, 39, 255,
+        9, 14, 18, 26, 35, 46, 0, 9, 16, 24, 33, 44,
+        7, 9, 18, 25, 32, 44, 14, 14, 23, 28, 34, 45,
+        21, 22, 29, 33, 37, 49, 28, 29, 36, 38, 41, 53,
+        35, 37, 43, 45, 47, 58, 42, 45, 51, 52, 53, 64,
+        51, 53, 58, 59, 59, 73, 61, 61, 66, 66, 66, 79,
+        71, 68, 74, 74, 73, 86, 81, 75, 79, 84, 84, 93,
+        92, 255, 255, 95, 97, 102, 100, 100, 255, 103, 105, 109,
+        108, 255, 255, 111, 113, 117, 122, 118, 119, 120, 122, 255,
+        126, 126, 127, 128, 130, 255, 134, 134, 135, 136, 138, 255,
+        255, 255, 142, 143, 146, 255, 126, 133, 141, 149, 255, 255,
+    },
+    [0x13] = {
+        26, 21, 24, 29, 35, 44, 17, 16, 14, 21, 30, 255,
+        9, 8, 9, 17, 26, 37, 9, 0, 9, 16, 24, 36,
+        14, 8, 14, 19, 25, 36, 20, 16, 22, 24, 28, 39,
+        26, 24, 29, 31, 33, 44, 33, 32, 37, 38, 38, 50,
+        40, 40, 45, 45, 45, 55, 47, 48, 53, 52, 52, 62,
+        56, 56, 61, 60, 59, 72, 65, 64, 68, 68, 66, 79,
+        75, 72, 76, 76, 74, 86, 85, 79, 81, 86, 85, 93,
+        96, 255, 255, 97, 99, 103, 104, 104, 255, 105, 107, 110,
+        112, 255, 255, 113, 115, 118, 126, 122, 122, 123, 124, 255,
+        130, 130, 130, 131, 132, 255, 138, 138, 138, 139, 140, 255,
+        255, 255, 146, 146, 148, 255, 127, 135, 143, 150, 255, 255,
+    },
+    [0x14] = {
+        33, 26, 27, 29, 34, 41, 25, 22, 16, 20, 27, 255,
+        18, 14, 8, 13, 21, 31, 16, 9, 0, 8, 17, 29,
+        17, 9, 8, 10, 16, 28, 21, 14, 16, 16, 19, 30,
+        26, 22, 24, 23, 24, 36, 32, 29, 32, 31, 31, 41,
+        38, 37, 40, 39, 38, 47, 45, 45, 48, 47, 45, 54,
+        53, 53, 56, 55, 52, 64, 63, 61, 64, 63, 60, 72,
+        73, 68, 72, 70, 68, 79, 83, 75, 77, 80, 80, 87,
+        93, 255, 255, 92, 93, 96, 101, 100, 255, 100, 101, 104,
+        109, 255, 255, 108, 109, 112, 123, 118, 118, 118, 119, 255,
+        127, 126, 126, 126, 127, 255, 135, 134, 134, 134, 135, 255,
+        255, 255, 143, 142, 143, 255, 121, 129, 137, 145, 255, 255,
+    },
+    [0x15] = {
+        36, 28, 26, 26, 29, 34, 29, 24, 16, 16, 22, 255,
+        25, 19, 10, 8, 14, 23, 24, 16, 8, 0, 9, 20,
+        26, 17, 13, 8, 9, 20, 29, 21, 20, 16, 14, 23,
+        33, 27, 27, 24, 22, 31, 38, 34, 35, 32, 29, 38,
+        44, 41, 43, 40, 37, 45, 50, 49, 51, 48, 45, 52,
+        58, 56, 59, 56, 53, 63, 67, 64, 66, 64, 61, 71,
+        77, 72, 74, 72, 68, 79, 86, 79, 79, 82, 80, 86,
+        97, 255, 255, 94, 94, 96, 105, 103, 255, 102, 102, 104,
+        113, 255, 255, 110, 110, 112, 126, 121, 120, 120, 120, 255,
+        130, 129, 128, 128, 128, 255, 138, 137, 136, 136, 136, 255,
+        255, 255, 145, 144, 144, 255, 122, 130, 137, 145, 255, 255,
+    },
+    [0x16] = {
+        39, 31, 26, 23, 24, 27, 35, 28, 19, 14, 16, 255,
+        32, 25, 16, 9, 8, 14, 33, 24, 17, 9, 0, 12,
+        35, 26, 21, 14, 8, 14, 38, 30, 27, 22, 16, 20,
+        42, 35, 34, 29, 24, 30, 47, 42, 41, 37, 32, 38,
+        52, 48, 49, 45, 40, 46, 58, 55, 56, 53, 48, 53,
+        65, 63, 64, 61, 56, 65, 74, 70, 72, 68, 64, 73,
+        83, 78, 80, 76, 72, 81, 93, 84, 85, 86, 84, 89,
+        103, 255, 255, 98, 98, 99, 111, 109, 255, 106, 106, 107,
+        118, 255, 255, 114, 114, 115, 132, 126, 125, 124, 124, 255,
+        136, 134, 133, 132, 132, 255, 144, 142, 141, 140, 140, 255,
+        255, 255, 151, 148, 148, 255, 125, 133, 141, 148, 255, 255,
+    },
+    [0x17] = {
+        50, 41, 35, 30, 27, 24, 46, 39, 30, 23, 20, 255,
+        44, 36, 28, 20, 14, 8, 44, 36, 29, 20, 12, 0,
+        46, 37, 31, 23, 14, 8, 48, 40, 36, 28, 20, 16,
+        52, 44, 41, 34, 27, 28, 56, 50, 47, 41, 34, 36,
+        60, 55, 54, 48, 42, 44, 65, 62, 61, 56, 49, 52,
+        72, 68, 68, 63, 57, 64, 80, 75, 75, 71, 65, 72,
+        89, 82, 83, 79, 73, 80, 97, 89, 88, 88, 85, 88,
+        107, 255, 255, 100, 99, 98, 115, 112, 255, 108, 107, 106,
+        122, 255, 255, 116, 115, 114, 135, 129, 127, 126, 125, 255,
+        139, 137, 135, 134, 133, 255, 147, 145, 143, 141, 141, 255,
+        255, 255, 153, 150, 148, 255, 124, 132, 140, 148, 255, 255,
+    },
+    [0x18] = {
+        36, 33, 38, 42, 49, 57, 26, 29, 28, 35, 43, 255,
+        16, 21, 22, 29, 38, 49, 7, 14, 17, 26, 35, 46,
+        0, 9, 16, 24, 32, 44, 7, 9, 18, 25, 32, 44,
+        14, 15, 23, 28, 34, 46, 21, 22, 30, 33, 37, 50,
+        28, 30, 37, 39, 42, 54, 35, 38, 44, 46, 47, 59,
+        44, 46, 52, 53, 54, 67, 54, 54, 59, 60, 60, 74,
+        64, 62, 67, 67, 67, 80, 74, 68, 72, 77, 78, 87,
+        85, 255, 255, 88, 91, 96, 93, 93, 255, 96, 98, 103,
+        101, 255, 255, 104, 106, 110, 115, 111, 112, 114, 116, 255,
+        119, 119, 120, 121, 123, 255, 127, 127, 128, 129, 131, 255,
+        255, 255, 135, 136, 139, 255, 119, 127, 134, 142, 255, 255,
+    },
+    [0x19] = {
+        34, 29, 32, 36, 42, 50, 24, 24, 22, 27, 35, 255,
+        15, 16, 14, 21, 30, 40, 9, 8, 9, 17, 26, 37,
+        9, 0, 9, 16, 24, 36, 13, 8, 14, 19, 25, 36,
+        19, 16, 22, 24, 28, 40, 25, 24, 29, 31, 33, 44,
+        32, 32, 37, 38, 38, 50, 39, 40, 45, 45, 45, 55,
+        48, 48, 53, 52, 52, 65, 58, 56, 61, 60, 59, 72,
+        67, 64, 68, 68, 66, 79, 77, 71, 73, 78, 78, 86,
+        88, 255, 255, 89, 91, 95, 96, 96, 255, 97, 99, 103,
+        104, 255, 255, 105, 107, 110, 118, 114, 114, 115, 116, 255,
+        122, 122, 122, 123, 124, 255, 130, 130, 130, 131, 132, 255,
+        255, 255, 138, 139, 140, 255, 120, 127, 135, 143, 255, 255,
+    },
+    [0x1a] = {
+        40, 34, 35, 37, 41, 47, 31, 30, 24, 27, 34, 255,
+        23, 22, 16, 20, 27, 36, 18, 14, 8, 13, 21, 31,
+        16, 9, 0, 8, 17, 29, 17, 9, 8, 10, 16, 28,
+        21, 14, 16, 16, 19, 31, 26, 22, 24, 23, 24, 36,
+        31, 29, 32, 31, 31, 41, 38, 37, 40, 39, 38, 47,
+        46, 45, 48, 47, 45, 57, 55, 53, 56, 55, 52, 64,
+        65, 61, 64, 63, 60, 72, 75, 67, 69, 72, 72, 79,
+        86, 255, 255, 84, 86, 89, 93, 92, 255, 92, 93, 96,
+        101, 255, 255, 100, 101, 104, 115, 110, 110, 110, 111, 255,
+        119, 118, 118, 118, 119, 255, 127, 126, 126, 126, 127, 255,
+        255, 255, 135, 134, 135, 255, 114, 121, 129, 137, 255, 255,
+    },
+    [0x1b] = {
+        42, 35, 34, 34, 37, 41, 35, 31, 23, 24, 29, 255,
+        28, 24, 16, 16, 22, 28, 25, 19, 10, 8, 14, 23,
+        24, 16, 8, 0, 9, 20, 25, 17, 13, 8, 9, 20,
+        28, 21, 20, 16, 14, 26, 33, 27, 27, 24, 22, 31,
+        38, 34, 35, 32, 29, 38, 43, 41, 43, 40, 37, 45,
+        51, 49, 51, 48, 45, 56, 60, 56, 59, 56, 53, 63,
+        69, 64, 66, 64, 61, 71, 79, 71, 71, 74, 72, 79,
+        89, 255, 255, 86, 86, 88, 97, 95, 255, 94, 94, 96,
+        105, 255, 255, 102, 102, 104, 118, 113, 112, 112, 112, 255,
+        122, 121, 120, 120, 120, 255, 130, 129, 128, 128, 128, 255,
+        255, 255, 137, 136, 136, 255, 114, 122, 130, 137, 255, 255,
+    },
+    [0x1c] = {
+        45, 36, 33, 31, 32, 34, 38, 33, 24, 22, 24, 255,
+        34, 28, 19, 14, 16, 20, 32, 25, 16, 9, 8, 14,
+        32, 24, 17, 9, 0, 12, 34, 26, 21, 14, 8, 14,
+        37, 30, 27, 22, 16, 23, 41, 35, 34, 29, 24, 30,
+        46, 42, 41, 37, 32, 38, 51, 48, 49, 45, 40, 46,
+        59, 55, 56, 53, 48, 57, 67, 63, 64, 61, 56, 65,
+        76, 70, 72, 68, 64, 73, 85, 77, 77, 78, 76, 81,
+        96, 255, 255, 90, 90, 91, 103, 101, 255, 98, 98, 99,
+        111, 255, 255, 106, 106, 107, 124, 118, 117, 116, 116, 255,
+        128, 126, 125, 124, 124, 255, 136, 134, 133, 132, 132, 255,
+        255, 255, 143, 141, 140, 255, 117, 125, 133, 141, 255, 255,
+    },
+    [0x1d] = {
+        54, 45, 40, 36, 34, 32, 49, 42, 33, 28, 27, 255,
+        45, 39, 30, 23, 20, 16, 44, 36, 28, 20, 14, 8,
+        44, 36, 29, 20, 12, 0, 46, 37, 31, 23, 14, 8,
+        48, 40, 36, 28, 20, 20, 51, 44, 41, 34, 27, 28,
+        55, 50, 47, 41, 34, 36, 59, 55, 54, 48, 42, 44,
+        66, 62, 61, 56, 49, 56, 74, 68, 68, 63, 57, 64,
+        82, 75, 75, 71, 65, 72, 90, 81, 80, 81, 77, 80,
+        100, 255, 255, 92, 91, 90, 107, 104, 255, 100, 99, 98,
+        115, 255, 255, 108, 107, 106, 128, 121, 119, 118, 117, 255,
+        132, 129, 127, 126, 125, 255, 139, 137, 135, 134, 133, 255,
+        255, 255, 146, 142, 141, 255, 116, 124, 132, 140, 255, 255,
+    },
+    [0x1e] = {
+        43, 40, 44, 48, 54, 62, 33, 35, 34, 40, 48, 255,
+        23, 27, 27, 34, 43, 52, 14, 20, 21, 29, 38, 48,
+        7, 13, 17, 25, 34, 46, 0, 8, 16, 24, 32, 44,
+        7, 10, 19, 25, 32, 45, 14, 16, 24, 29, 34, 47,
+        21, 23, 31, 34, 38, 50, 28, 31, 38, 40, 43, 54,
+        37, 39, 45, 47, 48, 62, 47, 47, 52, 54, 54, 68,
+        57, 55, 60, 61, 61, 74, 67, 62, 65, 70, 72, 81,
+        78, 255, 255, 82, 84, 90, 86, 86, 255, 89, 92, 97,
+        94, 255, 255, 97, 99, 104, 108, 104, 105, 107, 109, 255,
+        112, 112, 113, 115, 116, 255, 120, 120, 121, 122, 124, 255,
+        255, 255, 128, 130, 132, 255, 113, 120, 128, 135, 255, 255,
+    },
+    [0x1f] = {
+        42, 37, 40, 43, 48, 55, 32, 32, 29, 34, 42, 255,
+        22, 24, 22, 27, 35, 44, 14, 16, 14, 21, 30, 40,
+        9, 8, 9, 17, 26, 37, 8, 0, 9, 16, 24, 36,
+        12, 8, 14, 19, 25, 37, 18, 16, 22, 24, 28, 40,
+        24, 24, 29, 31, 33, 44, 31, 32, 37, 38, 38, 50,
+        40, 40, 45, 45, 45, 58, 50, 48, 53, 52, 52, 65,
+        60, 56, 61, 60, 59, 72, 69, 63, 65, 70, 70, 79,
+        80, 255, 255, 82, 84, 88, 88, 88, 255, 89, 91, 95,
+        96, 255, 255, 97, 99, 103, 110, 106, 106, 107, 109, 255,
+        114, 114, 114, 115, 116, 255, 122, 122, 122, 123, 124, 255,
+        255, 255, 130, 131, 132, 255, 112, 120, 127, 135, 255, 255,
+    },
+    [0x20] = {
+        48, 42, 43, 45, 49, 54, 38, 37, 32, 35, 41, 255,
+        30, 29, 24, 27, 34, 41, 23, 22, 16, 20, 27, 36,
+        18, 14, 8, 13, 21, 31, 16, 9, 0, 8, 17, 29,
+        17, 9, 8, 10, 16, 29, 20, 14, 16, 16, 19, 31,
+        25, 22, 24, 23, 24, 36, 31, 29, 32, 31, 31, 41,
+        38, 37, 40, 39, 38, 50, 48, 45, 48, 47, 45, 57,
+        57, 53, 56, 55, 52, 64, 67, 60, 61, 64, 64, 72,
+        78, 255, 255, 76, 78, 81, 86, 84, 255, 84, 86, 89,
+        93, 255, 255, 92, 93, 96, 107, 102, 102, 102, 103, 255,
+        111, 110, 110, 110, 111, 255, 119, 118, 118, 118, 119, 255,
+        255, 255, 127, 126, 127, 255, 106, 114, 121, 129, 255, 255,
+    },
+    [0x21] = {
+        49, 42, 42, 42, 45, 48, 41, 38, 31, 32, 37, 255,
+        33, 31, 23, 24, 29, 34, 28, 24, 16, 16, 22, 28,
+        25, 19, 10, 8, 14, 23, 24, 16, 8, 0, 9, 20,
+        25, 17, 13, 8, 9, 22, 28, 21, 20, 16, 14, 26,
+        32, 27, 27, 24, 22, 31, 37, 34, 35, 32, 29, 38,
+        44, 41, 43, 40, 37, 48, 53, 49, 51, 48, 45, 56,
+        62, 56, 59, 56, 53, 63, 71, 63, 64, 66, 64, 71,
+        82, 255, 255, 78, 78, 81, 89, 87, 255, 86, 86, 88,
+        97, 255, 255, 94, 94, 96, 111, 105, 104, 104, 104, 255,
+        115, 113, 112, 112, 112, 255, 122, 121, 120, 120, 120, 255,
+        255, 255, 130, 128, 128, 255, 106, 114, 122, 130, 255, 255,
+    },
+    [0x22] = {
+        50, 42, 40, 39, 40, 42, 43, 39, 31, 29, 32, 255,
+        37, 33, 24, 22, 24, 27, 34, 28, 19, 14, 16, 20,
+        32, 25, 16, 9, 8, 14, 32, 24, 17, 9, 0, 12,
+        34, 26, 21, 14, 8, 17, 37, 30, 27, 22, 16, 23,
+        41, 35, 34, 29, 24, 30, 45, 42, 41, 37, 32, 38,
+        52, 48, 49, 45, 40, 49, 60, 55, 56, 53, 48, 57,
+        69, 63, 64, 61, 56, 65, 78, 69, 69, 70, 68, 73,
+        88, 255, 255, 82, 82, 83, 96, 93, 255, 90, 90, 91,
+        103, 255, 255, 98, 98, 99, 116, 111, 109, 108, 108, 255,
+        120, 118, 117, 116, 116, 255, 128, 126, 125, 124, 124, 255,
+        255, 255, 135, 133, 132, 255, 109, 117, 125, 133, 255, 255,
+    },
+    [0x23] = {
+        59, 50, 46, 43, 42, 40, 53, 47, 38, 34, 34, 255,
+        48, 42, 33, 28, 27, 24, 45, 39, 30, 23, 20, 16,
+        44, 36, 28, 20, 14, 8, 44, 36, 29, 20, 12, 0,
+        45, 37, 31, 23, 14, 12, 48, 40, 36, 28, 20, 20,
+        51, 44, 41, 34, 27, 28, 54, 50, 47, 41, 34, 36,
+        60, 55, 54, 48, 42, 48, 67, 62, 61, 56, 49, 56,
+        75, 68, 68, 63, 57, 64, 84, 74, 73, 73, 69, 72,
+        93, 255, 255, 84, 83, 82, 100, 97, 255, 92, 91, 90,
+        107, 255, 255, 100, 99, 98, 120, 114, 112, 110, 109, 255,
+        124, 121, 119, 118, 117, 255, 132, 129, 127, 126, 125, 255,
+        255, 255, 138, 134, 133, 255, 108, 116, 124, 132, 255, 255,
+    },
+    [0x24] = {
+        50, 47, 51, 55, 60, 67, 40, 42, 40, 46, 54, 255,
+        30, 34, 33, 39, 47, 56, 21, 26, 26, 33, 42, 52,
+        14, 19, 21, 28, 37, 48, 7, 12, 17, 25, 34, 45,
+        0, 8, 16, 24, 32, 44, 7, 11, 19, 26, 32, 45,
+        14, 17, 25, 29, 35, 47, 21, 24, 31, 35, 38, 51,
+        30, 32, 38, 41, 43, 57, 40, 40, 46, 48, 49, 63,
+        50, 48, 53, 55, 55, 69, 60, 55, 58, 64, 65, 75,
+        71, 255, 255, 75, 78, 84, 79, 79, 255, 83, 85, 90,
+        87, 255, 255, 90, 93, 97, 101, 97, 98, 100, 102, 255,
+        105, 105, 106, 108, 110, 255, 113, 113, 114, 116, 117, 255,
+        255, 255, 121, 123, 125, 255, 107, 114, 121, 129, 255, 255,
+    },
+    [0x25] = {
+        50, 45, 48, 51, 55, 62, 40, 40, 37, 41, 48, 255,
+        30, 32, 29, 34, 42, 50, 22, 24, 22, 27, 35, 44,
+        15, 16, 14, 21, 30, 40, 10, 8, 9, 17, 26, 37,
+        8, 0, 9, 16, 24, 36, 11, 8, 14, 19, 25, 37,
+        17, 16, 22, 24, 28, 40, 23, 24, 29, 31, 33, 44,
+        32, 32, 37, 38, 38, 52, 42, 40, 45, 45, 45, 58,
+        52, 48, 53, 52, 52, 65, 62, 55, 58, 62, 63, 72,
+        72, 255, 255, 74, 76, 80, 80, 80, 255, 82, 84, 88,
+        88, 255, 255, 89, 91, 95, 102, 98, 98, 99, 101, 255,
+        106, 106, 106, 107, 109, 255, 114, 114, 114, 115, 116, 255,
+        255, 255, 122, 123, 124, 255, 104, 112, 120, 127, 255, 255,
+    },
+    [0x26] = {
+        55, 50, 51, 53, 56, 61, 46, 45, 40, 43, 49, 255,
+        37, 37, 32, 35, 41, 47, 29, 29, 24, 27, 34, 41,
+        23, 22, 16, 20, 27, 36, 19, 14, 8, 13, 21, 31,
+        16, 9, 0, 8, 17, 28, 16, 9, 8, 10, 16, 29,
+        19, 14, 16, 16, 19, 31, 24, 22, 24, 23, 24, 36,
+        31, 29, 32, 31, 31, 44, 40, 37, 40, 39, 38, 50,
+        50, 45, 48, 47, 45, 57, 59, 52, 53, 57, 56, 64,
+        70, 255, 255, 68, 70, 74, 78, 76, 255, 76, 78, 81,
+        86, 255, 255, 84, 86, 89, 99, 94, 94, 94, 95, 255,
+        103, 102, 102, 102, 103, 255, 111, 110, 110, 110, 111, 255,
+        255, 255, 119, 118, 119, 255, 98, 106, 114, 121, 255, 255,
+    },
+    [0x27] = {
+        56, 50, 50, 50, 53, 56, 48, 45, 39, 40, 45, 255,
+        39, 38, 31, 32, 37, 41, 33, 31, 23, 24, 29, 34,
+        28, 24, 16, 16, 22, 28, 25, 19, 10, 8, 14, 23,
+        24, 16, 8, 0, 9, 20, 25, 17, 13, 8, 9, 22,
+        27, 21, 20, 16, 14, 26, 31, 27, 27, 24, 22, 31,
+        38, 34, 35, 32, 29, 41, 46, 41, 43, 40, 37, 48,
+        55, 49, 51, 48, 45, 56, 64, 55, 56, 58, 57, 63,
+        74, 255, 255, 70, 70, 73, 82, 80, 255, 78, 78, 81,
+        89, 255, 255, 86, 86, 88, 103, 97, 96, 96, 96, 255,
+        107, 105, 104, 104, 104, 255, 115, 113, 112, 112, 112, 255,
+        255, 255, 122, 120, 120, 255, 98, 106, 114, 122, 255, 255,
+    },
+    [0x28] = {
+        57, 49, 48, 47, 48, 49, 49, 45, 38, 37, 40, 255,
+        42, 38, 31, 29, 32, 34, 37, 33, 24, 22, 24, 27,
+        34, 28, 19, 14, 16, 20, 32, 25, 16, 9, 8, 14,
+        32, 24, 17, 9, 0, 13, 34, 26, 21, 14, 8, 17,
+        36, 30, 27, 22, 16, 23, 40, 35, 34, 29, 24, 30,
+        46, 42, 41, 37, 32, 42, 54, 48, 49, 45, 40, 49,
+        62, 55, 56, 53, 48, 57, 71, 62, 61, 63, 60, 65,
+        81, 255, 255, 74, 74, 75, 88, 85, 255, 82, 82, 83,
+        96, 255, 255, 90, 90, 91, 109, 103, 101, 100, 100, 255,
+        113, 111, 109, 108, 108, 255, 120, 118, 117, 116, 116, 255,
+        255, 255, 127, 125, 124, 255, 101, 109, 117, 125, 255, 255,
+    },
+    [0x29] = {
+        67, 59, 56, 54, 53, 52, 60, 56, 47, 45, 46, 255,
+        54, 50, 41, 38, 38, 36, 49, 44, 36, 31, 30, 28,
+        46, 40, 31, 26, 23, 20, 45, 37, 29, 22, 17, 12,
+        44, 36, 28, 20, 13, 0, 44, 36, 30, 22, 13, 8,
+        46, 39, 33, 26, 17, 16, 48, 42, 38, 31, 23, 24,
+        53, 47, 44, 38, 30, 36, 59, 52, 50, 45, 38, 44,
+        66, 58, 57, 52, 46, 52, 74, 64, 62, 61, 57, 60,
+        83, 255, 255, 73, 71, 70, 90, 86, 255, 81, 79, 78,
+        97, 255, 255, 88, 87, 86, 109, 103, 100, 98, 97, 255,
+        113, 110, 108, 106, 105, 255, 120, 118, 115, 114, 113, 255,
+        255, 255, 126, 122, 121, 255, 96, 104, 112, 120, 255, 255,
+    },
+    [0x2a] = {
+        57, 54, 57, 61, 66, 73, 47, 49, 47, 52, 59, 255,
+        37, 41, 39, 45, 53, 61, 28, 33, 32, 38, 47, 56,
+        21, 25, 26, 33, 41, 51, 14, 18, 20, 28, 37, 48,
+        7, 11, 16, 25, 34, 44, 0, 8, 16, 24, 32, 44,
+        7, 11, 20, 26, 33, 45, 14, 18, 26, 30, 35, 48,
+        23, 25, 32, 35, 39, 53, 33, 33, 39, 42, 44, 58,
+        43, 41, 47, 48, 50, 64, 53, 48, 52, 57, 59, 70,
+        64, 255, 255, 68, 72, 78, 72, 72, 255, 76, 79, 84,
+        80, 255, 255, 84, 86, 91, 94, 90, 91, 93, 96, 255,
+        98, 98, 99, 101, 103, 255, 106, 106, 107, 109, 111, 255,
+        255, 255, 114, 116, 118, 255, 100, 107, 115, 122, 255, 255,
+    },
+    [0x2b] = {
+        58, 53, 56, 58, 63, 68, 48, 48, 45, 49, 55, 255,
+        38, 40, 37, 41, 48, 55, 29, 32, 29, 34, 42, 50,
+        22, 24, 22, 27, 35, 44, 16, 16, 14, 21, 30, 40,
+        11, 8, 9, 17, 26, 36, 8, 0, 9, 16, 24, 36,
+        11, 8, 14, 19, 25, 37, 16, 16, 22, 24, 28, 40,
+        24, 24, 29, 31, 33, 47, 34, 32, 37, 38, 38, 52,
+        44, 40, 45, 45, 45, 58, 54, 47, 50, 54, 55, 65,
+        64, 255, 255, 66, 68, 73, 72, 72, 255, 74, 76, 80,
+        80, 255, 255, 82, 84, 88, 94, 90, 90, 91, 93, 255,
+        98, 98, 98, 99, 101, 255, 106, 106, 106, 107, 109, 255,
+        255, 255, 114, 115, 116, 255, 97, 104, 112, 120, 255, 255,
+    },
+    [0x2c] = {
+        63, 58, 59, 61, 64, 68, 53, 53, 48, 51, 56, 255,
+        44, 45, 40, 43, 49, 54, 36, 37, 32, 35, 41, 47,
+        30, 29, 24, 27, 34, 41, 24, 22, 16, 20, 27, 36,
+        19, 14, 8, 13, 21, 30, 16, 9, 0, 8, 17, 28,
+        16, 9, 8, 10, 16, 29, 19, 14, 16, 16, 19, 31,
+        25, 22, 24, 23, 24, 38, 33, 29, 32, 31, 31, 44,
+        42, 37, 40, 39, 38, 50, 52, 44, 45, 49, 49, 57,
+        62, 255, 255, 61, 62, 66, 70, 68, 255, 68, 70, 74,
+        78, 255, 255, 76, 78, 81, 91, 86, 86, 86, 87, 255,
+        95, 94, 94, 94, 95, 255, 103, 102, 102, 102, 103, 255,
+        255, 255, 111, 110, 111, 255, 90, 98, 106, 114, 255, 255,
+    },
+    [0x2d] = {
+        64, 57, 58, 58, 61, 63, 55, 53, 47, 48, 53, 255,
+        46, 45, 39, 40, 45, 48, 38, 38, 31, 32, 37, 41,
+        33, 31, 23, 24, 29, 34, 29, 24, 16, 16, 22, 28,
+        26, 19, 10, 8, 14, 22, 24, 16, 8, 0, 9, 20,
+        25, 17, 13, 8, 9, 22, 27, 21, 20, 16, 14, 26,
+        32, 27, 27, 24, 22, 34, 39, 34, 35, 32, 29, 41,
+        48, 41, 43, 40, 37, 48, 56, 48, 48, 50, 49, 56,
+        66, 255, 255, 62, 63, 65, 74, 72, 255, 70, 70, 73,
+        82, 255, 255, 78, 78, 81, 95, 89, 88, 88, 88, 255,
+        99, 97, 96, 96, 96, 255, 107, 105, 104, 104, 104, 255,
+        255, 255, 114, 112, 112, 255, 90, 98, 106, 114, 255, 255,
+    },
+    [0x2e] = {
+        64, 56, 55, 55, 56, 57, 55, 52, 45, 45, 48, 255,
+        47, 45, 38, 37, 40, 42, 41, 38, 31, 29, 32, 34,
+        37, 33, 24, 22, 24, 27, 34, 28, 19, 14, 16, 20,
+        32, 25, 16, 9, 8, 13, 32, 24, 17, 9, 0, 13,
+        33, 26, 21, 14, 8, 17, 36, 30, 27, 22, 16, 23,
+        41, 35, 34, 29, 24, 34, 47, 42, 41, 37, 32, 42,
+        55, 48, 49, 45, 40, 49, 64, 55, 53, 55, 52, 57,
+        73, 255, 255, 66, 66, 67, 81, 78, 255, 74, 74, 75,
+        88, 255, 255, 82, 82, 83, 101, 95, 93, 92, 92, 255,
+        105, 103, 101, 100, 100, 255, 113, 111, 109, 108, 108, 255,
+        255, 255, 119, 117, 116, 255, 93, 101, 109, 117, 255, 255,
+    },
+    [0x2f] = {
+        74, 66, 64, 61, 61, 60, 66, 62, 54, 52, 53, 255,
+        59, 55, 47, 45, 46, 44, 53, 50, 41, 38, 38, 36,
+        50, 44, 36, 31, 30, 28, 47, 40, 31, 26, 23, 20,
+        45, 37, 29, 22, 17, 8, 44, 36, 28, 20, 13, 0,
+        44, 36, 30, 22, 13, 8, 46, 39, 33, 26, 17, 16,
+        49, 42, 38, 31, 23, 28, 54, 47, 44, 38, 30, 36,
+        60, 52, 50, 45, 38, 44, 67, 58, 55, 54, 49, 52,
+        76, 255, 255, 65, 63, 62, 83, 79, 255, 73, 71, 70,
+        90, 255, 255, 81, 79, 78, 102, 95, 92, 90, 89, 255,
+        106, 103, 100, 98, 97, 255, 113, 110, 108, 106, 105, 255,
+        255, 255, 119, 115, 113, 255, 88, 96, 104, 112, 255, 255,
+    },
+    [0x30] = {
+        64, 61, 64, 67, 72, 78, 54, 56, 53, 58, 65, 255,
+        44, 48, 46, 51, 59, 66, 35, 40, 38, 44, 52, 60,
+        28, 32, 31, 38, 46, 55, 21, 24, 25, 32, 41, 51,
+        14, 17, 19, 27, 36, 46, 7, 11, 16, 25, 33, 44,
+        0, 8, 17, 24, 32, 44, 7, 12, 21, 26, 33, 45,
+        16, 19, 26, 31, 35, 50, 26, 26, 33, 36, 39, 54,
+        36, 34, 40, 42, 45, 59, 46, 41, 45, 51, 54, 64,
+        57, 255, 255, 62, 65, 72, 65, 65, 255, 69, 72, 78,
+        73, 255, 255, 77, 80, 85, 87, 83, 85, 86, 89, 255,
+        91, 91, 92, 94, 96, 255, 99, 99, 100, 102, 104, 255,
+        255, 255, 107, 109, 112, 255, 94, 101, 108, 116, 255, 255,
+    },
+    [0x31] = {
+        65, 61, 64, 66, 70, 75, 56, 56, 53, 56, 63, 255,
+        46, 48, 45, 49, 55, 62, 37, 40, 37, 41, 48, 55,
+        30, 32, 29, 34, 42, 50, 23, 24, 22, 27, 35, 44,
+        17, 16, 14, 21, 30, 39, 11, 8, 9, 17, 26, 36,
+        8, 0, 9, 16, 24, 36, 10, 8, 14, 19, 25, 37,
+        17, 16, 22, 24, 28, 42, 26, 24, 29, 31, 33, 47,
+        36, 32, 37, 38, 38, 52, 46, 39, 42, 47, 48, 58,
+        57, 255, 255, 58, 61, 67, 64, 64, 255, 66, 68, 73,
+        72, 255, 255, 74, 76, 80, 86, 82, 82, 84, 85, 255,
+        90, 90, 90, 91, 93, 255, 98, 98, 98, 99, 101, 255,
+        255, 255, 106, 107, 109, 255, 90, 97, 104, 112, 255, 255,
+    },
+    [0x32] = {
+        71, 65, 67, 68, 72, 75, 61, 61, 56, 59, 64, 255,
+        52, 53, 48, 51, 56, 61, 43, 45, 40, 43, 49, 54,
+        37, 37, 32, 35, 41, 47, 31, 29, 24, 27, 34, 41,
+        25, 22, 16, 20, 27, 33, 20, 14, 8, 13, 21, 30,
+        17, 9, 0, 8, 17, 28, 16, 9, 8, 10, 16, 29,
+        19, 14, 16, 16, 19, 33, 26, 22, 24, 23, 24, 38,
+        35, 29, 32, 31, 31, 44, 44, 36, 37, 41, 41, 50,
+        54, 255, 255, 53, 54, 59, 62, 61, 255, 61, 62, 66,
+        70, 255, 255, 68, 70, 74, 84, 78, 78, 78, 80, 255,
+        87, 86, 86, 86, 87, 255, 95, 94, 94, 94, 95, 255,
+        255, 255, 103, 102, 103, 255, 83, 90, 98, 106, 255, 255,
+    },
+    [0x33] = {
+        71, 65, 65, 66, 68, 71, 62, 61, 55, 56, 61, 255,
+        53, 52, 47, 48, 53, 56, 45, 45, 39, 40, 45, 48,
+        39, 38, 31, 32, 37, 41, 34, 31, 23, 24, 29, 34,
+        29, 24, 16, 16, 22, 26, 26, 19, 10, 8, 14, 22,
+        24, 16, 8, 0, 9, 20, 24, 17, 13, 8, 9, 22,
+        27, 21, 20, 16, 14, 28, 33, 27, 27, 24, 22, 34,
+        41, 34, 35, 32, 29, 41, 49, 40, 40, 42, 41, 48,
+        59, 255, 255, 54, 55, 58, 66, 64, 255, 62, 63, 65,
+        74, 255, 255, 70, 70, 73, 87, 82, 80, 80, 80, 255,
+        91, 89, 88, 88, 88, 255, 99, 97, 96, 96, 96, 255,
+        255, 255, 106, 104, 104, 255, 82, 90, 98, 106, 255, 255,
+    },
+    [0x34] = {
+        71, 64, 63, 63, 64, 65, 62, 60, 52, 53, 56, 255,
+        54, 52, 45, 45, 48, 49, 47, 45, 38, 37, 40, 42,
+        42, 38, 31, 29, 32, 34, 38, 33, 24, 22, 24, 27,
+        35, 28, 19, 14, 16, 17, 33, 25, 16, 9, 8, 13,
+        32, 24, 17, 9, 0, 13, 33, 26, 21, 14, 8, 17,
+        36, 30, 27, 22, 16, 27, 42, 35, 34, 29, 24, 34,
+        49, 42, 41, 37, 32, 42, 57, 48, 46, 47, 44, 49,
+        66, 255, 255, 59, 58, 59, 73, 70, 255, 66, 66, 67,
+        81, 255, 255, 74, 74, 75, 94, 87, 86, 84, 84, 255,
+        97, 95, 93, 92, 92, 255, 105, 103, 101, 100, 100, 255,
+        255, 255, 112, 109, 108, 255, 85, 93, 101, 109, 255, 255,
+    },
+    [0x35] = {
+        80, 73, 71, 69, 69, 68, 72, 69, 61, 59, 61, 255,
+        64, 62, 54, 52, 53, 52, 58, 55, 47, 45, 46, 44,
+        54, 50, 41, 38, 38, 36, 50, 44, 36, 31, 30, 28,
+        47, 40, 31, 26, 23, 16, 45, 37, 29, 22, 17, 8,
+        44, 36, 28, 20, 13, 0, 44, 36, 30, 22, 13, 8,
+        46, 39, 33, 26, 17, 20, 50, 42, 38, 31, 23, 28,
+        55, 47, 44, 38, 30, 36, 62, 52, 48, 47, 42, 44,
+        70, 255, 255, 58, 55, 54, 76, 72, 255, 65, 63, 62,
+        83, 255, 255, 73, 71, 70, 95, 88, 85, 82, 81, 255,
+        98, 95, 92, 90, 89, 255, 106, 103, 100, 98, 97, 255,
+        255, 255, 111, 107, 105, 255, 80, 88, 96, 104, 255, 255,
+    },
+    [0x36] = {
+        71, 67, 71, 74, 79, 84, 61, 63, 60, 65, 72, 255,
+        51, 55, 52, 57, 64, 71, 42, 47, 45, 50, 58, 65,
+        35, 39, 38, 43, 51, 59, 28, 31, 31, 37, 45, 54,
+        21, 23, 24, 31, 40, 48, 14, 16, 19, 27, 36, 46,
+        7, 10, 16, 24, 33, 44, 0, 8, 17, 24, 32, 44,
+        9, 13, 21, 27, 33, 47, 19, 20, 27, 31, 36, 50,
+        29, 27, 34, 37, 40, 54, 39, 34, 38, 45, 48, 59,
+        50, 255, 255, 55, 59, 67, 58, 59, 255, 63, 66, 73,
+        66, 255, 255, 70, 73, 79, 80, 76, 78, 80, 82, 255,
+        84, 84, 86, 87, 90, 255, 92, 92, 93, 95, 97, 255,
+        255, 255, 100, 102, 105, 255, 88, 95, 102, 109, 255, 255,
+    },
+    [0x37] = {
+        73, 69, 71, 74, 78, 82, 64, 64, 61, 64, 70, 255,
+        54, 56, 53, 56, 63, 68, 45, 48, 45, 49, 55, 62,
+        38, 40, 37, 41, 48, 55, 31, 32, 29, 34, 42, 50,
+        24, 24, 22, 27, 35, 42, 18, 16, 14, 21, 30, 39,
+        12, 8, 9, 17, 26, 36, 8, 0, 9, 16, 24, 36,
+        11, 8, 14, 19, 25, 39, 19, 16, 22, 24, 28, 42,
+        28, 24, 29, 31, 33, 47, 38, 31, 34, 39, 42, 52,
+        49, 255, 255, 51, 54, 60, 57, 56, 255, 58, 61, 67,
+        64, 255, 255, 66, 68, 73, 78, 74, 74, 76, 78, 255,
+        82, 82, 82, 84, 85, 255, 90, 90, 90, 91, 93, 255,
+        255, 255, 98, 99, 101, 255, 82, 90, 97, 104, 255, 255,
+    },
+    [0x38] = {
+        79, 73, 75, 76, 80, 83, 69, 69, 64, 66, 72, 255,
+        59, 61, 56, 59, 64, 68, 51, 53, 48, 51, 56, 61,
+        44, 45, 40, 43, 49, 54, 38, 37, 32, 35, 41, 47,
+        31, 29, 24, 27, 34, 38, 26, 22, 16, 20, 27, 33,
+        21, 14, 8, 13, 21, 30, 17, 9, 0, 8, 17, 28,
+        16, 9, 8, 10, 16, 30, 21, 14, 16, 16, 19, 33,
+        28, 22, 24, 23, 24, 38, 37, 28, 29, 33, 34, 44,
+        47, 255, 255, 45, 47, 52, 54, 53, 255, 53, 54, 59,
+        62, 255, 255, 61, 62, 66, 76, 70, 70, 70, 72, 255,
+        80, 78, 78, 78, 80, 255, 87, 86, 86, 86, 87, 255,
+        255, 255, 95, 94, 95, 255, 75, 83, 90, 98, 255, 255,
+    },
+    [0x39] = {
+        79, 73, 73, 74, 76, 79, 69, 68, 63, 64, 68, 255,
+        60, 60, 55, 56, 61, 63, 52, 52, 47, 48, 53, 56,
+        46, 45, 39, 40, 45, 48, 40, 38, 31, 32, 37, 41,
+        35, 31, 23, 24, 29, 31, 30, 24, 16, 16, 22, 26,
+        26, 19, 10, 8, 14, 22, 24, 16, 8, 0, 9, 20,
+        25, 17, 13, 8, 9, 23, 28, 21, 20, 16, 14, 28,
+        35, 27, 27, 24, 22, 34, 42, 33, 32, 34, 33, 41,
+        52, 255, 255, 46, 47, 50, 59, 56, 255, 54, 55, 58,
+        66, 255, 255, 62, 63, 65, 80, 74, 72, 72, 72, 255,
+        84, 82, 80, 80, 80, 255, 91, 89, 88, 88, 88, 255,
+        255, 255, 98, 96, 96, 255, 75, 82, 90, 98, 255, 255,
+    },
+    [0x3a] = {
+        78, 71, 71, 70, 72, 73, 69, 67, 60, 61, 64, 255,
+        60, 59, 52, 53, 56, 57, 53, 52, 45, 45, 48, 49,
+        47, 45, 38, 37, 40, 42, 43, 38, 31, 29, 32, 34,
+        38, 33, 24, 22, 24, 23, 35, 28, 19, 14, 16, 17,
+        33, 25, 16, 9, 8, 13, 32, 24, 17, 9, 0, 13,
+        33, 26, 21, 14, 8, 20, 37, 30, 27, 22, 16, 27,
+        43, 35, 34, 29, 24, 34, 50, 41, 38, 39, 36, 42,
+        59, 255, 255, 51, 50, 51, 66, 63, 255, 59, 58, 59,
+        73, 255, 255, 66, 66, 67, 86, 80, 78, 76, 76, 255,
+        90, 87, 86, 84, 84, 255, 97, 95, 93, 92, 92, 255,
+        255, 255, 104, 101, 100, 255, 77, 85, 93, 101, 255, 255,
+    },
+    [0x3b] = {
+        87, 80, 78, 77, 77, 76, 78, 76, 68, 67, 69, 255,
+        70, 68, 61, 59, 61, 60, 64, 62, 54, 52, 53, 52,
+        59, 55, 47, 45, 46, 44, 54, 50, 41, 38, 38, 36,
+        51, 44, 36, 31, 30, 24, 48, 40, 31, 26, 23, 16,
+        45, 37, 29, 22, 17, 8, 44, 36, 28, 20, 13, 0,
+        44, 36, 30, 22, 13, 12, 46, 39, 33, 26, 17, 20,
+        51, 42, 38, 31, 23, 28, 56, 46, 42, 39, 34, 36,
+        64, 255, 255, 50, 48, 46, 70, 65, 255, 58, 55, 54,
+        76, 255, 255, 65, 63, 62, 88, 80, 77, 75, 73, 255,
+        91, 88, 85, 82, 81, 255, 98, 95, 92, 90, 89, 255,
+        255, 255, 104, 99, 97, 255, 72, 80, 88, 96, 255, 255,
+    },
+    [0x3c] = {
+        80, 76, 80, 83, 87, 92, 70, 72, 69, 73, 80, 255,
+        60, 64, 61, 66, 72, 78, 51, 56, 53, 58, 65, 72,
+        44, 48, 46, 51, 59, 66, 37, 40, 38, 44, 52, 60,
+        30, 32, 31, 38, 46, 53, 23, 24, 25, 32, 41, 49,
+        16, 17, 19, 27, 36, 46, 9, 11, 16, 25, 33, 44,
+        0, 8, 17, 24, 32, 45, 10, 12, 21, 26, 33, 46,
+        20, 19, 26, 31, 35, 50, 30, 25, 31, 38, 42, 54,
+        41, 255, 255, 48, 52, 60, 49, 50, 255, 55, 59, 66,
+        57, 255, 255, 62, 65, 72, 71, 67, 69, 71, 74, 255,
+        75, 75, 77, 79, 82, 255, 83, 83, 85, 86, 89, 255,
+        255, 255, 91, 93, 96, 255, 80, 87, 94, 101, 255, 255,
+    },
+    [0x3d] = {
+        81, 77, 79, 82, 85, 90, 71, 72, 68, 72, 78, 255,
+        62, 64, 61, 64, 70, 75, 53, 56, 53, 56, 63, 68,
+        46, 48, 45, 49, 55, 62, 39, 40, 37, 41, 48, 55,
+        32, 32, 29, 34, 42, 47, 25, 24, 22, 27, 35, 42,
+        19, 16, 14, 21, 30, 39, 13, 8, 9, 17, 26, 36,
+        8, 0, 9, 16, 24, 36, 12, 8, 14, 19, 25, 39,
+        21, 16, 22, 24, 28, 42, 30, 23, 26, 32, 35, 47,
+        41, 255, 255, 43, 47, 54, 49, 48, 255, 51, 54, 60,
+        57, 255, 255, 58, 61, 67, 70, 66, 66, 68, 70, 255,
+        74, 74, 74, 76, 78, 255, 82, 82, 82, 84, 85, 255,
+        255, 255, 90, 91, 93, 255, 75, 82, 90, 97, 255, 255,
+    },
+    [0x3e] = {
+        86, 81, 83, 84, 87, 90, 77, 77, 72, 74, 80, 255,
+        67, 68, 64, 66, 72, 75, 58, 61, 56, 59, 64, 68,
+        52, 53, 48, 51, 56, 61, 45, 45, 40, 43, 49, 54,
+        38, 37, 32, 35, 41, 44, 32, 29, 24, 27, 34, 38,
+        26, 22, 16, 20, 27, 33, 21, 14, 8, 13, 21, 30,
+        17, 9, 0, 8, 17, 28, 17, 9, 8, 10, 16, 30,
+        22, 14, 16, 16, 19, 33, 30, 21, 21, 25, 27, 38,
+        39, 255, 255, 37, 39, 46, 47, 45, 255, 45, 47, 52,
+        54, 255, 255, 53, 54, 59, 68, 63, 62, 63, 64, 255,
+        72, 70, 70, 70, 72, 255, 80, 78, 78, 78, 80, 255,
+        255, 255, 87, 86, 87, 255, 68, 75, 83, 90, 255, 255,
+    },
+    [0x3f] = {
+        86, 81, 81, 82, 84, 86, 77, 76, 70, 72, 76, 255,
+        67, 68, 63, 64, 68, 71, 59, 60, 55, 56, 61, 63,
+        53, 52, 47, 48, 53, 56, 47, 45, 39, 40, 45, 48,
+        41, 38, 31, 32, 37, 38, 35, 31, 23, 24, 29, 31,
+        31, 24, 16, 16, 22, 26, 27, 19, 10, 8, 14, 22,
+        24, 16, 8, 0, 9, 20, 25, 17, 13, 8, 9, 23,
+        29, 21, 20, 16, 14, 28, 36, 26, 24, 26, 25, 34,
+        45, 255, 255, 38, 39, 43, 52, 49, 255, 46, 47, 50,
+        59, 255, 255, 54, 55, 58, 72, 66, 64, 64, 64, 255,
+        76, 74, 72, 72, 72, 255, 84, 82, 80, 80, 80, 255,
+        255, 255, 90, 88, 88, 255, 67, 75, 82, 90, 255, 255,
+    },
+    [0x40] = {
+        85, 79, 79, 78, 80, 81, 76, 74, 68, 68, 72, 255,
+        67, 66, 60, 61, 64, 65, 59, 59, 52, 53, 56, 57,
+        54, 52, 45, 45, 48, 49, 48, 45, 38, 37, 40, 42,
+        43, 38, 31, 29, 32, 30, 39, 33, 24, 22, 24, 23,
+        35, 28, 19, 14, 16, 17, 33, 25, 16, 9, 8, 13,
+        32, 24, 17, 9, 0, 14, 34, 26, 21, 14, 8, 20,
+        38, 30, 27, 22, 16, 27, 45, 35, 31, 31, 28, 34,
+        53, 255, 255, 43, 42, 44, 59, 55, 255, 51, 50, 51,
+        66, 255, 255, 59, 58, 59, 79, 72, 70, 68, 68, 255,
+        82, 80, 78, 76, 76, 255, 90, 87, 86, 84, 84, 255,
+        255, 255, 96, 93, 92, 255, 69, 77, 85, 93, 255, 255,
+    },
+    [0x41] = {
+        97, 90, 89, 88, 89, 88, 89, 86, 79, 79, 81, 255,
+        80, 79, 72, 71, 73, 72, 73, 72, 64, 63, 65, 64,
+        67, 65, 57, 56, 57, 56, 62, 58, 50, 48, 49, 48,
+        57, 52, 44, 41, 42, 36, 53, 47, 38, 34, 34, 28,
+        50, 42, 33, 28, 27, 20, 47, 39, 30, 23, 20, 12,
+        45, 36, 28, 20, 14, 0, 44, 36, 29, 20, 12, 8,
+        46, 37, 31, 23, 14, 16, 50, 40, 34, 30, 23, 24,
+        56, 255, 255, 39, 36, 34, 61, 55, 255, 47, 44, 42,
+        67, 255, 255, 54, 51, 50, 78, 70, 66, 63, 61, 255,
+        81, 77, 74, 71, 69, 255, 88, 84, 81, 79, 77, 255,
+        255, 255, 93, 87, 85, 255, 60, 68, 76, 84, 255, 255,
+    },
+    [0x42] = {
+        90, 86, 89, 92, 96, 101, 80, 82, 79, 83, 89, 255,
+        70, 73, 71, 75, 82, 87, 61, 65, 63, 67, 74, 80,
+        54, 58, 55, 60, 67, 74, 47, 50, 48, 53, 60, 67,
+        40, 42, 40, 46, 54, 59, 33, 34, 33, 39, 47, 54,
+        26, 26, 26, 33, 42, 50, 19, 19, 21, 28, 37, 46,
+        10, 12, 17, 25, 34, 44, 0, 8, 16, 24, 32, 44,
+        10, 11, 19, 26, 32, 46, 20, 16, 23, 31, 36, 49,
+        31, 255, 255, 39, 45, 54, 39, 40, 255, 46, 50, 59,
+        47, 255, 255, 53, 57, 64, 61, 58, 59, 62, 65, 255,
+        65, 65, 67, 69, 72, 255, 73, 73, 75, 77, 80, 255,
+        255, 255, 81, 83, 87, 255, 72, 78, 85, 92, 255, 255,
+    },
+    [0x43] = {
+        89, 85, 87, 89, 93, 97, 79, 80, 76, 80, 85, 255,
+        69, 72, 68, 72, 78, 82, 61, 64, 61, 64, 70, 75,
+        54, 56, 53, 56, 63, 68, 47, 48, 45, 49, 55, 62,
+        40, 40, 37, 41, 48, 52, 33, 32, 29, 34, 42, 47,
+        26, 24, 22, 27, 35, 42, 20, 16, 14, 21, 30, 39,
+        12, 8, 9, 17, 26, 36, 8, 0, 9, 16, 24, 36,
+        14, 8, 14, 19, 25, 39, 22, 15, 19, 26, 30, 42,
+        33, 255, 255, 36, 40, 48, 41, 40, 255, 43, 47, 54,
+        49, 255, 255, 51, 54, 60, 63, 58, 59, 60, 63, 255,
+        66, 66, 66, 68, 70, 255, 74, 74, 74, 76, 78, 255,
+        255, 255, 82, 83, 85, 255, 68, 75, 82, 90, 255, 255,
+    },
+    [0x44] = {
+        94, 89, 91, 92, 95, 98, 85, 85, 80, 82, 87, 255,
+        75, 76, 72, 74, 80, 83, 66, 68, 64, 66, 72, 75,
+        59, 61, 56, 59, 64, 68, 52, 53, 48, 51, 56, 61,
+        46, 45, 40, 43, 49, 50, 39, 37, 32, 35, 41, 44,
+        33, 29, 24, 27, 34, 38, 27, 22, 16, 20, 27, 33,
+        21, 14, 8, 13, 21, 29, 16, 9, 0, 8, 17, 28,
+        17, 9, 8, 10, 16, 30, 23, 14, 13, 18, 21, 33,
+        32, 255, 255, 29, 32, 40, 39, 37, 255, 37, 39, 46,
+        47, 255, 255, 45, 47, 52, 60, 55, 54, 55, 56, 255,
+        64, 63, 62, 63, 64, 255, 72, 70, 70, 70, 72, 255,
+        255, 255, 79, 78, 80, 255, 61, 68, 75, 83, 255, 255,
+    },
+    [0x45] = {
+        94, 88, 89, 90, 92, 94, 84, 84, 78, 80, 84, 255,
+        75, 76, 70, 72, 76, 79, 66, 68, 63, 64, 68, 71,
+        60, 60, 55, 56, 61, 63, 54, 52, 47, 48, 53, 56,
+        48, 45, 39, 40, 45, 45, 42, 38, 31, 32, 37, 38,
+        36, 31, 23, 24, 29, 31, 31, 24, 16, 16, 22, 26,
+        26, 19, 10, 8, 14, 20, 24, 16, 8, 0, 9, 20,
+        26, 17, 13, 8, 9, 23, 31, 21, 17, 18, 18, 28,
+        38, 255, 255, 30, 31, 36, 45, 41, 255, 38, 39, 43,
+        52, 255, 255, 46, 47, 50, 65, 58, 57, 56, 57, 255,
+        68, 66, 64, 64, 64, 255, 76, 74, 72, 72, 72, 255,
+        255, 255, 82, 80, 80, 255, 59, 67, 75, 82, 255, 255,
+    },
+    [0x46] = {
+        93, 86, 86, 86, 88, 89, 83, 82, 76, 76, 80, 255,
+        74, 74, 68, 68, 72, 73, 66, 66, 60, 61, 64, 65,
+        60, 59, 52, 53, 56, 57, 54, 52, 45, 45, 48, 49,
+        49, 45, 38, 37, 40, 38, 44, 38, 31, 29, 32, 30,
+        39, 33, 24, 22, 24, 23, 36, 28, 19, 14, 16, 17,
+        33, 25, 16, 9, 8, 12, 32, 24, 17, 9, 0, 14,
+        35, 26, 21, 14, 8, 20, 39, 29, 25, 23, 20, 27,
+        47, 255, 255, 35, 34, 36, 53, 48, 255, 43, 42, 44,
+        59, 255, 255, 51, 50, 51, 72, 65, 62, 61, 60, 255,
+        75, 72, 70, 68, 68, 255, 82, 80, 78, 76, 76, 255,
+        255, 255, 89, 85, 84, 255, 61, 69, 77, 85, 255, 255,
+    },
+    [0x47] = {
+        105, 98, 97, 96, 97, 96, 96, 94, 87, 86, 89, 255,
+        87, 86, 79, 79, 81, 80, 79, 79, 72, 71, 73, 72,
+        74, 72, 64, 63, 65, 64, 68, 65, 57, 56, 57, 56,
+        63, 58, 50, 48, 49, 44, 58, 52, 44, 41, 42, 36,
+        54, 47, 38, 34, 34, 28, 50, 42, 33, 28, 27, 20,
+        46, 39, 30, 23, 20, 8, 44, 36, 28, 20, 14, 0,
+        44, 36, 29, 20, 12, 8, 46, 37, 30, 24, 17, 16,
+        51, 255, 255, 33, 29, 26, 56, 50, 255, 39, 36, 34,
+        61, 255, 255, 47, 44, 42, 71, 63, 59, 56, 53, 255,
+        74, 70, 66, 63, 61, 255, 81, 77, 74, 71, 69, 255,
+        255, 255, 86, 80, 77, 255, 52, 60, 68, 76, 255, 255,
+    },
+    [0x48] = {
+        100, 96, 99, 102, 106, 110, 90, 92, 88, 92, 98, 255,
+        80, 83, 81, 84, 91, 96, 71, 75, 73, 77, 83, 89,
+        64, 67, 65, 69, 76, 82, 57, 60, 57, 62, 69, 75,
+        50, 52, 50, 55, 62, 66, 43, 44, 42, 48, 55, 60,
+        36, 36, 35, 41, 49, 55, 29, 28, 28, 35, 43, 51,
+        20, 21, 22, 29, 38, 46, 10, 14, 17, 26, 35, 44,
+        0, 9, 16, 24, 32, 44, 10, 9, 17, 26, 33, 45,
+        21, 255, 255, 32, 38, 49, 29, 30, 255, 38, 43, 53,
+        37, 255, 255, 44, 49, 57, 51, 48, 50, 53, 57, 255,
+        55, 56, 57, 60, 64, 255, 63, 64, 65, 67, 71, 255,
+        255, 255, 71, 74, 78, 255, 64, 70, 77, 84, 255, 255,
+    },
+    [0x49] = {
+        97, 93, 95, 97, 101, 104, 87, 88, 84, 87, 93, 255,
+        77, 80, 76, 80, 85, 90, 68, 72, 68, 72, 78, 82,
+        62, 64, 61, 64, 70, 75, 55, 56, 53, 56, 63, 68,
+        48, 48, 45, 49, 55, 58, 41, 40, 37, 41, 48, 52,
+        34, 32, 29, 34, 42, 47, 27, 24, 22, 27, 35, 42,
+        19, 16, 14, 21, 30, 37, 11, 8, 9, 17, 26, 36,
+        9, 0, 9, 16, 24, 36, 15, 7, 12, 20, 26, 39,
+        25, 255, 255, 29, 34, 43, 33, 32, 255, 36, 40, 48,
+        41, 255, 255, 43, 47, 54, 55, 50, 51, 52, 55, 255,
+        59, 58, 59, 60, 63, 255, 66, 66, 66, 68, 70, 255,
+        255, 255, 74, 75, 78, 255, 62, 68, 75, 82, 255, 255,
+    },
+    [0x4a] = {
+        102, 97, 99, 100, 103, 106, 92, 93, 88, 90, 95, 255,
+        83, 84, 80, 82, 87, 90, 74, 76, 72, 74, 80, 83,
+        67, 68, 64, 66, 72, 75, 60, 61, 56, 59, 64, 68,
+        53, 53, 48, 51, 56, 57, 47, 45, 40, 43, 49, 50,
+        40, 37, 32, 35, 41, 44, 34, 29, 24, 27, 34, 38,
+        26, 22, 16, 20, 27, 31, 19, 14, 8, 13, 21, 29,
+        16, 9, 0, 8, 17, 28, 18, 9, 5, 11, 17, 30,
+        26, 255, 255, 22, 26, 34, 32, 29, 255, 29, 32, 40,
+        39, 255, 255, 37, 39, 46, 52, 47, 46, 47, 49, 255,
+        56, 55, 54, 55, 56, 255, 64, 63, 62, 63, 64, 255,
+        255, 255, 71, 70, 72, 255, 54, 61, 68, 75, 255, 255,
+    },
+    [0x4b] = {
+        102, 96, 97, 98, 100, 102, 92, 92, 86, 88, 92, 255,
+        83, 84, 78, 80, 84, 86, 74, 76, 70, 72, 76, 79,
+        67, 68, 63, 64, 68, 71, 61, 60, 55, 56, 61, 63,
+        55, 52, 47, 48, 53, 52, 48, 45, 39, 40, 45, 45,
+        42, 38, 31, 32, 37, 38, 37, 31, 23, 24, 29, 31,
+        31, 24, 16, 16, 22, 23, 26, 19, 10, 8, 14, 20,
+        24, 16, 8, 0, 9, 20, 26, 17, 11, 10, 11, 23,
+        33, 255, 255, 22, 23, 30, 38, 34, 255, 30, 31, 36,
+        45, 255, 255, 38, 39, 43, 57, 51, 49, 48, 49, 255,
+        61, 58, 57, 56, 57, 255, 68, 66, 64, 64, 64, 255,
+        255, 255, 75, 72, 72, 255, 52, 59, 67, 75, 255, 255,
+    },
+    [0x4c] = {
+        100, 94, 94, 94, 96, 97, 91, 90, 84, 84, 88, 255,
+        82, 82, 76, 76, 80, 81, 73, 74, 68, 68, 72, 73,
+        67, 66, 60, 61, 64, 65, 61, 59, 52, 53, 56, 57,
+        55, 52, 45, 45, 48, 46, 50, 45, 38, 37, 40, 38,
+        45, 38, 31, 29, 32, 30, 40, 33, 24, 22, 24, 23,
+        35, 28, 19, 14, 16, 14, 32, 25, 16, 9, 8, 12,
+        32, 24, 17, 9, 0, 14, 35, 26, 19, 16, 12, 20,
+        41, 255, 255, 27, 26, 29, 47, 42, 255, 35, 34, 36,
+        53, 255, 255, 43, 42, 44, 64, 57, 54, 53, 52, 255,
+        68, 65, 62, 61, 60, 255, 75, 72, 70, 68, 68, 255,
+        255, 255, 81, 77, 76, 255, 53, 61, 69, 77, 255, 255,
+    },
+    [0x4d] = {
+        112, 105, 105, 104, 105, 104, 103, 101, 94, 94, 97, 255,
+        94, 93, 87, 86, 89, 88, 86, 86, 79, 79, 81, 80,
+        80, 79, 72, 71, 73, 72, 74, 72, 64, 63, 65, 64,
+        69, 65, 57, 56, 57, 52, 64, 58, 50, 48, 49, 44,
+        59, 52, 44, 41, 42, 36, 54, 47, 38, 34, 34, 28,
+        50, 42, 33, 28, 27, 16, 46, 39, 30, 23, 20, 8,
+        44, 36, 28, 20, 14, 0, 45, 36, 28, 21, 13, 8,
+        48, 255, 255, 27, 22, 18, 51, 44, 255, 33, 29, 26,
+        56, 255, 255, 39, 36, 34, 65, 57, 52, 48, 46, 255,
+        68, 63, 59, 56, 53, 255, 74, 70, 66, 63, 61, 255,
+        255, 255, 79, 72, 69, 255, 44, 52, 60, 68, 255, 255,
+    },
+    [0x4e] = {
+        110, 106, 109, 112, 116, 119, 100, 102, 98, 102, 108, 255,
+        90, 93, 90, 94, 100, 105, 81, 85, 83, 86, 93, 97,
+        74, 77, 75, 79, 85, 90, 67, 69, 67, 71, 78, 84,
+        60, 62, 59, 64, 71, 74, 53, 54, 52, 56, 64, 67,
+        46, 46, 44, 49, 57, 62, 39, 38, 37, 42, 50, 56,
+        30, 30, 30, 36, 45, 50, 20, 22, 23, 31, 39, 46,
+        10, 15, 18, 26, 35, 45, 0, 10, 16, 24, 32, 44,
+        11, 255, 255, 26, 34, 45, 19, 21, 255, 31, 37, 48,
+        27, 255, 255, 36, 42, 52, 41, 38, 40, 44, 49, 255,
+        45, 46, 48, 51, 55, 255, 53, 54, 55, 58, 62, 255,
+        255, 255, 61, 64, 69, 255, 57, 63, 69, 75, 255, 255,
+    },
+    [0x4f] = {
+        104, 100, 102, 104, 108, 111, 94, 96, 91, 94, 100, 255,
+        84, 87, 83, 86, 92, 96, 75, 79, 75, 79, 84, 89,
+        68, 71, 67, 71, 77, 81, 62, 63, 60, 63, 69, 74,
+        55, 55, 52, 55, 62, 64, 48, 47, 44, 48, 55, 58,
+        41, 39, 36, 40, 48, 52, 34, 31, 28, 33, 41, 46,
+        25, 23, 21, 26, 35, 40, 16, 15, 14, 21, 29, 37,
+        9, 7, 9, 17, 26, 36, 10, 0, 8, 17, 24, 37,
+        19, 255, 255, 23, 29, 40, 26, 25, 255, 30, 35, 44,
+        34, 255, 255, 37, 41, 49, 48, 43, 44, 46, 49, 255,
+        52, 51, 52, 53, 56, 255, 60, 59, 60, 61, 64, 255,
+        255, 255, 67, 68, 71, 255, 56, 62, 69, 76, 255, 255,
+    },
+    [0x50] = {
+        107, 102, 104, 105, 108, 111, 97, 98, 93, 95, 100, 255,
+        87, 89, 85, 87, 92, 95, 79, 81, 77, 79, 85, 88,
+        72, 73, 69, 71, 77, 80, 65, 65, 61, 64, 69, 73,
+        58, 58, 53, 56, 61, 62, 52, 50, 45, 48, 53, 55,
+        45, 42, 37, 40, 46, 48, 38, 34, 29, 32, 38, 42,
+        31, 26, 21, 24, 31, 34, 23, 19, 13, 17, 25, 30,
+        17, 12, 5, 11, 19, 28, 16, 8, 0, 9, 16, 28,
+        22, 255, 255, 17, 22, 32, 28, 24, 255, 24, 28, 36,
+        35, 255, 255, 32, 35, 42, 48, 42, 41, 42, 44, 255,
+        52, 50, 49, 50, 52, 255, 59, 58, 57, 58, 59, 255,
+        255, 255, 66, 65, 67, 255, 50, 56, 64, 71, 255, 255,
+    },
+    [0x51] = {
+        112, 106, 107, 108, 110, 112, 102, 102, 96, 98, 102, 255,
+        92, 93, 88, 90, 94, 96, 84, 86, 80, 82, 86, 88,
+        77, 78, 72, 74, 78, 81, 70, 70, 64, 66, 70, 73,
+        64, 62, 57, 58, 63, 61, 57, 54, 49, 50, 55, 54,
+        51, 47, 41, 42, 47, 47, 45, 39, 33, 34, 39, 39,
+        38, 32, 25, 26, 31, 30, 31, 26, 18, 18, 23, 24,
+        26, 20, 11, 10, 16, 21, 24, 17, 9, 0, 8, 20,
+        27, 255, 255, 12, 14, 23, 31, 26, 255, 20, 22, 28,
+        37, 255, 255, 28, 29, 34, 48, 41, 39, 38, 39, 255,
+        52, 49, 47, 46, 47, 255, 59, 56, 55, 54, 55, 255,
+        255, 255, 65, 62, 63, 255, 43, 50, 58, 65, 255, 255,
+    },
+    [0x52] = {
+        112, 106, 106, 106, 108, 109, 102, 101, 95, 96, 100, 255,
+        93, 93, 87, 88, 92, 93, 84, 85, 80, 80, 84, 85,
+        78, 78, 72, 72, 76, 77, 72, 70, 64, 64, 68, 69,
+        65, 63, 56, 57, 60, 57, 59, 55, 49, 49, 52, 49,
+        54, 48, 41, 41, 44, 42, 48, 42, 34, 33, 36, 34,
+        42, 35, 27, 25, 28, 23, 36, 30, 21, 18, 20, 17,
+        33, 26, 17, 11, 12, 13, 32, 24, 16, 8, 0, 13,
+        35, 255, 255, 16, 14, 18, 39, 33, 255, 23, 22, 25,
+        44, 255, 255, 31, 30, 32, 54, 47, 43, 41, 40, 255,
+        58, 54, 51, 49, 48, 255, 64, 61, 58, 57, 56, 255,
+        255, 255, 70, 65, 64, 255, 42, 49, 57, 65, 255, 255,
+    },
+    [0x53] = {
+        119, 113, 113, 112, 113, 112, 110, 109, 102, 102, 105, 255,
+        101, 101, 94, 94, 97, 96, 93, 93, 87, 86, 89, 88,
+        87, 86, 79, 79, 81, 80, 81, 79, 72, 71, 73, 72,
+        75, 72, 64, 63, 65, 60, 70, 65, 57, 56, 57, 52,
+        64, 58, 50, 48, 49, 44, 59, 52, 44, 41, 42, 36,
+        54, 47, 38, 34, 34, 24, 49, 42, 33, 28, 27, 16,
+        45, 39, 30, 23, 20, 8, 44, 37, 28, 20, 13, 0,
+        45, 255, 255, 22, 16, 10, 48, 40, 255, 27, 22, 18,
+        51, 255, 255, 33, 29, 26, 59, 51, 46, 41, 38, 255,
+        62, 57, 52, 48, 46, 255, 68, 63, 59, 56, 53, 255,
+        255, 255, 72, 65, 61, 255, 36, 44, 52, 60, 255, 255,
+    },
+    [0x54] = {
+        121, 117, 120, 122, 126, 130, 111, 113, 109, 113, 118, 255,
+        101, 104, 101, 105, 111, 115, 92, 96, 93, 97, 103, 107,
+        85, 88, 86, 89, 96, 100, 78, 80, 78, 82, 88, 93,
+        71, 72, 70, 74, 81, 83, 64, 64, 62, 66, 73, 76,
+        57, 57, 54, 59, 66, 70, 50, 49, 47, 52, 59, 64,
+        41, 41, 39, 45, 53, 56, 31, 33, 32, 38, 47, 51,
+        21, 25, 26, 33, 41, 48, 11, 19, 22, 27, 35, 45,
+        0, 255, 255, 24, 32, 44, 8, 11, 255, 25, 33, 45,
+        16, 255, 255, 29, 36, 47, 30, 27, 31, 35, 41, 255,
+        34, 35, 38, 42, 47, 255, 42, 43, 45, 48, 53, 255,
+        255, 255, 50, 54, 59, 255, 51, 56, 61, 67, 255, 255,
+    },
+    [0x55] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x56] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x57] = {
+        123, 118, 119, 120, 122, 124, 114, 114, 108, 110, 114, 255,
+        104, 105, 100, 102, 106, 108, 95, 97, 92, 94, 98, 100,
+        88, 89, 84, 86, 90, 92, 82, 82, 76, 78, 82, 84,
+        75, 74, 68, 70, 74, 73, 68, 66, 61, 62, 66, 65,
+        62, 58, 53, 54, 59, 58, 55, 51, 45, 46, 51, 50,
+        48, 43, 37, 38, 43, 39, 39, 36, 29, 30, 35, 33,
+        32, 29, 22, 22, 27, 27, 26, 23, 17, 12, 16, 22,
+        24, 255, 255, 0, 8, 20, 25, 18, 255, 8, 11, 22,
+        29, 255, 255, 16, 18, 26, 38, 31, 27, 26, 27, 255,
+        42, 38, 35, 34, 35, 255, 48, 45, 43, 42, 43, 255,
+        255, 255, 54, 50, 51, 255, 33, 39, 47, 54, 255, 255,
+    },
+    [0x58] = {
+        125, 119, 120, 120, 122, 123, 116, 115, 109, 110, 114, 255,
+        106, 107, 101, 102, 106, 107, 97, 99, 93, 94, 98, 99,
+        91, 91, 86, 86, 90, 91, 84, 84, 78, 78, 82, 83,
+        78, 76, 70, 70, 74, 71, 72, 68, 62, 63, 66, 63,
+        65, 61, 54, 55, 58, 55, 59, 54, 47, 47, 50, 48,
+        52, 47, 39, 39, 42, 36, 45, 40, 32, 31, 34, 29,
+        38, 34, 26, 23, 26, 22, 34, 29, 22, 14, 14, 16,
+        32, 255, 255, 8, 0, 12, 33, 25, 255, 11, 8, 14,
+        36, 255, 255, 18, 16, 20, 44, 35, 31, 27, 26, 255,
+        47, 42, 38, 35, 34, 255, 53, 48, 45, 43, 42, 255,
+        255, 255, 57, 51, 50, 255, 29, 36, 44, 51, 255, 255,
+    },
+    [0x59] = {
+        129, 122, 122, 122, 123, 122, 119, 118, 112, 112, 115, 255,
+        110, 110, 104, 104, 107, 106, 102, 103, 96, 96, 99, 98,
+        96, 95, 89, 88, 91, 90, 90, 88, 81, 81, 83, 82,
+        84, 80, 74, 73, 75, 70, 78, 73, 66, 65, 67, 62,
+        72, 67, 59, 58, 59, 54, 67, 60, 52, 50, 51, 46,
+        60, 54, 46, 43, 44, 34, 54, 48, 40, 36, 36, 26,
+        49, 43, 34, 30, 29, 18, 45, 40, 32, 23, 18, 10,
+        44, 255, 255, 20, 12, 0, 45, 37, 255, 22, 14, 8,
+        47, 255, 255, 26, 20, 16, 53, 44, 38, 33, 29, 255,
+        56, 50, 44, 39, 36, 255, 61, 55, 50, 47, 44, 255,
+        255, 255, 64, 55, 51, 255, 26, 34, 42, 50, 255, 255,
+    },
+    [0x5a] = {
+        129, 125, 128, 130, 134, 137, 119, 121, 117, 120, 126, 255,
+        109, 112, 109, 113, 118, 122, 100, 104, 101, 105, 111, 115,
+        93, 96, 93, 97, 103, 107, 86, 88, 86, 89, 96, 100,
+        79, 80, 78, 82, 88, 90, 72, 72, 70, 74, 81, 83,
+        65, 64, 62, 66, 73, 76, 58, 57, 54, 59, 66, 70,
+        49, 49, 47, 52, 59, 61, 39, 41, 39, 45, 53, 56,
+        29, 33, 32, 38, 47, 51, 19, 26, 28, 31, 39, 48,
+        8, 255, 255, 25, 33, 45, 0, 8, 255, 24, 32, 44,
+        8, 255, 255, 25, 33, 45, 22, 20, 24, 30, 37, 255,
+        26, 27, 31, 35, 41, 255, 34, 35, 38, 42, 47, 255,
+        255, 255, 42, 47, 53, 255, 48, 51, 56, 61, 255, 255,
+    },
+    [0x5b] = {
+        129, 125, 127, 129, 132, 135, 119, 120, 116, 119, 124, 255,
+        109, 112, 108, 111, 116, 120, 100, 104, 100, 103, 109, 112,
+        93, 96, 92, 95, 101, 104, 86, 88, 84, 87, 93, 97,
+        79, 80, 76, 80, 85, 86, 72, 72, 68, 72, 78, 79,
+        65, 64, 61, 64, 70, 72, 59, 56, 53, 56, 63, 65,
+        50, 48, 45, 49, 55, 55, 40, 40, 37, 41, 48, 50,
+        30, 32, 29, 34, 42, 44, 21, 25, 24, 26, 33, 40,
+        11, 255, 255, 18, 25, 37, 8, 0, 255, 16, 24, 36,
+        11, 255, 255, 18, 25, 37, 23, 18, 20, 24, 30, 255,
+        27, 26, 27, 31, 35, 255, 35, 34, 35, 38, 42, 255,
+        255, 255, 42, 44, 48, 255, 40, 44, 50, 55, 255, 255,
+    },
+    [0x5c] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x5d] = {
+        131, 126, 127, 128, 130, 132, 121, 122, 116, 118, 122, 255,
+        112, 113, 108, 110, 114, 116, 103, 105, 100, 102, 106, 108,
+        96, 97, 92, 94, 98, 100, 89, 89, 84, 86, 90, 92,
+        83, 82, 76, 78, 82, 81, 76, 74, 68, 70, 74, 73,
+        69, 66, 61, 62, 66, 65, 63, 58, 53, 54, 59, 58,
+        55, 51, 45, 46, 51, 47, 46, 43, 37, 38, 43, 39,
+        38, 36, 29, 30, 35, 33, 31, 30, 24, 20, 23, 27,
+        25, 255, 255, 8, 11, 22, 24, 16, 255, 0, 8, 20,
+        25, 255, 255, 8, 11, 22, 33, 24, 20, 18, 20, 255,
+        35, 31, 27, 26, 27, 255, 42, 38, 35, 34, 35, 255,
+        255, 255, 47, 42, 43, 255, 27, 33, 39, 47, 255, 255,
+    },
+    [0x5e] = {
+        133, 127, 128, 128, 130, 131, 123, 123, 117, 118, 122, 255,
+        114, 115, 109, 110, 114, 115, 105, 107, 101, 102, 106, 107,
+        98, 99, 93, 94, 98, 99, 92, 91, 86, 86, 90, 91,
+        85, 84, 78, 78, 82, 79, 79, 76, 70, 70, 74, 71,
+        72, 68, 62, 63, 66, 63, 66, 61, 54, 55, 58, 55,
+        59, 54, 47, 47, 50, 44, 50, 47, 39, 39, 42, 36,
+        43, 40, 32, 31, 34, 29, 37, 35, 28, 22, 22, 22,
+        33, 255, 255, 11, 8, 14, 32, 24, 255, 8, 0, 12,
+        33, 255, 255, 11, 8, 14, 39, 30, 24, 20, 18, 255,
+        41, 35, 31, 27, 26, 255, 47, 42, 38, 35, 34, 255,
+        255, 255, 50, 44, 42, 255, 22, 29, 36, 44, 255, 255,
+    },
+    [0x5f] = {
+        136, 130, 130, 130, 131, 130, 127, 126, 119, 120, 123, 255,
+        118, 118, 112, 112, 115, 114, 109, 110, 104, 104, 107, 106,
+        103, 103, 96, 96, 99, 98, 97, 95, 89, 88, 91, 90,
+        90, 88, 81, 81, 83, 78, 84, 80, 74, 73, 75, 70,
+        78, 73, 66, 65, 67, 62, 73, 67, 59, 58, 59, 54,
+        66, 60, 52, 50, 51, 42, 59, 54, 46, 43, 44, 34,
+        53, 48, 40, 36, 36, 26, 48, 44, 36, 28, 25, 18,
+        45, 255, 255, 22, 14, 8, 44, 36, 255, 20, 12, 0,
+        45, 255, 255, 22, 14, 8, 49, 40, 33, 27, 22, 255,
+        51, 44, 38, 33, 29, 255, 56, 50, 44, 39, 36, 255,
+        255, 255, 58, 48, 44, 255, 18, 26, 34, 42, 255, 255,
+    },
+    [0x60] = {
+        137, 133, 136, 138, 142, 145, 127, 129, 125, 128, 134, 255,
+        117, 120, 117, 120, 126, 130, 108, 112, 109, 113, 118, 122,
+        101, 104, 101, 105, 111, 115, 94, 96, 93, 97, 103, 107,
+        87, 88, 86, 89, 96, 97, 80, 80, 78, 82, 88, 90,
+        73, 72, 70, 74, 81, 83, 66, 64, 62, 66, 73, 76,
+        57, 57, 54, 59, 66, 67, 47, 49, 47, 52, 59, 61,
+        37, 41, 39, 45, 53, 56, 27, 34, 35, 37, 44, 51,
+        16, 255, 255, 29, 36, 47, 8, 11, 255, 25, 33, 45,
+        0, 255, 255, 24, 32, 44, 14, 13, 19, 26, 34, 255,
+        18, 20, 24, 30, 37, 255, 26, 27, 31, 35, 41, 255,
+        255, 255, 34, 39, 47, 255, 45, 48, 51, 56, 255, 255,
+    },
+    [0x61] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x62] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x63] = {
+        139, 134, 135, 136, 138, 139, 129, 129, 124, 126, 130, 255,
+        119, 121, 116, 118, 122, 124, 111, 113, 108, 110, 114, 116,
+        104, 105, 100, 102, 106, 108, 97, 97, 92, 94, 98, 100,
+        90, 89, 84, 86, 90, 88, 84, 82, 76, 78, 82, 81,
+        77, 74, 68, 70, 74, 73, 70, 66, 61, 62, 66, 65,
+        62, 58, 53, 54, 59, 54, 53, 51, 45, 46, 51, 47,
+        44, 43, 37, 38, 43, 39, 36, 37, 32, 28, 31, 33,
+        29, 255, 255, 16, 18, 26, 25, 18, 255, 8, 11, 22,
+        24, 255, 255, 0, 8, 20, 28, 19, 13, 10, 13, 255,
+        30, 24, 20, 18, 20, 255, 35, 31, 27, 26, 27, 255,
+        255, 255, 39, 34, 35, 255, 22, 27, 33, 39, 255, 255,
+    },
+    [0x64] = {
+        141, 135, 136, 136, 138, 139, 131, 131, 125, 126, 130, 255,
+        121, 122, 117, 118, 122, 123, 113, 115, 109, 110, 114, 115,
+        106, 107, 101, 102, 106, 107, 99, 99, 93, 94, 98, 99,
+        93, 91, 86, 86, 90, 87, 86, 84, 78, 78, 82, 79,
+        80, 76, 70, 70, 74, 71, 73, 68, 62, 63, 66, 63,
+        65, 61, 54, 55, 58, 51, 57, 54, 47, 47, 50, 44,
+        49, 47, 39, 39, 42, 36, 42, 41, 35, 29, 30, 29,
+        36, 255, 255, 18, 16, 20, 33, 25, 255, 11, 8, 14,
+        32, 255, 255, 8, 0, 12, 35, 26, 19, 13, 10, 255,
+        37, 30, 24, 20, 18, 255, 41, 35, 31, 27, 26, 255,
+        255, 255, 44, 36, 34, 255, 16, 22, 29, 36, 255, 255,
+    },
+    [0x65] = {
+        144, 138, 138, 137, 139, 138, 134, 133, 127, 128, 131, 255,
+        125, 125, 119, 120, 123, 122, 117, 118, 112, 112, 115, 114,
+        110, 110, 104, 104, 107, 106, 104, 103, 96, 96, 99, 98,
+        97, 95, 89, 88, 91, 86, 91, 88, 81, 81, 83, 78,
+        85, 80, 74, 73, 75, 70, 79, 73, 66, 65, 67, 62,
+        72, 67, 59, 58, 59, 50, 64, 60, 52, 50, 51, 42,
+        57, 54, 46, 43, 44, 34, 52, 49, 42, 34, 32, 26,
+        47, 255, 255, 26, 20, 16, 45, 37, 255, 22, 14, 8,
+        44, 255, 255, 20, 12, 0, 46, 37, 30, 22, 16, 255,
+        48, 40, 33, 27, 22, 255, 51, 44, 38, 33, 29, 255,
+        255, 255, 52, 42, 36, 255, 10, 18, 26, 34, 255, 255,
+    },
+    [0x66] = {
+        151, 147, 150, 152, 155, 158, 141, 143, 139, 142, 148, 255,
+        131, 134, 131, 134, 140, 143, 122, 126, 123, 126, 132, 135,
+        115, 118, 115, 118, 124, 128, 108, 110, 107, 111, 116, 120,
+        101, 102, 99, 103, 109, 109, 94, 94, 91, 95, 101, 102,
+        87, 86, 84, 87, 94, 95, 80, 78, 76, 80, 86, 88,
+        71, 70, 68, 72, 79, 78, 61, 63, 60, 65, 72, 71,
+        51, 55, 52, 57, 64, 65, 41, 48, 48, 48, 54, 59,
+        30, 255, 255, 38, 44, 53, 22, 23, 255, 33, 39, 49,
+        14, 255, 255, 28, 35, 46, 0, 9, 16, 24, 32, 255,
+        4, 9, 16, 24, 32, 255, 12, 14, 20, 27, 34, 255,
+        255, 255, 20, 28, 38, 255, 44, 44, 46, 48, 255, 255,
+    },
+    [0x67] = {
+        147, 143, 145, 147, 150, 152, 137, 138, 134, 137, 142, 255,
+        127, 130, 126, 129, 134, 137, 118, 122, 118, 121, 126, 129,
+        111, 114, 110, 113, 118, 121, 104, 106, 102, 105, 111, 114,
+        97, 98, 94, 97, 103, 103, 90, 90, 86, 89, 95, 95,
+        83, 82, 78, 82, 87, 88, 76, 74, 70, 74, 80, 80,
+        67, 66, 63, 66, 72, 70, 58, 58, 55, 58, 65, 63,
+        48, 50, 47, 51, 57, 57, 38, 43, 42, 41, 47, 51,
+        27, 255, 255, 31, 35, 44, 20, 18, 255, 24, 30, 40,
+        13, 255, 255, 19, 26, 37, 9, 0, 8, 16, 24, 255,
+        11, 8, 11, 18, 25, 255, 18, 16, 18, 23, 29, 255,
+        255, 255, 24, 27, 34, 255, 36, 37, 39, 43, 255, 255,
+    },
+    [0x68] = {
+        148, 143, 145, 146, 149, 151, 138, 139, 134, 136, 141, 255,
+        128, 130, 126, 128, 133, 135, 119, 122, 118, 120, 125, 127,
+        112, 114, 110, 112, 117, 119, 105, 106, 102, 104, 109, 112,
+        98, 98, 94, 96, 101, 100, 91, 90, 86, 88, 93, 92,
+        85, 82, 78, 80, 86, 85, 78, 74, 70, 72, 78, 77,
+        69, 66, 62, 64, 70, 66, 59, 59, 54, 57, 62, 59,
+        50, 51, 46, 49, 54, 52, 40, 44, 41, 39, 43, 46,
+        31, 255, 255, 27, 31, 38, 24, 20, 255, 20, 24, 33,
+        19, 255, 255, 13, 19, 30, 16, 8, 0, 8, 16, 255,
+        18, 11, 8, 11, 18, 255, 23, 18, 16, 18, 23, 255,
+        255, 255, 27, 24, 29, 255, 28, 29, 32, 37, 255, 255,
+    },
+    [0x69] = {
+        149, 144, 145, 146, 148, 149, 139, 139, 134, 136, 140, 255,
+        129, 131, 126, 128, 132, 134, 120, 123, 118, 120, 124, 126,
+        114, 115, 110, 112, 116, 118, 107, 107, 102, 104, 108, 110,
+        100, 99, 94, 96, 100, 98, 93, 91, 86, 88, 92, 90,
+        86, 84, 78, 80, 84, 82, 80, 76, 70, 72, 76, 75,
+        71, 68, 63, 64, 68, 63, 62, 60, 55, 56, 61, 56,
+        53, 52, 47, 48, 53, 48, 44, 46, 42, 38, 41, 41,
+        35, 255, 255, 26, 27, 33, 30, 24, 255, 18, 20, 27,
+        26, 255, 255, 10, 13, 22, 24, 16, 8, 0, 8, 255,
+        25, 18, 11, 8, 11, 255, 29, 23, 18, 16, 18, 255,
+        255, 255, 31, 24, 25, 255, 20, 22, 26, 31, 255, 255,
+    },
+    [0x6a] = {
+        150, 145, 146, 146, 148, 148, 141, 141, 135, 136, 140, 255,
+        131, 132, 127, 128, 132, 133, 122, 124, 119, 120, 124, 125,
+        116, 116, 111, 112, 116, 117, 109, 109, 103, 104, 108, 109,
+        102, 101, 95, 96, 100, 97, 96, 93, 87, 88, 92, 89,
+        89, 85, 80, 80, 84, 81, 82, 78, 72, 72, 76, 73,
+        74, 70, 64, 64, 68, 61, 65, 63, 56, 57, 60, 53,
+        57, 55, 49, 49, 52, 46, 49, 49, 44, 39, 40, 38,
+        41, 255, 255, 27, 26, 29, 37, 30, 255, 20, 18, 22,
+        34, 255, 255, 13, 10, 16, 32, 24, 16, 8, 0, 255,
+        33, 25, 18, 11, 8, 255, 36, 29, 23, 18, 16, 255,
+        255, 255, 37, 27, 24, 255, 12, 14, 20, 27, 255, 255,
+    },
+    [0x6b] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x6c] = {
+        155, 151, 154, 156, 159, 162, 145, 147, 143, 146, 151, 255,
+        135, 138, 135, 138, 144, 147, 126, 130, 127, 130, 136, 139,
+        119, 122, 119, 122, 128, 132, 112, 114, 111, 115, 120, 124,
+        105, 106, 103, 107, 113, 113, 98, 98, 95, 99, 105, 106,
+        91, 90, 87, 91, 97, 98, 84, 82, 80, 84, 90, 91,
+        75, 74, 72, 76, 82, 81, 65, 66, 64, 68, 75, 74,
+        55, 59, 56, 61, 68, 68, 45, 52, 52, 52, 58, 62,
+        34, 255, 255, 42, 47, 56, 26, 27, 255, 35, 41, 51,
+        18, 255, 255, 30, 37, 48, 4, 11, 18, 25, 33, 255,
+        0, 8, 16, 24, 32, 255, 8, 11, 18, 25, 33, 255,
+        255, 255, 16, 26, 36, 255, 45, 44, 45, 47, 255, 255,
+    },
+    [0x6d] = {
+        155, 151, 153, 155, 158, 160, 145, 146, 142, 145, 150, 255,
+        135, 138, 134, 137, 142, 145, 126, 130, 126, 129, 134, 137,
+        119, 122, 118, 121, 126, 129, 112, 114, 110, 113, 118, 121,
+        105, 106, 102, 105, 111, 110, 98, 98, 94, 97, 103, 103,
+        91, 90, 86, 89, 95, 95, 84, 82, 78, 82, 87, 88,
+        75, 74, 70, 74, 80, 77, 65, 66, 63, 66, 72, 70,
+        56, 58, 55, 58, 65, 63, 46, 51, 50, 49, 54, 57,
+        35, 255, 255, 38, 42, 50, 27, 26, 255, 31, 35, 44,
+        20, 255, 255, 24, 30, 40, 9, 8, 11, 18, 25, 255,
+        8, 0, 8, 16, 24, 255, 11, 8, 11, 18, 25, 255,
+        255, 255, 16, 20, 29, 255, 37, 36, 37, 39, 255, 255,
+    },
+    [0x6e] = {
+        156, 151, 153, 154, 157, 158, 146, 147, 142, 144, 149, 255,
+        136, 138, 134, 136, 141, 143, 127, 130, 126, 128, 133, 135,
+        120, 122, 118, 120, 125, 127, 113, 114, 110, 112, 117, 119,
+        106, 106, 102, 104, 109, 108, 99, 98, 94, 96, 101, 100,
+        92, 90, 86, 88, 93, 92, 86, 82, 78, 80, 86, 85,
+        77, 74, 70, 72, 78, 74, 67, 66, 62, 64, 70, 66,
+        57, 59, 54, 57, 62, 59, 48, 52, 49, 47, 51, 52,
+        38, 255, 255, 35, 38, 44, 31, 27, 255, 27, 31, 38,
+        24, 255, 255, 20, 24, 33, 16, 11, 8, 11, 18, 255,
+        16, 8, 0, 8, 16, 255, 18, 11, 8, 11, 18, 255,
+        255, 255, 20, 16, 23, 255, 29, 28, 29, 32, 255, 255,
+    },
+    [0x6f] = {
+        157, 152, 153, 154, 156, 157, 147, 147, 142, 144, 148, 255,
+        137, 139, 134, 136, 140, 141, 128, 131, 126, 128, 132, 134,
+        121, 123, 118, 120, 124, 126, 115, 115, 110, 112, 116, 118,
+        108, 107, 102, 104, 108, 106, 101, 99, 94, 96, 100, 98,
+        94, 91, 86, 88, 92, 90, 87, 84, 78, 80, 84, 82,
+        79, 76, 70, 72, 76, 71, 69, 68, 63, 64, 68, 63,
+        60, 60, 55, 56, 61, 56, 51, 53, 50, 46, 49, 48,
+        42, 255, 255, 34, 35, 39, 35, 31, 255, 26, 27, 33,
+        30, 255, 255, 18, 20, 27, 24, 18, 11, 8, 11, 255,
+        24, 16, 8, 0, 8, 255, 25, 18, 11, 8, 11, 255,
+        255, 255, 26, 16, 18, 255, 22, 20, 22, 26, 255, 255,
+    },
+    [0x70] = {
+        158, 153, 154, 154, 156, 156, 148, 148, 143, 144, 148, 255,
+        139, 140, 135, 136, 140, 141, 130, 132, 127, 128, 132, 133,
+        123, 124, 119, 120, 124, 125, 116, 116, 111, 112, 116, 117,
+        110, 109, 103, 104, 108, 105, 103, 101, 95, 96, 100, 97,
+        96, 93, 87, 88, 92, 89, 90, 85, 80, 80, 84, 81,
+        82, 78, 72, 72, 76, 69, 72, 70, 64, 64, 68, 61,
+        64, 63, 56, 57, 60, 53, 55, 56, 52, 47, 48, 46,
+        47, 255, 255, 35, 34, 36, 41, 35, 255, 27, 26, 29,
+        37, 255, 255, 20, 18, 22, 32, 25, 18, 11, 8, 255,
+        32, 24, 16, 8, 0, 255, 33, 25, 18, 11, 8, 255,
+        255, 255, 32, 20, 16, 255, 14, 12, 14, 20, 255, 255,
+    },
+    [0x71] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x72] = {
+        163, 159, 162, 164, 167, 170, 153, 155, 151, 154, 159, 255,
+        143, 146, 143, 146, 151, 154, 134, 138, 135, 138, 144, 147,
+        127, 130, 127, 130, 136, 139, 120, 122, 119, 122, 128, 132,
+        113, 114, 111, 115, 120, 120, 106, 106, 103, 107, 113, 113,
+        99, 98, 95, 99, 105, 106, 92, 90, 87, 91, 97, 98,
+        83, 82, 80, 84, 90, 88, 73, 74, 72, 76, 82, 81,
+        63, 66, 64, 68, 75, 74, 53, 60, 59, 59, 64, 68,
+        42, 255, 255, 48, 53, 61, 34, 35, 255, 42, 47, 56,
+        26, 255, 255, 35, 41, 51, 12, 18, 23, 29, 36, 255,
+        8, 11, 18, 25, 33, 255, 0, 8, 16, 24, 32, 255,
+        255, 255, 9, 22, 33, 255, 47, 45, 44, 45, 255, 255,
+    },
+    [0x73] = {
+        163, 159, 161, 163, 166, 168, 153, 154, 150, 153, 158, 255,
+        143, 146, 142, 145, 150, 152, 134, 138, 134, 137, 142, 145,
+        127, 130, 126, 129, 134, 137, 120, 122, 118, 121, 126, 129,
+        113, 114, 110, 113, 118, 118, 106, 106, 102, 105, 111, 110,
+        99, 98, 94, 97, 103, 103, 92, 90, 86, 89, 95, 95,
+        83, 82, 78, 82, 87, 84, 73, 74, 70, 74, 80, 77,
+        64, 66, 63, 66, 72, 70, 54, 59, 58, 56, 61, 63,
+        43, 255, 255, 45, 48, 55, 35, 34, 255, 38, 42, 50,
+        27, 255, 255, 31, 35, 44, 14, 16, 18, 23, 29, 255,
+        11, 8, 11, 18, 25, 255, 8, 0, 8, 16, 24, 255,
+        255, 255, 9, 14, 25, 255, 39, 37, 36, 37, 255, 255,
+    },
+    [0x74] = {
+        164, 159, 161, 162, 165, 166, 154, 155, 150, 152, 157, 255,
+        144, 146, 142, 144, 149, 151, 135, 138, 134, 136, 141, 143,
+        128, 130, 126, 128, 133, 135, 121, 122, 118, 120, 125, 127,
+        114, 114, 110, 112, 117, 115, 107, 106, 102, 104, 109, 108,
+        100, 98, 94, 96, 101, 100, 93, 90, 86, 88, 93, 92,
+        85, 82, 78, 80, 86, 81, 75, 74, 70, 72, 78, 74,
+        65, 66, 62, 64, 70, 66, 55, 60, 57, 55, 58, 59,
+        45, 255, 255, 43, 45, 50, 38, 35, 255, 35, 38, 44,
+        31, 255, 255, 27, 31, 38, 20, 18, 16, 18, 23, 255,
+        18, 11, 8, 11, 18, 255, 16, 8, 0, 8, 16, 255,
+        255, 255, 14, 9, 18, 255, 32, 29, 28, 29, 255, 255,
+    },
+    [0x75] = {
+        165, 160, 161, 162, 164, 165, 155, 155, 150, 152, 156, 255,
+        145, 147, 142, 144, 148, 149, 136, 139, 134, 136, 140, 141,
+        129, 131, 126, 128, 132, 134, 122, 123, 118, 120, 124, 126,
+        116, 115, 110, 112, 116, 114, 109, 107, 102, 104, 108, 106,
+        102, 99, 94, 96, 100, 98, 95, 91, 86, 88, 92, 90,
+        86, 84, 78, 80, 84, 79, 77, 76, 70, 72, 76, 71,
+        67, 68, 63, 64, 68, 63, 58, 61, 58, 54, 57, 56,
+        48, 255, 255, 42, 43, 47, 42, 38, 255, 34, 35, 39,
+        35, 255, 255, 26, 27, 33, 27, 23, 18, 16, 18, 255,
+        25, 18, 11, 8, 11, 255, 24, 16, 8, 0, 8, 255,
+        255, 255, 22, 9, 11, 255, 26, 22, 20, 22, 255, 255,
+    },
+    [0x76] = {
+        166, 161, 162, 162, 164, 164, 156, 156, 151, 152, 156, 255,
+        147, 148, 143, 144, 148, 148, 138, 140, 135, 136, 140, 141,
+        131, 132, 127, 128, 132, 133, 124, 124, 119, 120, 124, 125,
+        117, 116, 111, 112, 116, 113, 111, 109, 103, 104, 108, 105,
+        104, 101, 95, 96, 100, 97, 97, 93, 87, 88, 92, 89,
+        89, 85, 80, 80, 84, 77, 80, 78, 72, 72, 76, 69,
+        71, 70, 64, 64, 68, 61, 62, 64, 59, 55, 56, 53,
+        53, 255, 255, 43, 42, 44, 47, 42, 255, 35, 34, 36,
+        41, 255, 255, 27, 26, 29, 34, 29, 23, 18, 16, 255,
+        33, 25, 18, 11, 8, 255, 32, 24, 16, 8, 0, 255,
+        255, 255, 29, 14, 8, 255, 20, 14, 12, 14, 255, 255,
+    },
+    [0x77] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x78] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x79] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x7a] = {
+        171, 167, 169, 171, 174, 177, 161, 163, 158, 161, 166, 255,
+        151, 154, 150, 153, 158, 161, 142, 146, 143, 145, 151, 153,
+        135, 138, 135, 137, 143, 146, 128, 130, 127, 130, 135, 138,
+        121, 122, 119, 122, 127, 126, 114, 114, 111, 114, 119, 119,
+        107, 106, 103, 106, 112, 111, 100, 98, 95, 98, 104, 104,
+        91, 90, 87, 90, 96, 93, 81, 82, 79, 82, 89, 86,
+        71, 74, 71, 75, 81, 79, 61, 67, 66, 65, 70, 72,
+        50, 255, 255, 54, 57, 64, 42, 42, 255, 47, 50, 58,
+        34, 255, 255, 39, 44, 52, 20, 24, 27, 31, 37, 255,
+        16, 16, 20, 26, 32, 255, 9, 9, 14, 22, 29, 255,
+        255, 255, 0, 16, 28, 255, 47, 43, 41, 40, 255, 255,
+    },
+    [0x7b] = {
+        172, 167, 169, 170, 172, 174, 162, 163, 158, 160, 164, 255,
+        152, 154, 150, 152, 156, 158, 143, 146, 142, 144, 148, 150,
+        136, 139, 134, 136, 141, 142, 130, 131, 126, 128, 133, 134,
+        123, 123, 118, 120, 125, 122, 116, 115, 110, 112, 117, 115,
+        109, 107, 102, 104, 109, 107, 102, 99, 94, 96, 101, 99,
+        93, 91, 86, 88, 93, 87, 83, 83, 78, 80, 85, 80,
+        74, 75, 70, 72, 77, 72, 64, 68, 65, 62, 65, 65,
+        54, 255, 255, 50, 51, 55, 47, 44, 255, 42, 44, 48,
+        39, 255, 255, 34, 36, 42, 28, 27, 24, 24, 27, 255,
+        26, 20, 16, 16, 20, 255, 22, 14, 9, 9, 14, 255,
+        255, 255, 16, 0, 12, 255, 34, 29, 25, 24, 255, 255,
+    },
+    [0x7c] = {
+        174, 169, 170, 170, 172, 172, 164, 164, 159, 160, 164, 255,
+        154, 156, 151, 152, 156, 156, 146, 148, 143, 144, 148, 148,
+        139, 140, 135, 136, 140, 141, 132, 132, 127, 128, 132, 133,
+        125, 124, 119, 120, 124, 121, 118, 116, 111, 112, 116, 113,
+        112, 109, 103, 104, 108, 105, 105, 101, 95, 96, 100, 97,
+        96, 93, 87, 88, 92, 85, 87, 85, 80, 80, 84, 77,
+        78, 78, 72, 72, 76, 69, 69, 71, 67, 63, 64, 61,
+        59, 255, 255, 51, 50, 51, 53, 48, 255, 43, 42, 44,
+        47, 255, 255, 35, 34, 36, 38, 34, 29, 25, 24, 255,
+        36, 29, 23, 18, 16, 255, 33, 25, 18, 11, 8, 255,
+        255, 255, 28, 12, 0, 255, 27, 20, 14, 12, 255, 255,
+    },
+    [0x7d] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x7e] = {
+        153, 147, 148, 147, 148, 148, 144, 143, 137, 137, 141, 255,
+        134, 135, 129, 130, 133, 132, 126, 127, 121, 122, 125, 124,
+        119, 120, 114, 114, 117, 116, 113, 112, 106, 106, 109, 108,
+        107, 104, 98, 98, 101, 96, 100, 97, 90, 90, 93, 88,
+        94, 90, 83, 82, 85, 80, 88, 82, 75, 75, 77, 72,
+        80, 75, 68, 67, 69, 60, 72, 68, 61, 59, 61, 52,
+        64, 62, 54, 52, 53, 44, 57, 56, 50, 43, 42, 36,
+        51, 255, 255, 33, 29, 26, 48, 40, 255, 27, 22, 18,
+        45, 255, 255, 22, 16, 10, 44, 36, 28, 20, 12, 255,
+        45, 37, 29, 22, 14, 255, 47, 39, 32, 26, 20, 255,
+        255, 255, 47, 34, 27, 255, 0, 8, 16, 24, 255, 255,
+    },
+    [0x7f] = {
+        161, 155, 156, 155, 156, 156, 152, 151, 145, 145, 148, 255,
+        142, 143, 137, 137, 141, 140, 133, 135, 129, 130, 133, 132,
+        127, 127, 121, 122, 125, 124, 120, 120, 114, 114, 117, 116,
+        114, 112, 106, 106, 109, 104, 107, 104, 98, 98, 101, 96,
+        101, 97, 90, 90, 93, 88, 95, 90, 83, 82, 85, 80,
+        87, 82, 75, 75, 77, 68, 78, 75, 68, 67, 69, 60,
+        70, 68, 61, 59, 61, 52, 63, 62, 56, 50, 49, 44,
+        56, 255, 255, 39, 36, 34, 51, 44, 255, 33, 29, 26,
+        48, 255, 255, 27, 22, 18, 44, 37, 29, 22, 14, 255,
+        44, 36, 28, 20, 12, 255, 45, 37, 29, 22, 14, 255,
+        255, 255, 43, 29, 20, 255, 8, 0, 8, 16, 255, 255,
+    },
+    [0x80] = {
+        169, 163, 163, 163, 164, 164, 159, 159, 153, 153, 156, 255,
+        150, 150, 145, 145, 148, 148, 141, 143, 137, 137, 141, 140,
+        134, 135, 129, 130, 133, 132, 128, 127, 121, 122, 125, 124,
+        121, 120, 114, 114, 117, 112, 115, 112, 106, 106, 109, 104,
+        108, 104, 98, 98, 101, 96, 102, 97, 90, 90, 93, 88,
+        94, 90, 83, 82, 85, 76, 85, 82, 75, 75, 77, 68,
+        77, 75, 68, 67, 69, 60, 69, 69, 64, 58, 57, 52,
+        61, 255, 255, 47, 44, 42, 56, 50, 255, 39, 36, 34,
+        51, 255, 255, 33, 29, 26, 46, 39, 32, 26, 20, 255,
+        45, 37, 29, 22, 14, 255, 44, 36, 28, 20, 12, 255,
+        255, 255, 41, 25, 14, 255, 16, 8, 0, 8, 255, 255,
+    },
+    [0x81] = {
+        177, 171, 171, 171, 172, 172, 167, 166, 160, 161, 164, 255,
+        157, 158, 153, 153, 156, 156, 149, 150, 145, 145, 148, 148,
+        142, 143, 137, 137, 141, 140, 135, 135, 129, 130, 133, 132,
+        129, 127, 121, 122, 125, 120, 122, 120, 114, 114, 117, 112,
+        116, 112, 106, 106, 109, 104, 109, 104, 98, 98, 101, 96,
+        101, 97, 90, 90, 93, 84, 92, 90, 83, 82, 85, 76,
+        84, 82, 75, 75, 77, 68, 75, 76, 71, 65, 65, 60,
+        67, 255, 255, 54, 51, 50, 61, 55, 255, 47, 44, 42,
+        56, 255, 255, 39, 36, 34, 48, 43, 37, 31, 27, 255,
+        47, 39, 32, 26, 20, 255, 45, 37, 29, 22, 14, 255,
+        255, 255, 40, 24, 12, 255, 24, 16, 8, 0, 255, 255,
+    },
+    [0x82] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+    [0x83] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    },
+};
+
+#endif  // DAS4Q_LAYOUT_TABLE_H
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "das4q_log.h"
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "das4q_priv.h"
+
+static _Atomic int das4q_log_level = DAS4Q_LOG_INFO;
+static das4q_log_fn das4q_log_cb;
+static void* das4q_log_user_data;
+
+void das4q_set_log_level(das4q_log_level_t level) {
+    atomic_store_explicit(&das4q_log_level, level, memory_order_relaxed);
+}
+
+das4q_log_level_t das4q_get_log_level(void) {
+    return atomic_load_explicit(&das4q_log_level, memory_order_relaxed);
+}
+
+void das4q_set_log_callback(das4q_log_fn fn, void* user_data) {
+    das4q_log_cb = fn;
+    das4q_log_user_data = user_data;
+}
+
+bool das4q_log_enabled(das4q_log_level_t level) {
+    return (int)level <= atomic_load_explicit(&das4q_log_level,
+                                              memory_order_relaxed);
+}
+
+void das4q_log_write(das4q_log_level_t level, const char* fmt, ...) {
+    char msg[512];
+    va_list ap;
+
+    va_start(ap, fmt);
+    vsnprintf(msg, sizeof(msg), fmt, ap);
+    va_end(ap);
+
+    if (das4q_log_cb != NULL) {
+        das4q_log_cb(level, msg, das4q_log_user_data);
+    } else {
+        fprintf(stderr, "das4q: %s\n", msg);
+    }
+}
+
+void das4q_log_hex(char* out, const uint8_t* buff, int len) {
+    static const char digits[] = "0123456789abcdef";
+    for (int i = 0; i < len; i++) {
+        *out++ = digits[buff[i] >> 4];
+        *out++ = digits[buff[i] & 0xf];
+        *out++ = i + 1 < len ? ' ' : '\0';
+    }
+    if (len <= 0) {
+        *out = '\0';
+    }
+}
+
+void das4q_log_packet(das4q_log_level_t level, const char* what,
+                      const uint8_t* buff, int len) {
+    if (level > DAS4Q_LOG_MAX_LEVEL || !das4q_log_enabled(level)) {
+        return;
+    }
+    char hex[128 * 3 + 1];
+    das4q_log_hex(hex, buff, len < 128 ? len : 128);
+    das4q_log_write(level, "%s%s", what, hex);
+}
+
+void das4q_trace(das4q_priv_t* priv, bool in, const uint8_t* buff, int len,
+                 int ret) {
+    das4q_trace_entry_t* entry =
+        &priv->trace[priv->trace_pos++ % DAS4Q_TRACE_LEN];
+    int n = len < (int)sizeof(entry->data) ? len : (int)sizeof(entry->data);
+
+    entry->t_us = das4q_stats_now_us();
+    entry->ret = ret;
+    entry->in = in;
+    memset(entry->data, 0, sizeof(entry->data));
+    memcpy(entry->data, buff, n);
+
+    das4q_log_packet(DAS4Q_LOG_TRACE, in ? "< " : "> ", buff, n);
+}
+
+static void das4q_trace_log(das4q_priv_t* priv, das4q_log_level_t level,
+                            uint64_t from) {
+    if (priv->trace_pos - from > DAS4Q_TRACE_LEN) {
+        from = priv->trace_pos - DAS4Q_TRACE_LEN;
+    }
+    if (from == priv->trace_pos) {
+        return;
+    }
+    das4q_log(level, "last %d reports:", (int)(priv->trace_pos - from));
+    for (uint64_t i = from; i < priv->trace_pos; i++) {
+        const das4q_trace_entry_t* entry = &priv->trace[i % DAS4Q_TRACE_LEN];
+        char hex[8 * 3 + 1];
+        das4q_log_hex(hex, entry->data, 8);
+        das4q_log(level, "  %llu.%06llu %s %s (%d)",
+                  (unsigned long long)entry->t_us / 1000000,
+                  (unsigned long long)entry->t_us % 1000000,
+                  entry->in ? "<" : ">", hex, entry->ret);
+    }
+}
+
+void das4q_trace_dump_new(das4q_priv_t* priv) {
+    das4q_trace_log(priv, DAS4Q_LOG_ERROR, priv->trace_dumped);
+    priv->trace_dumped = priv->trace_pos;
+}
+
+void das4q_dump_trace(das4q_handle handle, das4q_log_level_t level) {
+    das4q_priv_t* priv = handle;
+    das4q_trace_log(priv, level, 0);
+}
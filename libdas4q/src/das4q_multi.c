@@ -0,0 +1,94 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "das4q_priv.h"
+#include "libdas4q.h"
+
+/*
+ * Updates for several keyboards at once.
+ *
+ * Every keyboard is a separate device with its own libusb context, so the
+ * blocking update path can run on each of them side by side.  One thread
+ * per keyboard is plenty, a frame takes far longer than starting a thread.
+ */
+
+typedef struct das4q_worker {
+    das4q_handle handle;
+    const das4q_setting_t* settings;
+    const das4q_active_setting_t* active_settings;
+    int result;
+    pthread_t thread;
+    bool started;
+} das4q_worker_t;
+
+static void* das4q_worker_run(void* arg) {
+    das4q_worker_t* worker = arg;
+    worker->result = das4q_update_frame(worker->handle, worker->settings,
+                                        worker->active_settings);
+    return NULL;
+}
+
+int das4q_update_frames(das4q_handle handles[], int nhandles,
+                        const das4q_setting_t* const settings[],
+                        const das4q_active_setting_t* const active_settings[],
+                        int results[]) {
+    if (nhandles <= 0) {
+        return -EINVAL;
+    }
+
+    das4q_worker_t* workers = calloc(nhandles, sizeof(das4q_worker_t));
+    if (workers == NULL) {
+        return -ENOMEM;
+    }
+
+    for (int i = 0; i < nhandles; i++) {
+        workers[i].handle = handles[i];
+        workers[i].settings = settings[i];
+        workers[i].active_settings = active_settings[i];
+    }
+
+    // The calling thread takes the first keyboard itself
+    for (int i = 1; i < nhandles; i++) {
+        if (pthread_create(&workers[i].thread, NULL, das4q_worker_run,
+                           &workers[i]) == 0) {
+            workers[i].started = true;
+        }
+    }
+    das4q_worker_run(&workers[0]);
+
+    int ret = 0;
+    for (int i = 0; i < nhandles; i++) {
+        if (workers[i].started) {
+            pthread_join(workers[i].thread, NULL);
+        } else if (i > 0) {
+            // No thread to be had, do it here instead
+            DAS4Q_WARN("Failed to start worker, updating keyboard %d inline",
+                       i);
+            das4q_worker_run(&workers[i]);
+        }
+        if (results != NULL) {
+            results[i] = workers[i].result;
+        }
+        if (workers[i].result < 0 && ret == 0) {
+            ret = workers[i].result;
+        }
+    }
+    free(workers);
+    return ret;
+}
@@ -0,0 +1,279 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "das4q_plan.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "das4q_priv.h"
+
+// How each effect maps onto the firmware
+typedef struct das4q_plan_mode {
+    das4q_keymode_t mode;  // DAS4Q_MODE_NONE if there's no passive mode
+    das4q_active_keymode_t active;
+    // The passive mode's rate, which can't be changed.  Taken to be the
+    // same as the active mode's default timing.  0 if it doesn't animate.
+    uint32_t period_ms;
+    bool timed;  // The active mode's unk is its timing
+} das4q_plan_mode_t;
+
+static const das4q_plan_mode_t das4q_plan_modes[] = {
+    [DAS4Q_EFFECT_STATIC] = {DAS4Q_MODE_SOLID, DAS4Q_ACTIVE_MODE_SOLID, 0,
+                             true},
+    [DAS4Q_EFFECT_PULSE] = {DAS4Q_MODE_BREATHE, DAS4Q_ACTIVE_MODE_BREATHE,
+                            1000, true},
+    [DAS4Q_EFFECT_BLINK] = {DAS4Q_MODE_BLINK, DAS4Q_ACTIVE_MODE_BLINK, 500,
+                            true},
+    [DAS4Q_EFFECT_CYCLE] = {DAS4Q_MODE_CYCLE, DAS4Q_ACTIVE_MODE_CYCLE, 5000,
+                            true},
+    [DAS4Q_EFFECT_LASER] = {DAS4Q_MODE_NONE, DAS4Q_ACTIVE_MODE_LASER, 0,
+                            false},
+    [DAS4Q_EFFECT_RIPPLE] = {DAS4Q_MODE_NONE, DAS4Q_ACTIVE_MODE_RIPPLE, 0,
+                             false},
+    [DAS4Q_EFFECT_IN_RIPPLE] = {DAS4Q_MODE_NONE,
+                                DAS4Q_ACTIVE_MODE_IN_RIPPLE, 0, false},
+};
+
+struct das4q_plan {
+    das4q_priv_t* priv;
+
+    das4q_setting_t frame[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t aframe[DAS4Q_NUM_KEYS];
+
+    // Effects left to the host, keys not kept
+    das4q_effect_request_t host[DAS4Q_PLAN_MAX_HOST];
+    int host_count[DAS4Q_PLAN_MAX_HOST];  // Keys still drawn by each
+    int nhost;
+    // Index into host for each key, -1 for keys left to the firmware
+    int8_t host_effect[DAS4Q_NUM_KEYS];
+};
+
+das4q_plan_t* das4q_plan_new(das4q_handle handle) {
+    das4q_priv_t* priv = handle;
+
+    das4q_plan_t* plan = calloc(1, sizeof(das4q_plan_t));
+    if (plan == NULL) {
+        errno = -ENOMEM;
+        return NULL;
+    }
+    plan->priv = priv;
+
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        if (priv->cache_valid[i]) {
+            plan->frame[i] = priv->cache[i];
+            plan->aframe[i] = priv->active_cache[i];
+        } else {
+            plan->frame[i].mode = DAS4Q_MODE_SOLID;
+        }
+        plan->host_effect[i] = -1;
+    }
+    return plan;
+}
+
+void das4q_plan_free(das4q_plan_t* plan) { free(plan); }
+
+// Whether the firmware's fixed rate is close enough to what was asked for.
+static bool das4q_plan_rate_fits(const das4q_effect_request_t* effect,
+                                 uint32_t period_ms) {
+    if (effect->period_ms == 0 || period_ms == 0) {
+        return true;
+    }
+    uint32_t off = effect->period_ms > period_ms
+                       ? effect->period_ms - period_ms
+                       : period_ms - effect->period_ms;
+    return (uint64_t)off * 100 <= (uint64_t)period_ms * effect->tolerance_pct;
+}
+
+static das4q_setting_t das4q_plan_draw(const das4q_effect_request_t* effect,
+                                       uint64_t t_us) {
+    double phase =
+        (double)(t_us / 1000 % effect->period_ms) / effect->period_ms;
+    double level = 1;
+    das4q_setting_t setting = {.mode = DAS4Q_MODE_SOLID,
+                               .red = effect->red,
+                               .green = effect->green,
+                               .blue = effect->blue};
+
+    switch (effect->kind) {
+        case DAS4Q_EFFECT_PULSE:
+            level = (1 - cos(phase * 2 * M_PI)) / 2;
+            break;
+        case DAS4Q_EFFECT_BLINK:
+            level = phase < 0.5;
+            break;
+        case DAS4Q_EFFECT_CYCLE: {
+            // Once around the hue circle at full saturation
+            int sector = phase * 6;
+            uint8_t up = (phase * 6 - sector) * 0xff;
+            uint8_t down = 0xff - up;
+            const uint8_t rgb[6][3] = {
+                {0xff, up, 0}, {down, 0xff, 0}, {0, 0xff, up},
+                {0, down, 0xff}, {up, 0, 0xff}, {0xff, 0, down},
+            };
+            setting.red = rgb[sector][0];
+            setting.green = rgb[sector][1];
+            setting.blue = rgb[sector][2];
+            return setting;
+        }
+        default:
+            break;
+    }
+    setting.red *= level;
+    setting.green *= level;
+    setting.blue *= level;
+    return setting;
+}
+
+// Takes key back from whichever host effect had it.
+static void das4q_plan_release(das4q_plan_t* plan, das4q_map_t key) {
+    if (plan->host_effect[key] >= 0) {
+        plan->host_count[(int)plan->host_effect[key]]--;
+        plan->host_effect[key] = -1;
+    }
+}
+
+// A host slot with no keys left, or a new one.  -1 if they're all in use.
+static int das4q_plan_host_slot(das4q_plan_t* plan) {
+    for (int i = 0; i < plan->nhost; i++) {
+        if (plan->host_count[i] == 0) {
+            return i;
+        }
+    }
+    return plan->nhost < DAS4Q_PLAN_MAX_HOST ? plan->nhost++ : -1;
+}
+
+// Fills unk with a keypress effect's timing.  returns: false if it
+// doesn't fit.
+static bool das4q_plan_timing(const das4q_effect_request_t* effect,
+                              das4q_active_setting_t* active) {
+    if (effect->period_ms == 0 && effect->repeat == 0) {
+        // Left zero for the firmware's defaults
+        return true;
+    }
+    if (effect->period_ms > 0xffff) {
+        return false;
+    }
+    const uint8_t* unk = das4q_active_unk(active);
+    uint32_t period_ms =
+        effect->period_ms != 0 ? effect->period_ms
+                               : (uint32_t)(unk[0] << 8 | unk[1]);
+    uint8_t repeat = effect->repeat != 0 ? effect->repeat : unk[2];
+    active->unk[0] = period_ms >> 8;
+    active->unk[1] = period_ms & 0xff;
+    active->unk[2] = repeat;
+    return true;
+}
+
+int das4q_plan_add(das4q_plan_t* plan, const das4q_effect_request_t* effect) {
+    const das4q_map_t* keys = effect->keys;
+    int nkeys = keys != NULL ? effect->nkeys : DAS4Q_NUM_KEYS;
+
+    if (effect->kind > DAS4Q_EFFECT_IN_RIPPLE ||
+        effect->trigger > DAS4Q_TRIGGER_KEYPRESS || nkeys < 0 ||
+        nkeys > DAS4Q_NUM_KEYS) {
+        return -EINVAL;
+    }
+    for (int i = 0; keys != NULL && i < nkeys; i++) {
+        if (keys[i] >= DAS4Q_NUM_KEYS) {
+            return -EINVAL;
+        }
+    }
+    const das4q_plan_mode_t* mode = &das4q_plan_modes[effect->kind];
+
+    if (effect->trigger == DAS4Q_TRIGGER_KEYPRESS) {
+        das4q_active_setting_t active = {.mode = mode->active,
+                                         .red = effect->red,
+                                         .green = effect->green,
+                                         .blue = effect->blue};
+        if (mode->timed && !das4q_plan_timing(effect, &active)) {
+            return -ERANGE;
+        }
+        for (int i = 0; i < nkeys; i++) {
+            plan->aframe[keys != NULL ? keys[i] : i] = active;
+        }
+        return DAS4Q_PLAN_FIRMWARE;
+    }
+
+    if (mode->mode == DAS4Q_MODE_NONE) {
+        return -ENOTSUP;
+    }
+    if (das4q_plan_rate_fits(effect, mode->period_ms)) {
+        das4q_setting_t setting = {.mode = mode->mode,
+                                   .red = effect->red,
+                                   .green = effect->green,
+                                   .blue = effect->blue};
+        for (int i = 0; i < nkeys; i++) {
+            das4q_map_t key = keys != NULL ? keys[i] : i;
+            das4q_plan_release(plan, key);
+            plan->frame[key] = setting;
+        }
+        return DAS4Q_PLAN_FIRMWARE;
+    }
+
+    // Keys this effect takes over may free up the slot it needs
+    for (int i = 0; i < nkeys; i++) {
+        das4q_plan_release(plan, keys != NULL ? keys[i] : i);
+    }
+    int slot = das4q_plan_host_slot(plan);
+    if (slot < 0) {
+        return -ENOSPC;
+    }
+    plan->host[slot] = *effect;
+    plan->host[slot].keys = NULL;
+    plan->host_count[slot] = nkeys;
+    das4q_setting_t start = das4q_plan_draw(&plan->host[slot], 0);
+    for (int i = 0; i < nkeys; i++) {
+        das4q_map_t key = keys != NULL ? keys[i] : i;
+        plan->host_effect[key] = slot;
+        plan->frame[key] = start;
+    }
+    return DAS4Q_PLAN_HOST;
+}
+
+int das4q_plan_upload(das4q_plan_t* plan) {
+    int ret = das4q_update_frame(plan->priv, plan->frame, plan->aframe);
+    if (ret < 0) {
+        return ret;
+    }
+    if (!das4q_apply_changes(plan->priv)) {
+        return -EIO;
+    }
+    return ret;
+}
+
+int das4q_plan_host_keys(das4q_plan_t* plan) {
+    int keys = 0;
+    for (int i = 0; i < plan->nhost; i++) {
+        keys += plan->host_count[i];
+    }
+    return keys;
+}
+
+bool das4q_plan_effect(uint64_t t_us, das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                       das4q_active_setting_t aframe[DAS4Q_NUM_KEYS],
+                       void* user_data) {
+    das4q_plan_t* plan = user_data;
+
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        if (plan->host_effect[i] >= 0) {
+            frame[i] = das4q_plan_draw(&plan->host[(int)plan->host_effect[i]],
+                                       t_us);
+        }
+    }
+    return true;
+}
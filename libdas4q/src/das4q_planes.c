@@ -0,0 +1,421 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "das4q_planes.h"
+
+#include <math.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DAS4Q_X86 1
+#endif
+
+/*
+ * Each kernel works on one plane.  Everything that needs a division by 255
+ * uses the same rounding trick in every version, which is exact for the
+ * 16 bit products involved, so the vector kernels match the scalar ones
+ * bit for bit.  Planes are always aligned, but w can come straight from
+ * the caller and is loaded unaligned.
+ */
+typedef struct das4q_kernels {
+    void (*fill)(uint8_t* dst, uint8_t value);
+    // dst = from * (255 - w) / 255 + to * w / 255
+    void (*lerp)(uint8_t* dst, const uint8_t* w, uint8_t from, uint8_t to);
+    // dst = dst * (255 - w) / 255 + src * w / 255
+    void (*blend)(uint8_t* dst, const uint8_t* src, const uint8_t* w);
+    void (*scale)(uint8_t* dst, uint16_t factor);
+    void (*fade)(uint8_t* dst, const uint8_t* target, uint8_t step);
+} das4q_kernels_t;
+
+static inline uint8_t das4q_div255(uint32_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static void das4q_fill_scalar(uint8_t* dst, uint8_t value) {
+    memset(dst, value, DAS4Q_PLANE_LEN);
+}
+
+static void das4q_lerp_scalar(uint8_t* dst, const uint8_t* w, uint8_t from,
+                              uint8_t to) {
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i++) {
+        dst[i] = das4q_div255(from * (255 - w[i]) + to * w[i]);
+    }
+}
+
+static void das4q_blend_scalar(uint8_t* dst, const uint8_t* src,
+                               const uint8_t* w) {
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i++) {
+        dst[i] = das4q_div255(dst[i] * (255 - w[i]) + src[i] * w[i]);
+    }
+}
+
+static void das4q_scale_scalar(uint8_t* dst, uint16_t factor) {
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i++) {
+        dst[i] = (dst[i] * factor) >> 8;
+    }
+}
+
+static void das4q_fade_scalar(uint8_t* dst, const uint8_t* target,
+                              uint8_t step) {
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i++) {
+        int d = dst[i];
+        int t = target[i];
+        if (d < t) {
+            dst[i] = d + step < t ? d + step : t;
+        } else {
+            dst[i] = d - step > t ? d - step : t;
+        }
+    }
+}
+
+static const das4q_kernels_t das4q_kernels_scalar = {
+    .fill = das4q_fill_scalar,
+    .lerp = das4q_lerp_scalar,
+    .blend = das4q_blend_scalar,
+    .scale = das4q_scale_scalar,
+    .fade = das4q_fade_scalar,
+};
+
+#ifdef DAS4Q_X86
+
+#define DAS4Q_SSE2 __attribute__((target("sse2")))
+#define DAS4Q_AVX2 __attribute__((target("avx2")))
+
+DAS4Q_SSE2 static inline __m128i das4q_div255_sse2(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// a * (255 - w) + b * w, over 8 16 bit lanes
+DAS4Q_SSE2 static inline __m128i das4q_mix_sse2(__m128i a, __m128i b,
+                                                __m128i w) {
+    __m128i iw = _mm_sub_epi16(_mm_set1_epi16(255), w);
+    return das4q_div255_sse2(
+        _mm_add_epi16(_mm_mullo_epi16(a, iw), _mm_mullo_epi16(b, w)));
+}
+
+DAS4Q_SSE2 static void das4q_fill_sse2(uint8_t* dst, uint8_t value) {
+    __m128i v = _mm_set1_epi8(value);
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i += 16) {
+        _mm_store_si128((__m128i*)(dst + i), v);
+    }
+}
+
+DAS4Q_SSE2 static void das4q_lerp_sse2(uint8_t* dst, const uint8_t* w,
+                                       uint8_t from, uint8_t to) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i a = _mm_set1_epi16(from);
+    __m128i b = _mm_set1_epi16(to);
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i += 16) {
+        __m128i wv = _mm_loadu_si128((const __m128i*)(w + i));
+        __m128i lo = das4q_mix_sse2(a, b, _mm_unpacklo_epi8(wv, zero));
+        __m128i hi = das4q_mix_sse2(a, b, _mm_unpackhi_epi8(wv, zero));
+        _mm_store_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+}
+
+DAS4Q_SSE2 static void das4q_blend_sse2(uint8_t* dst, const uint8_t* src,
+                                        const uint8_t* w) {
+    __m128i zero = _mm_setzero_si128();
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i += 16) {
+        __m128i d = _mm_load_si128((const __m128i*)(dst + i));
+        __m128i s = _mm_load_si128((const __m128i*)(src + i));
+        __m128i wv = _mm_loadu_si128((const __m128i*)(w + i));
+        __m128i lo = das4q_mix_sse2(_mm_unpacklo_epi8(d, zero),
+                                    _mm_unpacklo_epi8(s, zero),
+                                    _mm_unpacklo_epi8(wv, zero));
+        __m128i hi = das4q_mix_sse2(_mm_unpackhi_epi8(d, zero),
+                                    _mm_unpackhi_epi8(s, zero),
+                                    _mm_unpackhi_epi8(wv, zero));
+        _mm_store_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+}
+
+DAS4Q_SSE2 static void das4q_scale_sse2(uint8_t* dst, uint16_t factor) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i f = _mm_set1_epi16(factor);
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i += 16) {
+        __m128i d = _mm_load_si128((const __m128i*)(dst + i));
+        __m128i lo = _mm_srli_epi16(
+            _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), f), 8);
+        __m128i hi = _mm_srli_epi16(
+            _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), f), 8);
+        _mm_store_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+}
+
+// max(min(d + step, t), d - step), both saturating, lands on the same
+// answer as the branches in the scalar version.
+DAS4Q_SSE2 static void das4q_fade_sse2(uint8_t* dst, const uint8_t* target,
+                                       uint8_t step) {
+    __m128i s = _mm_set1_epi8(step);
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i += 16) {
+        __m128i d = _mm_load_si128((const __m128i*)(dst + i));
+        __m128i t = _mm_load_si128((const __m128i*)(target + i));
+        __m128i up = _mm_min_epu8(_mm_adds_epu8(d, s), t);
+        _mm_store_si128((__m128i*)(dst + i),
+                        _mm_max_epu8(up, _mm_subs_epu8(d, s)));
+    }
+}
+
+static const das4q_kernels_t das4q_kernels_sse2 = {
+    .fill = das4q_fill_sse2,
+    .lerp = das4q_lerp_sse2,
+    .blend = das4q_blend_sse2,
+    .scale = das4q_scale_sse2,
+    .fade = das4q_fade_sse2,
+};
+
+DAS4Q_AVX2 static inline __m256i das4q_div255_avx2(__m256i x) {
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+DAS4Q_AVX2 static inline __m256i das4q_mix_avx2(__m256i a, __m256i b,
+                                                __m256i w) {
+    __m256i iw = _mm256_sub_epi16(_mm256_set1_epi16(255), w);
+    return das4q_div255_avx2(
+        _mm256_add_epi16(_mm256_mullo_epi16(a, iw), _mm256_mullo_epi16(b, w)));
+}
+
+DAS4Q_AVX2 static void das4q_fill_avx2(uint8_t* dst, uint8_t value) {
+    __m256i v = _mm256_set1_epi8(value);
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i += 32) {
+        _mm256_store_si256((__m256i*)(dst + i), v);
+    }
+}
+
+// The unpacks and the pack all work within 128 bit lanes, so the bytes
+// come back out in the order they went in.
+DAS4Q_AVX2 static void das4q_lerp_avx2(uint8_t* dst, const uint8_t* w,
+                                       uint8_t from, uint8_t to) {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i a = _mm256_set1_epi16(from);
+    __m256i b = _mm256_set1_epi16(to);
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i += 32) {
+        __m256i wv = _mm256_loadu_si256((const __m256i*)(w + i));
+        __m256i lo = das4q_mix_avx2(a, b, _mm256_unpacklo_epi8(wv, zero));
+        __m256i hi = das4q_mix_avx2(a, b, _mm256_unpackhi_epi8(wv, zero));
+        _mm256_store_si256((__m256i*)(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+}
+
+DAS4Q_AVX2 static void das4q_blend_avx2(uint8_t* dst, const uint8_t* src,
+                                        const uint8_t* w) {
+    __m256i zero = _mm256_setzero_si256();
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i += 32) {
+        __m256i d = _mm256_load_si256((const __m256i*)(dst + i));
+        __m256i s = _mm256_load_si256((const __m256i*)(src + i));
+        __m256i wv = _mm256_loadu_si256((const __m256i*)(w + i));
+        __m256i lo = das4q_mix_avx2(_mm256_unpacklo_epi8(d, zero),
+                                    _mm256_unpacklo_epi8(s, zero),
+                                    _mm256_unpacklo_epi8(wv, zero));
+        __m256i hi = das4q_mix_avx2(_mm256_unpackhi_epi8(d, zero),
+                                    _mm256_unpackhi_epi8(s, zero),
+                                    _mm256_unpackhi_epi8(wv, zero));
+        _mm256_store_si256((__m256i*)(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+}
+
+DAS4Q_AVX2 static void das4q_scale_avx2(uint8_t* dst, uint16_t factor) {
+    __m256i zero = _mm256_setzero_si256();
+    __m256i f = _mm256_set1_epi16(factor);
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i += 32) {
+        __m256i d = _mm256_load_si256((const __m256i*)(dst + i));
+        __m256i lo = _mm256_srli_epi16(
+            _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), f), 8);
+        __m256i hi = _mm256_srli_epi16(
+            _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), f), 8);
+        _mm256_store_si256((__m256i*)(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+}
+
+DAS4Q_AVX2 static void das4q_fade_avx2(uint8_t* dst, const uint8_t* target,
+                                       uint8_t step) {
+    __m256i s = _mm256_set1_epi8(step);
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i += 32) {
+        __m256i d = _mm256_load_si256((const __m256i*)(dst + i));
+        __m256i t = _mm256_load_si256((const __m256i*)(target + i));
+        __m256i up = _mm256_min_epu8(_mm256_adds_epu8(d, s), t);
+        _mm256_store_si256((__m256i*)(dst + i),
+                           _mm256_max_epu8(up, _mm256_subs_epu8(d, s)));
+    }
+}
+
+static const das4q_kernels_t das4q_kernels_avx2 = {
+    .fill = das4q_fill_avx2,
+    .lerp = das4q_lerp_avx2,
+    .blend = das4q_blend_avx2,
+    .scale = das4q_scale_avx2,
+    .fade = das4q_fade_avx2,
+};
+
+#endif  // DAS4Q_X86
+
+static const das4q_kernels_t* das4q_kernels;
+static das4q_isa_t das4q_kernels_isa;
+
+static bool das4q_isa_supported(das4q_isa_t isa) {
+    switch (isa) {
+        case DAS4Q_ISA_SCALAR:
+            return true;
+#ifdef DAS4Q_X86
+        case DAS4Q_ISA_SSE2:
+            return __builtin_cpu_supports("sse2");
+        case DAS4Q_ISA_AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+bool das4q_planes_set_isa(das4q_isa_t isa) {
+    if (!das4q_isa_supported(isa)) {
+        return false;
+    }
+    switch (isa) {
+#ifdef DAS4Q_X86
+        case DAS4Q_ISA_SSE2:
+            das4q_kernels = &das4q_kernels_sse2;
+            break;
+        case DAS4Q_ISA_AVX2:
+            das4q_kernels = &das4q_kernels_avx2;
+            break;
+#endif
+        default:
+            das4q_kernels = &das4q_kernels_scalar;
+            break;
+    }
+    das4q_kernels_isa = isa;
+    return true;
+}
+
+static const das4q_kernels_t* das4q_get_kernels(void) {
+    if (das4q_kernels == NULL) {
+        // Racing threads all pick the same thing
+        if (!das4q_planes_set_isa(DAS4Q_ISA_AVX2) &&
+            !das4q_planes_set_isa(DAS4Q_ISA_SSE2)) {
+            das4q_planes_set_isa(DAS4Q_ISA_SCALAR);
+        }
+    }
+    return das4q_kernels;
+}
+
+das4q_isa_t das4q_planes_get_isa(void) {
+    das4q_get_kernels();
+    return das4q_kernels_isa;
+}
+
+const char* das4q_isa_name(das4q_isa_t isa) {
+    switch (isa) {
+        case DAS4Q_ISA_SCALAR:
+            return "scalar";
+        case DAS4Q_ISA_SSE2:
+            return "sse2";
+        case DAS4Q_ISA_AVX2:
+            return "avx2";
+    }
+    return "unknown";
+}
+
+void das4q_planes_fill(das4q_planes_t* planes, das4q_rgb_t color) {
+    const das4q_kernels_t* k = das4q_get_kernels();
+    k->fill(planes->r, color.red);
+    k->fill(planes->g, color.green);
+    k->fill(planes->b, color.blue);
+}
+
+void das4q_planes_gradient(das4q_planes_t* planes,
+                           const uint8_t pos[DAS4Q_PLANE_LEN],
+                           das4q_rgb_t from, das4q_rgb_t to) {
+    const das4q_kernels_t* k = das4q_get_kernels();
+    k->lerp(planes->r, pos, from.red, to.red);
+    k->lerp(planes->g, pos, from.green, to.green);
+    k->lerp(planes->b, pos, from.blue, to.blue);
+}
+
+void das4q_planes_blend(das4q_planes_t* dst, const das4q_planes_t* src,
+                        uint8_t alpha) {
+    uint8_t w[DAS4Q_PLANE_LEN] __attribute__((aligned(32)));
+    das4q_get_kernels()->fill(w, alpha);
+    das4q_planes_blend_mask(dst, src, w);
+}
+
+void das4q_planes_blend_mask(das4q_planes_t* dst, const das4q_planes_t* src,
+                             const uint8_t alpha[DAS4Q_PLANE_LEN]) {
+    const das4q_kernels_t* k = das4q_get_kernels();
+    k->blend(dst->r, src->r, alpha);
+    k->blend(dst->g, src->g, alpha);
+    k->blend(dst->b, src->b, alpha);
+}
+
+void das4q_planes_scale(das4q_planes_t* planes, uint16_t factor) {
+    const das4q_kernels_t* k = das4q_get_kernels();
+    // Keeps the products inside 16 bits
+    if (factor > 256) {
+        factor = 256;
+    }
+    k->scale(planes->r, factor);
+    k->scale(planes->g, factor);
+    k->scale(planes->b, factor);
+}
+
+// Byte gathers don't vectorize usefully before AVX-512, so this one stays
+// scalar everywhere.
+void das4q_planes_lut(das4q_planes_t* planes, const uint8_t lut[256]) {
+    for (int i = 0; i < DAS4Q_PLANE_LEN; i++) {
+        planes->r[i] = lut[planes->r[i]];
+        planes->g[i] = lut[planes->g[i]];
+        planes->b[i] = lut[planes->b[i]];
+    }
+}
+
+void das4q_gamma_lut(uint8_t lut[256], double gamma) {
+    for (int i = 0; i < 256; i++) {
+        lut[i] = (uint8_t)(pow(i / 255.0, gamma) * 255.0 + 0.5);
+    }
+}
+
+void das4q_planes_fade(das4q_planes_t* planes, const das4q_planes_t* target,
+                       uint8_t step) {
+    const das4q_kernels_t* k = das4q_get_kernels();
+    k->fade(planes->r, target->r, step);
+    k->fade(planes->g, target->g, step);
+    k->fade(planes->b, target->b, step);
+}
+
+void das4q_planes_to_frame(const das4q_planes_t* planes,
+                           das4q_setting_t frame[DAS4Q_NUM_KEYS],
+                           das4q_keymode_t mode) {
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        frame[i].mode = mode;
+        frame[i].red = planes->r[i];
+        frame[i].green = planes->g[i];
+        frame[i].blue = planes->b[i];
+    }
+}
+
+void das4q_planes_from_frame(das4q_planes_t* planes,
+                             const das4q_setting_t frame[DAS4Q_NUM_KEYS]) {
+    memset(planes, 0, sizeof(*planes));
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        planes->r[i] = frame[i].red;
+        planes->g[i] = frame[i].green;
+        planes->b[i] = frame[i].blue;
+    }
+}
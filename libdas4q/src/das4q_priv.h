@@ -0,0 +1,368 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DAS4Q_PRIV_H
+#define DAS4Q_PRIV_H
+
+#include <libusb-1.0/libusb.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "das4q_log.h"
+#include "das4q_transport.h"
+#include "libdas4q.h"
+
+/*
+ * The purpose and meaning of these is still pretty unknown.
+ * it is transmitted in 7 byte chunks, with 0x01 prepended to each packet.
+ */
+typedef struct __attribute__((__packed__)) das4q_set_cmd {
+    uint8_t magic;       // Will be set to 0xea
+    uint8_t pkt_size;    // Will be 0x08 to set the state
+    uint8_t always_78h;  // Will be set to 0x78
+    uint8_t cmd_type;    // will be 0x08 to set  the state
+    das4q_map_t keycode;
+    das4q_keymode_t mode;
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    uint8_t csum;
+} das4q_set_cmd_t;
+
+typedef struct __attribute__((__packed__)) das4q_active_cmd {
+    uint8_t magic;       // Will be set to 0xea
+    uint8_t pkt_size;    // Will be 0x0b for active.
+    uint8_t always_78h;  // Will be set to 0x78
+    uint8_t cmd_type;    // will be 0x04 for active
+    das4q_map_t keycode;
+    das4q_active_keymode_t mode;
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    uint8_t unk[3];
+    uint8_t csum;
+} das4q_active_cmd_t;
+
+// Both commands for one key, back to back.
+#define DAS4Q_KEY_CMDS_LEN \
+    (sizeof(das4q_set_cmd_t) + sizeof(das4q_active_cmd_t))
+
+struct das4q_async;
+struct das4q_hotplug;
+
+// One report for the trace ring
+typedef struct das4q_trace_entry {
+    uint64_t t_us;
+    int ret;  // What the transport returned
+    bool in;
+    uint8_t data[8];
+} das4q_trace_entry_t;
+
+// Where a keyboard sits on the bus.  Stays the same across a replug into
+// the same port, unlike the device address.
+typedef struct das4q_usb_location {
+    uint8_t bus;
+    uint8_t nports;
+    uint8_t ports[7];
+} das4q_usb_location_t;
+
+/*
+ * das4q_stats_t's counters as the handle keeps them.  They're bumped with
+ * DAS4Q_STATS_ADD, relaxed atomics, so das4q_get_stats can copy them out
+ * from another thread while the handle is busy.
+ */
+typedef struct das4q_stats_histogram {
+    _Atomic uint64_t count;
+    _Atomic uint64_t total_us;
+    _Atomic uint64_t max_us;
+    _Atomic uint64_t buckets[DAS4Q_STATS_BUCKETS];
+} das4q_stats_histogram_t;
+
+typedef struct das4q_stats_counters {
+    _Atomic uint64_t set_reports;
+    _Atomic uint64_t get_reports;
+    _Atomic uint64_t bytes_sent;
+    _Atomic uint64_t bytes_received;
+    _Atomic uint64_t transfer_errors;
+    _Atomic uint64_t timeouts;
+    _Atomic uint64_t cmd_retries;
+    _Atomic uint64_t key_retries;
+    _Atomic uint64_t ack_mismatches;
+    _Atomic uint64_t ack_timeouts;
+    _Atomic uint64_t keys_sent;
+    _Atomic uint64_t keys_failed;
+    _Atomic uint64_t backoff_us;
+    _Atomic uint64_t budget_exceeded;
+    das4q_stats_histogram_t latency[DAS4Q_STATS_NUM_OPS];
+} das4q_stats_counters_t;
+
+#define DAS4Q_STATS_ADD(priv, counter, n) \
+    atomic_fetch_add_explicit(&(priv)->stats.counter, (n), memory_order_relaxed)
+
+typedef struct das4q_priv {
+    // Where reports go.  For libusb transport_ctx is the priv itself.
+    const das4q_transport_t* transport;
+    void* transport_ctx;
+
+    // Only set when the keyboard was opened through libusb
+    libusb_context* ctx;
+    libusb_device_handle* handle;
+    das4q_usb_location_t location;
+    // Only take the keyboard back on hotplug if it's in the same port.  Set
+    // when there may be other keyboards around.
+    bool pinned;
+
+    // das4q_init_flags_t the keyboard was opened with, also used when
+    // hotplug brings it back
+    unsigned int init_flags;
+
+    // What the keyboard last acked for each key.  Only trusted where
+    // shadow_valid is set, anything else gets resent.
+    das4q_setting_t shadow[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t active_shadow[DAS4Q_NUM_KEYS];
+    bool shadow_valid[DAS4Q_NUM_KEYS];
+
+    // Both commands for every key as they'd go out, see das4q_encode.c
+    uint8_t encoded[DAS4Q_NUM_KEYS][DAS4Q_KEY_CMDS_LEN];
+
+    // What the caller last asked for each key, whether or not it made it.
+    // Replayed when the keyboard comes back after losing its state.
+    das4q_setting_t cache[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t active_cache[DAS4Q_NUM_KEYS];
+    bool cache_valid[DAS4Q_NUM_KEYS];
+
+    // Keys sent before stopping to read their acks
+    int ack_window;
+
+    // See das4q_retry.c.  srtt_us and rttvar_us are only meaningful once
+    // rtt_valid is set by the first measured transfer.  das4q_get_stats
+    // reads srtt_us and timeout_ms from any thread.
+    das4q_retry_policy_t retry;
+    _Atomic uint64_t srtt_us;
+    uint64_t rttvar_us;
+    _Atomic unsigned int timeout_ms;
+    bool rtt_valid;
+
+    // Non-blocking engine, see das4q_async.c.  NULL until first used.
+    struct das4q_async* async;
+
+    // Replug handling, see das4q_hotplug.c.  NULL unless enabled.
+    struct das4q_hotplug* hotplug;
+
+    // See das4q_stats.c
+    das4q_stats_counters_t stats;
+    _Atomic uint64_t stats_start_us;
+
+    // Last DAS4Q_TRACE_LEN reports, see das4q_log.c.  trace_pos counts
+    // every report ever, trace_dumped is where the last dump got to.
+    das4q_trace_entry_t trace[DAS4Q_TRACE_LEN];
+    uint64_t trace_pos;
+    uint64_t trace_dumped;
+} das4q_priv_t;
+
+// Most verbose level compiled in, set from CMake
+#ifndef DAS4Q_LOG_MAX_LEVEL
+#define DAS4Q_LOG_MAX_LEVEL DAS4Q_LOG_TRACE
+#endif
+
+bool das4q_log_enabled(das4q_log_level_t level);
+void das4q_log_write(das4q_log_level_t level, const char* fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+// Arguments are only evaluated if the message is going somewhere
+#define das4q_log(level, ...)                    \
+    do {                                         \
+        if ((level) <= DAS4Q_LOG_MAX_LEVEL &&    \
+            das4q_log_enabled(level)) {          \
+            das4q_log_write(level, __VA_ARGS__); \
+        }                                        \
+    } while (0)
+
+#define DAS4Q_ERROR(...) das4q_log(DAS4Q_LOG_ERROR, __VA_ARGS__)
+#define DAS4Q_WARN(...) das4q_log(DAS4Q_LOG_WARN, __VA_ARGS__)
+#define DAS4Q_INFO(...) das4q_log(DAS4Q_LOG_INFO, __VA_ARGS__)
+#define DAS4Q_DEBUG(...) das4q_log(DAS4Q_LOG_DEBUG, __VA_ARGS__)
+
+// Hex of up to len bytes into out, which needs 3 * len + 1 bytes.
+void das4q_log_hex(char* out, const uint8_t* buff, int len);
+
+// Logs a packet as hex, if level is enabled.  len at most 128.
+void das4q_log_packet(das4q_log_level_t level, const char* what,
+                      const uint8_t* buff, int len);
+
+// Keeps a report in the trace ring, and logs it at DAS4Q_LOG_TRACE.
+void das4q_trace(das4q_priv_t* priv, bool in, const uint8_t* buff, int len,
+                 int ret);
+
+/*
+ * Logs the reports since the last dump at DAS4Q_LOG_ERROR, for when
+ * something has failed for good.  Only new reports, so a keyboard that
+ * keeps failing doesn't log the same ones over and over.
+ */
+void das4q_trace_dump_new(das4q_priv_t* priv);
+
+#define HID_GET_REPORT 0x01
+#define HID_SET_REPORT 0x09
+
+#define HID_REPORT_TYPE_FEATURE 0x03
+
+// The only firmware libdas4q has been tried against
+#define DAS4Q_FIRMWARE_VERSION "S2716V21/S2749V31m"
+
+
+int write_set_report(das4q_priv_t* priv, const uint8_t* buff, int len);
+int read_get_report(das4q_priv_t* priv, uint8_t* obuff, int len);
+uint8_t das4q_checksum_cmd(uint8_t* cmd);
+
+void das4q_build_key_cmds(das4q_map_t key, das4q_setting_t setting,
+                          das4q_active_setting_t active_setting,
+                          das4q_set_cmd_t* cmd1, das4q_active_cmd_t* cmd2);
+// unk bytes to send for an active setting: its own, or if they're all
+// zero the ones the firmware expects for its mode
+const uint8_t* das4q_active_unk(const das4q_active_setting_t* active);
+
+// Fills priv->encoded with every key off.
+void das4q_encode_init(das4q_priv_t* priv);
+
+/*
+ * Brings a key's pre-encoded commands up to date with a setting, patching
+ * only the bytes that make up the setting and their checksums.
+ *
+ *  returns: the key's commands in priv->encoded.
+ */
+uint8_t* das4q_encode_key(das4q_priv_t* priv, das4q_map_t key,
+                          das4q_setting_t setting,
+                          das4q_active_setting_t active_setting);
+
+void das4q_shadow_set(das4q_priv_t* priv, das4q_map_t key,
+                      das4q_setting_t setting,
+                      das4q_active_setting_t active_setting);
+void das4q_cache_set(das4q_priv_t* priv, das4q_map_t key,
+                     das4q_setting_t setting,
+                     das4q_active_setting_t active_setting);
+
+/*
+ * Version check and reset, for a freshly opened keyboard.  Either can be
+ * skipped with priv->init_flags.
+ */
+void das4q_start_device(das4q_priv_t* priv);
+
+// Detaches the kernel driver and claims the lighting interface.
+bool das4q_usb_claim(libusb_device_handle* handle);
+
+void das4q_usb_locate(libusb_device* dev, das4q_usb_location_t* location);
+bool das4q_usb_location_equal(const das4q_usb_location_t* a,
+                              const das4q_usb_location_t* b);
+
+// The sysfs name of a location, e.g. "3-2.1".  false if it's unknown.
+bool das4q_usb_location_name(const das4q_usb_location_t* location,
+                             char* name, size_t len);
+
+// The other way round.  false for anything that isn't a USB device.
+bool das4q_usb_location_parse(const char* name,
+                              das4q_usb_location_t* location);
+
+// true if the keyboard at priv->location passed the version check before.
+bool das4q_identity_cached(das4q_priv_t* priv);
+
+// Remembers that the keyboard at priv->location passed the version check.
+void das4q_identity_store(das4q_priv_t* priv);
+
+// Puts a recorder in front of priv->transport, if recording is on.
+void das4q_record_attach(das4q_priv_t* priv);
+
+/*
+ * Pulls acks for a window of keys out of the response stream.
+ *
+ *  returns: number of acks found, at most expected.  ok[i] is set if the
+ *           i-th was a success.
+ */
+int das4q_read_acks(das4q_priv_t* priv, bool* ok, int expected);
+
+/*
+ * Sends keys back to back, packed into as few reports as possible, with
+ * acks read every ack_window keys and failed keys retried.
+ *
+ *  returns: number of keys sent on success, -errno if any key failed.
+ */
+int das4q_stream_keys(das4q_priv_t* priv, const das4q_map_t* keys, int nkeys,
+                      const das4q_setting_t* settings,
+                      const das4q_active_setting_t* active_settings);
+
+/*
+ * Lists the keys in a frame that differ from what the keyboard last acked.
+ *
+ *  returns: number of keys written to keys.
+ */
+int das4q_diff_frame(das4q_priv_t* priv, const das4q_setting_t* settings,
+                     const das4q_active_setting_t* active_settings,
+                     das4q_map_t keys[DAS4Q_NUM_KEYS]);
+
+/*
+ * Opens a /dev/hidrawN node, checking it's the 4Q's lighting interface.
+ *
+ *  location: filled in from sysfs, left zeroed if it can't be found
+ *
+ *  returns: 0 with transport and ctx filled in, -errno otherwise.
+ */
+int das4q_hidraw_open(const char* path, const das4q_transport_t** transport,
+                      void** ctx, das4q_usb_location_t* location);
+
+// Monotonic clock, for timing operations into the stats
+uint64_t das4q_stats_now_us(void);
+
+// Adds one operation that started at start_us to its histogram.
+void das4q_stats_time(das4q_priv_t* priv, das4q_stats_op_t op,
+                      uint64_t start_us);
+
+/*
+ * Counts one SET_REPORT or GET_REPORT and times it.
+ *
+ *  ret: what the transport returned
+ */
+void das4q_stats_transfer(das4q_priv_t* priv, bool in, int ret,
+                          uint64_t start_us);
+
+// Default retry policy and timeout, for a new handle.
+void das4q_retry_init(das4q_priv_t* priv);
+
+/*
+ * Feeds one transfer into the round trip estimate.  A timeout doubles the
+ * timeout instead, other errors say nothing about the round trip.
+ */
+void das4q_rtt_update(das4q_priv_t* priv, int ret, bool timed_out,
+                      uint64_t elapsed_us);
+
+// Timeout for the next control transfer
+unsigned int das4q_io_timeout_ms(das4q_priv_t* priv);
+
+// Sleeps before retry number retry, 1 being the first.
+void das4q_backoff(das4q_priv_t* priv, int retry);
+
+// true once an operation that started at start_us is over frame_budget_ms.
+bool das4q_budget_spent(das4q_priv_t* priv, uint64_t start_us);
+
+// Cancels anything in flight and frees the async engine.
+void das4q_async_close(das4q_priv_t* priv);
+
+// Acts on plug events libusb has seen since the last call.
+void das4q_hotplug_process(das4q_priv_t* priv);
+
+// Deregisters the hotplug callback and frees its state.
+void das4q_hotplug_close(das4q_priv_t* priv);
+
+
+#endif  // DAS4Q_PRIV_H
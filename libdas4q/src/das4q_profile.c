@@ -0,0 +1,240 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "das4q_profile.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "das4q_priv.h"
+
+typedef struct __attribute__((__packed__)) das4q_profile_header {
+    char magic[8];  // DAS4Q_PROFILE_MAGIC, not NUL terminated
+    uint16_t version;
+    uint16_t nkeys;
+    uint32_t nreports;
+    // Byte offsets from the start of the profile
+    uint32_t keys_offset;     // nkeys das4q_profile_key_t, in send order
+    uint32_t reports_offset;  // nreports 8 byte reports
+    uint32_t marks_offset;    // nreports bytes, keys finished by each report
+} das4q_profile_header_t;
+
+// What a key was compiled from, for retries and the shadow.
+typedef struct __attribute__((__packed__)) das4q_profile_key {
+    das4q_map_t key;
+    das4q_setting_t setting;
+    das4q_active_setting_t active_setting;
+} das4q_profile_key_t;
+
+int das4q_compile_profile(
+    const das4q_setting_t settings[DAS4Q_NUM_KEYS],
+    const das4q_active_setting_t active_settings[DAS4Q_NUM_KEYS],
+    void** profile, size_t* len) {
+    uint8_t stream[DAS4Q_NUM_KEYS * DAS4Q_KEY_CMDS_LEN];
+    size_t stream_len = sizeof(stream);
+    size_t nreports = (stream_len + 6) / 7;
+    das4q_profile_header_t header = {
+        .magic = DAS4Q_PROFILE_MAGIC,
+        .version = DAS4Q_PROFILE_VERSION,
+        .nkeys = DAS4Q_NUM_KEYS,
+        .nreports = nreports,
+    };
+
+    header.keys_offset = sizeof(header);
+    header.reports_offset =
+        header.keys_offset + DAS4Q_NUM_KEYS * sizeof(das4q_profile_key_t);
+    header.marks_offset = header.reports_offset + nreports * 8;
+    *len = header.marks_offset + nreports;
+
+    uint8_t* out = calloc(1, *len);
+    if (out == NULL) {
+        return -ENOMEM;
+    }
+    memcpy(out, &header, sizeof(header));
+
+    das4q_profile_key_t* keys =
+        (das4q_profile_key_t*)(out + header.keys_offset);
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        das4q_set_cmd_t cmd1;
+        das4q_active_cmd_t cmd2;
+        das4q_build_key_cmds(i, settings[i], active_settings[i], &cmd1, &cmd2);
+        memcpy(stream + i * DAS4Q_KEY_CMDS_LEN, &cmd1, sizeof(cmd1));
+        memcpy(stream + i * DAS4Q_KEY_CMDS_LEN + sizeof(cmd1), &cmd2,
+               sizeof(cmd2));
+        keys[i].key = i;
+        keys[i].setting = settings[i];
+        keys[i].active_setting = active_settings[i];
+    }
+
+    // Same packing as das4q_stream_keys, 7 bytes of stream per report
+    uint8_t* reports = out + header.reports_offset;
+    uint8_t* marks = out + header.marks_offset;
+    for (size_t r = 0; r < nreports; r++) {
+        size_t start = r * 7;
+        size_t n = stream_len - start < 7 ? stream_len - start : 7;
+        reports[r * 8] = 0x01;
+        memcpy(reports + r * 8 + 1, stream + start, n);
+        // A key is done in the report holding its last byte
+        for (size_t pos = start; pos < start + n; pos++) {
+            if (pos % DAS4Q_KEY_CMDS_LEN == DAS4Q_KEY_CMDS_LEN - 1) {
+                marks[r]++;
+            }
+        }
+    }
+
+    *profile = out;
+    return 0;
+}
+
+bool das4q_profile_valid(const void* profile, size_t len) {
+    const uint8_t* base = profile;
+    das4q_profile_header_t header;
+
+    if (len < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.magic, DAS4Q_PROFILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != DAS4Q_PROFILE_VERSION ||
+        header.nkeys > DAS4Q_NUM_KEYS) {
+        return false;
+    }
+    if ((uint64_t)header.keys_offset +
+                header.nkeys * sizeof(das4q_profile_key_t) >
+            len ||
+        (uint64_t)header.reports_offset + header.nreports * 8ull > len ||
+        (uint64_t)header.marks_offset + header.nreports > len) {
+        return false;
+    }
+
+    const das4q_profile_key_t* keys =
+        (const das4q_profile_key_t*)(base + header.keys_offset);
+    for (int i = 0; i < header.nkeys; i++) {
+        if (keys[i].key >= DAS4Q_NUM_KEYS) {
+            return false;
+        }
+    }
+
+    // Keys are longer than a report, so no report can finish two
+    const uint8_t* marks = base + header.marks_offset;
+    uint32_t total = 0;
+    for (uint32_t r = 0; r < header.nreports; r++) {
+        if (marks[r] > 1) {
+            return false;
+        }
+        total += marks[r];
+    }
+    return total == header.nkeys;
+}
+
+int das4q_profile_frame(
+    const void* profile, size_t len, das4q_setting_t settings[DAS4Q_NUM_KEYS],
+    das4q_active_setting_t active_settings[DAS4Q_NUM_KEYS]) {
+    const uint8_t* base = profile;
+    das4q_profile_header_t header;
+
+    if (!das4q_profile_valid(profile, len)) {
+        return -EINVAL;
+    }
+    memcpy(&header, base, sizeof(header));
+
+    const das4q_profile_key_t* keys =
+        (const das4q_profile_key_t*)(base + header.keys_offset);
+    for (int i = 0; i < header.nkeys; i++) {
+        settings[keys[i].key] = keys[i].setting;
+        active_settings[keys[i].key] = keys[i].active_setting;
+    }
+    return 0;
+}
+
+int das4q_send_profile(das4q_handle handle, const void* profile, size_t len) {
+    das4q_priv_t* priv = handle;
+    const uint8_t* base = profile;
+    das4q_profile_header_t header;
+    das4q_setting_t settings[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t active_settings[DAS4Q_NUM_KEYS];
+    das4q_map_t retry[DAS4Q_NUM_KEYS];
+    int nretry = 0;
+    int done = 0;   // Keys whose last byte has gone out
+    int acked = 0;  // keys[acked] is the oldest key without an ack
+    int sent = 0;
+
+    if (!das4q_profile_valid(profile, len)) {
+        return -EINVAL;
+    }
+    memcpy(&header, base, sizeof(header));
+
+    const das4q_profile_key_t* keys =
+        (const das4q_profile_key_t*)(base + header.keys_offset);
+    const uint8_t* reports = base + header.reports_offset;
+    const uint8_t* marks = base + header.marks_offset;
+
+    for (int i = 0; i < header.nkeys; i++) {
+        settings[keys[i].key] = keys[i].setting;
+        active_settings[keys[i].key] = keys[i].active_setting;
+        das4q_cache_set(priv, keys[i].key, keys[i].setting,
+                        keys[i].active_setting);
+    }
+    if (!das4q_is_connected(priv)) {
+        return -ENODEV;
+    }
+
+    for (uint32_t r = 0; r < header.nreports; r++) {
+        if (write_set_report(priv, reports + r * 8, 8) != 8) {
+            // The rest goes the slow way below
+            break;
+        }
+        done += marks[r];
+        if (done - acked < priv->ack_window && r + 1 < header.nreports) {
+            continue;
+        }
+
+        bool ok[DAS4Q_MAX_ACK_WINDOW];
+        int window = done - acked;
+        int found = das4q_read_acks(priv, ok, window);
+        for (int i = 0; i < window; i++, acked++) {
+            das4q_map_t key = keys[acked].key;
+            if (found == window && ok[i]) {
+                das4q_shadow_set(priv, key, settings[key],
+                                 active_settings[key]);
+                sent++;
+            } else {
+                priv->shadow_valid[key] = false;
+                retry[nretry++] = key;
+            }
+        }
+    }
+
+    if (acked < header.nkeys) {
+        // Cut short.  Drain whatever acks are still coming and resend the
+        // lot.
+        bool ok[DAS4Q_MAX_ACK_WINDOW];
+        if (done > acked) {
+            das4q_read_acks(priv, ok, done - acked);
+        }
+        for (; acked < header.nkeys; acked++) {
+            priv->shadow_valid[keys[acked].key] = false;
+            retry[nretry++] = keys[acked].key;
+        }
+    }
+
+    if (nretry == 0) {
+        return sent;
+    }
+    int ret = das4q_stream_keys(priv, retry, nretry, settings,
+                                active_settings);
+    return ret < 0 ? ret : sent + ret;
+}
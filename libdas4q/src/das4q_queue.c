@@ -0,0 +1,334 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "das4q_queue.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "das4q_priv.h"
+
+/*
+ * Bounded ring in the style of Dmitry Vyukov's MPMC queue.  Each slot's
+ * seq says whose turn it is: pos when free for the producer that claims
+ * position pos, pos + 1 once that producer has filled it in.  Producers
+ * race for positions with a CAS on head, so nobody ever waits on a lock.
+ * There's only one consumer, so tail needs no CAS.
+ */
+typedef struct das4q_queue_slot {
+    _Atomic size_t seq;
+    das4q_map_t key;
+    das4q_setting_t setting;
+    das4q_active_setting_t active;
+} das4q_queue_slot_t;
+
+struct das4q_queue {
+    das4q_priv_t* priv;
+
+    das4q_queue_slot_t* slots;
+    size_t mask;
+    _Atomic size_t head;
+    // Writer only, except that flush reads done
+    size_t tail;
+    _Atomic size_t done;
+
+    // Producers only write the eventfd if the writer is about to sleep on
+    // it, so a busy queue costs no syscalls.
+    int wake_fd;
+    atomic_bool sleeping;
+    atomic_bool stopping;
+    pthread_t writer;
+
+    // For das4q_queue_flush
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool failed_since_flush;
+
+    // Pending updates, latest per key, between draining and sending
+    das4q_setting_t settings[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t active[DAS4Q_NUM_KEYS];
+    bool dirty[DAS4Q_NUM_KEYS];
+
+    _Atomic uint64_t submitted;
+    _Atomic uint64_t rejected;
+    _Atomic uint64_t coalesced;
+    _Atomic uint64_t batches;
+    _Atomic uint64_t keys_sent;
+    _Atomic uint64_t failed;
+};
+
+int das4q_queue_submit(das4q_queue_t* queue, das4q_map_t key,
+                       das4q_setting_t setting,
+                       das4q_active_setting_t active) {
+    das4q_queue_slot_t* slot;
+    size_t pos;
+
+    if (key >= DAS4Q_NUM_KEYS) {
+        return -EINVAL;
+    }
+
+    pos = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    for (;;) {
+        slot = &queue->slots[pos & queue->mask];
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(
+                    &queue->head, &pos, pos + 1, memory_order_relaxed,
+                    memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The writer hasn't got round to this slot since last time
+            atomic_fetch_add_explicit(&queue->rejected, 1,
+                                      memory_order_relaxed);
+            return -EAGAIN;
+        } else {
+            pos = atomic_load_explicit(&queue->head, memory_order_relaxed);
+        }
+    }
+
+    slot->key = key;
+    slot->setting = setting;
+    slot->active = active;
+    // Publishing the slot and checking sleeping are both seq_cst, as are
+    // the other way round in das4q_queue_sleep, so at least one side sees
+    // the other: either the writer finds this slot or we find it asleep.
+    atomic_store(&slot->seq, pos + 1);
+    atomic_fetch_add_explicit(&queue->submitted, 1, memory_order_relaxed);
+
+    if (atomic_exchange(&queue->sleeping, false)) {
+        uint64_t one = 1;
+        // Can only fail if the counter is about to overflow, which still
+        // leaves it readable
+        (void)!write(queue->wake_fd, &one, sizeof(one));
+    }
+    return 0;
+}
+
+// Moves everything in the ring into the pending set.
+static int das4q_queue_drain(das4q_queue_t* queue) {
+    int n = 0;
+
+    for (;;) {
+        das4q_queue_slot_t* slot = &queue->slots[queue->tail & queue->mask];
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        if (seq != queue->tail + 1) {
+            // Empty, or a producer has claimed the slot but not filled it
+            // in yet.  It will wake us when it has.
+            break;
+        }
+        das4q_map_t key = slot->key;
+        if (queue->dirty[key]) {
+            queue->coalesced++;
+        }
+        queue->settings[key] = slot->setting;
+        queue->active[key] = slot->active;
+        queue->dirty[key] = true;
+        atomic_store_explicit(&slot->seq, queue->tail + queue->mask + 1,
+                              memory_order_release);
+        queue->tail++;
+        n++;
+    }
+    return n;
+}
+
+// Sends the pending keys that differ from what the keyboard already has.
+static void das4q_queue_send(das4q_queue_t* queue) {
+    das4q_priv_t* priv = queue->priv;
+    das4q_map_t keys[DAS4Q_NUM_KEYS];
+    int nkeys = 0;
+
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        if (!queue->dirty[i]) {
+            continue;
+        }
+        queue->dirty[i] = false;
+        if (priv->shadow_valid[i] &&
+            memcmp(&priv->shadow[i], &queue->settings[i],
+                   sizeof(das4q_setting_t)) == 0 &&
+            memcmp(&priv->active_shadow[i], &queue->active[i],
+                   sizeof(das4q_active_setting_t)) == 0) {
+            continue;
+        }
+        keys[nkeys++] = i;
+    }
+    if (nkeys == 0) {
+        return;
+    }
+
+    int ret = das4q_stream_keys(priv, keys, nkeys, queue->settings,
+                                queue->active);
+    if (ret >= 0 && !das4q_apply_changes(priv)) {
+        ret = -EIO;
+    }
+    queue->batches++;
+    if (ret < 0) {
+        queue->failed++;
+        pthread_mutex_lock(&queue->lock);
+        queue->failed_since_flush = true;
+        pthread_mutex_unlock(&queue->lock);
+    } else {
+        queue->keys_sent += ret;
+    }
+}
+
+// Blocks until a producer says there's something new.
+static void das4q_queue_sleep(das4q_queue_t* queue) {
+    uint64_t count;
+
+    atomic_store(&queue->sleeping, true);
+    // Anything submitted before sleeping was set is visible now
+    das4q_queue_slot_t* slot = &queue->slots[queue->tail & queue->mask];
+    if (atomic_load(&slot->seq) == queue->tail + 1 ||
+        atomic_load(&queue->stopping)) {
+        atomic_store(&queue->sleeping, false);
+        return;
+    }
+    while (read(queue->wake_fd, &count, sizeof(count)) < 0 &&
+           errno == EINTR) {
+    }
+}
+
+static void das4q_queue_done(das4q_queue_t* queue) {
+    pthread_mutex_lock(&queue->lock);
+    atomic_store(&queue->done, queue->tail);
+    pthread_cond_broadcast(&queue->cond);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static void* das4q_queue_writer(void* arg) {
+    das4q_queue_t* queue = arg;
+
+    for (;;) {
+        // Anything arriving while a batch is on the wire piles up in the
+        // ring, and gets folded together here next time round.
+        if (das4q_queue_drain(queue) > 0) {
+            das4q_queue_send(queue);
+            das4q_queue_done(queue);
+            continue;
+        }
+        if (atomic_load(&queue->stopping) &&
+            atomic_load(&queue->head) == queue->tail) {
+            break;
+        }
+        das4q_queue_sleep(queue);
+    }
+    return NULL;
+}
+
+das4q_queue_t* das4q_queue_new(das4q_handle handle, uint32_t capacity) {
+    das4q_queue_t* queue;
+    size_t size = 1;
+    int ret;
+
+    if (capacity == 0) {
+        capacity = DAS4Q_QUEUE_DEFAULT_CAPACITY;
+    }
+    if (capacity > (1u << 20)) {
+        errno = -EINVAL;
+        return NULL;
+    }
+    while (size < capacity) {
+        size *= 2;
+    }
+
+    queue = calloc(1, sizeof(das4q_queue_t));
+    if (queue == NULL) {
+        return NULL;
+    }
+    queue->priv = handle;
+    queue->mask = size - 1;
+    queue->wake_fd = -1;
+    queue->slots = calloc(size, sizeof(das4q_queue_slot_t));
+    if (queue->slots == NULL) {
+        goto err;
+    }
+    for (size_t i = 0; i < size; i++) {
+        atomic_init(&queue->slots[i].seq, i);
+    }
+    queue->wake_fd = eventfd(0, EFD_CLOEXEC);
+    if (queue->wake_fd < 0) {
+        goto err;
+    }
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->cond, NULL);
+
+    ret = pthread_create(&queue->writer, NULL, das4q_queue_writer, queue);
+    if (ret != 0) {
+        pthread_cond_destroy(&queue->cond);
+        pthread_mutex_destroy(&queue->lock);
+        errno = -ret;
+        goto err;
+    }
+    return queue;
+
+err:
+    if (queue->wake_fd >= 0) {
+        close(queue->wake_fd);
+    }
+    free(queue->slots);
+    free(queue);
+    return NULL;
+}
+
+void das4q_queue_free(das4q_queue_t* queue) {
+    uint64_t one = 1;
+
+    if (queue == NULL) {
+        return;
+    }
+    atomic_store(&queue->stopping, true);
+    (void)!write(queue->wake_fd, &one, sizeof(one));
+    pthread_join(queue->writer, NULL);
+
+    pthread_cond_destroy(&queue->cond);
+    pthread_mutex_destroy(&queue->lock);
+    close(queue->wake_fd);
+    free(queue->slots);
+    free(queue);
+}
+
+int das4q_queue_flush(das4q_queue_t* queue) {
+    size_t target = atomic_load(&queue->head);
+    int ret = 0;
+
+    pthread_mutex_lock(&queue->lock);
+    while (atomic_load(&queue->done) < target) {
+        pthread_cond_wait(&queue->cond, &queue->lock);
+    }
+    if (queue->failed_since_flush) {
+        queue->failed_since_flush = false;
+        ret = -EIO;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return ret;
+}
+
+void das4q_queue_get_stats(das4q_queue_t* queue, das4q_queue_stats_t* stats) {
+    stats->submitted = atomic_load(&queue->submitted);
+    stats->rejected = atomic_load(&queue->rejected);
+    stats->coalesced = queue->coalesced;
+    stats->batches = queue->batches;
+    stats->keys_sent = queue->keys_sent;
+    stats->failed = queue->failed;
+}
@@ -0,0 +1,397 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "das4q_record.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "das4q_priv.h"
+
+typedef struct das4q_recorder {
+    const das4q_transport_t* inner;
+    void* inner_ctx;
+    FILE* file;
+    uint64_t last_us;  // When the previous report started
+    bool libusb;       // inner returns libusb error codes
+} das4q_recorder_t;
+
+struct das4q_replay {
+    das4q_replay_config_t config;
+    das4q_replay_stats_t stats;
+
+    uint8_t* buff;  // The whole file
+    size_t* offsets;
+    int count;
+
+    // Next report to look at for each direction
+    int set_pos;
+    int get_pos;
+};
+
+static pthread_mutex_t das4q_record_lock = PTHREAD_MUTEX_INITIALIZER;
+static char das4q_record_path[PATH_MAX];
+static bool das4q_record_path_set;
+static int das4q_record_handles;
+
+void das4q_set_record_path(const char* path) {
+    pthread_mutex_lock(&das4q_record_lock);
+    das4q_record_path_set = true;
+    das4q_record_path[0] = '\0';
+    if (path != NULL) {
+        snprintf(das4q_record_path, sizeof(das4q_record_path), "%s", path);
+    }
+    das4q_record_handles = 0;
+    pthread_mutex_unlock(&das4q_record_lock);
+}
+
+// So a recording from libusb replays the same through anything else
+static int das4q_libusb_errno(int ret) {
+    switch (ret) {
+        case LIBUSB_ERROR_TIMEOUT:
+            return -ETIMEDOUT;
+        case LIBUSB_ERROR_NO_DEVICE:
+            return -ENODEV;
+        case LIBUSB_ERROR_PIPE:
+            return -EPIPE;
+        case LIBUSB_ERROR_BUSY:
+            return -EBUSY;
+        case LIBUSB_ERROR_OVERFLOW:
+            return -EOVERFLOW;
+        case LIBUSB_ERROR_INTERRUPTED:
+            return -EINTR;
+        case LIBUSB_ERROR_NO_MEM:
+            return -ENOMEM;
+        default:
+            return ret < 0 ? -EIO : ret;
+    }
+}
+
+static void das4q_record_write(das4q_recorder_t* recorder, bool in,
+                               const uint8_t* buff, int len, int ret,
+                               uint64_t start_us) {
+    uint64_t end_us = das4q_stats_now_us();
+    uint64_t delta = recorder->last_us != 0 ? start_us - recorder->last_us : 0;
+    das4q_record_t record = {
+        .delta_us = delta < UINT32_MAX ? delta : UINT32_MAX,
+        .duration_us = end_us - start_us,
+        .ret = recorder->libusb ? das4q_libusb_errno(ret) : ret,
+        .in = in,
+        .len = len < DAS4Q_RECORD_MAX_DATA ? len : DAS4Q_RECORD_MAX_DATA,
+    };
+
+    recorder->last_us = start_us;
+    fwrite(&record, sizeof(record), 1, recorder->file);
+    fwrite(buff, 1, record.len, recorder->file);
+    if (ret < 0) {
+        // Whatever goes wrong next, this much is on disk
+        fflush(recorder->file);
+    }
+}
+
+static int das4q_record_set_report(void* ctx, const uint8_t* buff,
+                                   int len) {
+    das4q_recorder_t* recorder = ctx;
+    uint64_t start = das4q_stats_now_us();
+    int ret = recorder->inner->set_report(recorder->inner_ctx, buff, len);
+    das4q_record_write(recorder, false, buff, len, ret, start);
+    return ret;
+}
+
+static int das4q_record_get_report(void* ctx, uint8_t* buff, int len) {
+    das4q_recorder_t* recorder = ctx;
+    uint64_t start = das4q_stats_now_us();
+    int ret = recorder->inner->get_report(recorder->inner_ctx, buff, len);
+    das4q_record_write(recorder, true, buff, len, ret, start);
+    return ret;
+}
+
+static void das4q_record_close(void* ctx) {
+    das4q_recorder_t* recorder = ctx;
+    fclose(recorder->file);
+    if (recorder->inner->close != NULL) {
+        recorder->inner->close(recorder->inner_ctx);
+    }
+    free(recorder);
+}
+
+const das4q_transport_t das4q_record_transport = {
+    .name = "record",
+    .set_report = das4q_record_set_report,
+    .get_report = das4q_record_get_report,
+    .close = das4q_record_close,
+};
+
+static das4q_recorder_t* das4q_recorder_open(const das4q_transport_t* inner,
+                                             void* inner_ctx,
+                                             const char* path, bool libusb) {
+    das4q_record_header_t header = {.version = DAS4Q_RECORD_VERSION};
+
+    das4q_recorder_t* recorder = calloc(1, sizeof(das4q_recorder_t));
+    if (recorder == NULL) {
+        errno = -ENOMEM;
+        return NULL;
+    }
+    recorder->file = fopen(path, "we");
+    if (recorder->file == NULL) {
+        free(recorder);
+        return NULL;
+    }
+    memcpy(header.magic, DAS4Q_RECORD_MAGIC, sizeof(header.magic));
+    if (fwrite(&header, sizeof(header), 1, recorder->file) != 1) {
+        fclose(recorder->file);
+        free(recorder);
+        errno = -EIO;
+        return NULL;
+    }
+    recorder->inner = inner;
+    recorder->inner_ctx = inner_ctx;
+    recorder->libusb = libusb;
+    return recorder;
+}
+
+void* das4q_recorder_new(const das4q_transport_t* inner, void* inner_ctx,
+                         const char* path) {
+    if (inner == NULL || path == NULL) {
+        errno = -EINVAL;
+        return NULL;
+    }
+    return das4q_recorder_open(inner, inner_ctx, path, false);
+}
+
+void das4q_record_attach(das4q_priv_t* priv) {
+    char path[PATH_MAX + 16];
+    const char* base;
+    int n;
+
+    pthread_mutex_lock(&das4q_record_lock);
+    base = das4q_record_path_set ? das4q_record_path : getenv("DAS4Q_RECORD");
+    if (base == NULL || base[0] == '\0') {
+        pthread_mutex_unlock(&das4q_record_lock);
+        return;
+    }
+    n = das4q_record_handles++;
+    if (n == 0) {
+        snprintf(path, sizeof(path), "%s", base);
+    } else {
+        snprintf(path, sizeof(path), "%s.%d", base, n);
+    }
+    pthread_mutex_unlock(&das4q_record_lock);
+
+    das4q_recorder_t* recorder = das4q_recorder_open(
+        priv->transport, priv->transport_ctx, path, priv->ctx != NULL);
+    if (recorder == NULL) {
+        DAS4Q_WARN("Can't record to %s: %s", path, strerror(abs(errno)));
+        return;
+    }
+    priv->transport = &das4q_record_transport;
+    priv->transport_ctx = recorder;
+    DAS4Q_INFO("Recording to %s", path);
+}
+
+static void das4q_replay_wait(das4q_replay_t* replay, uint32_t us) {
+    if (replay->config.speed <= 0) {
+        return;
+    }
+    uint64_t wait = us / replay->config.speed;
+    struct timespec ts = {.tv_sec = wait / 1000000,
+                          .tv_nsec = (wait % 1000000) * 1000};
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+// Moves *pos to the next report going the right way.  returns: its index,
+// -1 once there are none left.
+static int das4q_replay_next(das4q_replay_t* replay, int* pos, bool in) {
+    while (*pos < replay->count) {
+        const das4q_record_t* record =
+            (const das4q_record_t*)(replay->buff + replay->offsets[*pos]);
+        if ((bool)record->in == in) {
+            return (*pos)++;
+        }
+        (*pos)++;
+    }
+    return -1;
+}
+
+static int das4q_replay_set_report(void* ctx, const uint8_t* buff, int len) {
+    das4q_replay_t* replay = ctx;
+    const uint8_t* data;
+
+    replay->stats.set_reports++;
+    int i = das4q_replay_next(replay, &replay->set_pos, false);
+    if (i < 0) {
+        // Out of recording, the keyboard takes whatever it's given
+        replay->stats.overruns++;
+        return len;
+    }
+    const das4q_record_t* record = das4q_replay_record(replay, i, &data);
+    if (record->len != len || memcmp(data, buff, len) != 0) {
+        replay->stats.set_mismatches++;
+    }
+    das4q_replay_wait(replay, record->duration_us);
+    return record->ret;
+}
+
+static int das4q_replay_get_report(void* ctx, uint8_t* buff, int len) {
+    das4q_replay_t* replay = ctx;
+    const uint8_t* data;
+
+    replay->stats.get_reports++;
+    memset(buff, 0, len);
+    int i = das4q_replay_next(replay, &replay->get_pos, true);
+    if (i < 0) {
+        // Out of recording, the keyboard has nothing more to say
+        replay->stats.overruns++;
+        return len;
+    }
+    const das4q_record_t* record = das4q_replay_record(replay, i, &data);
+    memcpy(buff, data, record->len < len ? record->len : len);
+    das4q_replay_wait(replay, record->duration_us);
+    return record->ret;
+}
+
+const das4q_transport_t das4q_replay_transport = {
+    .name = "replay",
+    .set_report = das4q_replay_set_report,
+    .get_report = das4q_replay_get_report,
+    .close = NULL,
+};
+
+// Reads the whole of path into a malloc'd buffer.
+static uint8_t* das4q_replay_load(const char* path, size_t* len) {
+    uint8_t* buff = NULL;
+    size_t size = 0;
+    size_t used = 0;
+
+    FILE* file = fopen(path, "re");
+    if (file == NULL) {
+        return NULL;
+    }
+    for (;;) {
+        if (used == size) {
+            size = size ? 2 * size : 64 * 1024;
+            uint8_t* bigger = realloc(buff, size);
+            if (bigger == NULL) {
+                free(buff);
+                fclose(file);
+                errno = -ENOMEM;
+                return NULL;
+            }
+            buff = bigger;
+        }
+        size_t got = fread(buff + used, 1, size - used, file);
+        used += got;
+        if (got == 0) {
+            break;
+        }
+    }
+    fclose(file);
+    *len = used;
+    return buff;
+}
+
+das4q_replay_t* das4q_replay_new(const char* path,
+                                 const das4q_replay_config_t* config) {
+    const das4q_record_header_t* header;
+    size_t len = 0;
+    int cap = 0;
+
+    das4q_replay_t* replay = calloc(1, sizeof(das4q_replay_t));
+    if (replay == NULL) {
+        errno = -ENOMEM;
+        return NULL;
+    }
+    if (config != NULL) {
+        replay->config = *config;
+    }
+    replay->buff = das4q_replay_load(path, &len);
+    if (replay->buff == NULL) {
+        goto fail;
+    }
+
+    header = (const das4q_record_header_t*)replay->buff;
+    if (len < sizeof(*header) ||
+        memcmp(header->magic, DAS4Q_RECORD_MAGIC, sizeof(header->magic)) !=
+            0 ||
+        header->version != DAS4Q_RECORD_VERSION) {
+        errno = -EINVAL;
+        goto fail;
+    }
+
+    // A record cut short at the end, from a crash, is dropped
+    for (size_t at = sizeof(*header); at + sizeof(das4q_record_t) <= len;) {
+        const das4q_record_t* record =
+            (const das4q_record_t*)(replay->buff + at);
+        size_t next = at + sizeof(*record) + record->len;
+        if (next > len) {
+            break;
+        }
+        if (replay->count == cap) {
+            cap = cap ? 2 * cap : 1024;
+            size_t* bigger = realloc(replay->offsets, cap * sizeof(size_t));
+            if (bigger == NULL) {
+                errno = -ENOMEM;
+                goto fail;
+            }
+            replay->offsets = bigger;
+        }
+        replay->offsets[replay->count++] = at;
+        at = next;
+    }
+    return replay;
+
+fail:
+    das4q_replay_free(replay);
+    return NULL;
+}
+
+void das4q_replay_free(das4q_replay_t* replay) {
+    if (replay == NULL) {
+        return;
+    }
+    free(replay->offsets);
+    free(replay->buff);
+    free(replay);
+}
+
+void das4q_replay_rewind(das4q_replay_t* replay) {
+    replay->set_pos = 0;
+    replay->get_pos = 0;
+}
+
+void das4q_replay_get_stats(das4q_replay_t* replay,
+                            das4q_replay_stats_t* stats) {
+    *stats = replay->stats;
+}
+
+int das4q_replay_count(das4q_replay_t* replay) { return replay->count; }
+
+const das4q_record_t* das4q_replay_record(das4q_replay_t* replay, int i,
+                                          const uint8_t** data) {
+    if (i < 0 || i >= replay->count) {
+        return NULL;
+    }
+    const uint8_t* at = replay->buff + replay->offsets[i];
+    if (data != NULL) {
+        *data = at + sizeof(das4q_record_t);
+    }
+    return (const das4q_record_t*)at;
+}
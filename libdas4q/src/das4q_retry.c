@@ -0,0 +1,152 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "das4q_priv.h"
+#include "libdas4q.h"
+
+/*
+ * Round trip estimate and retry policy.
+ *
+ * The estimate is the usual TCP one: a smoothed round trip with 1/8 gain
+ * and its mean deviation with 1/4 gain, the timeout being the one plus
+ * four times the other.  A full speed control transfer takes a millisecond
+ * or two, so the floor does most of the work until the keyboard starts
+ * stalling, at which point the deviation drags the timeout up with it.
+ */
+
+// Clock granularity in the timeout, so a very steady link isn't cut fine
+#define DAS4Q_RTT_GRANULARITY_US 1000
+
+static const das4q_retry_policy_t das4q_default_retry = {
+    .cmd_attempts = 2,
+    .key_attempts = 2,
+    .version_attempts = 3,
+    .backoff_us = 1000,
+    .backoff_max_us = 50000,
+    .timeout_min_ms = 100,
+    .timeout_max_ms = 3000,
+    .frame_budget_ms = 0,
+};
+
+static unsigned int das4q_clamp_timeout(const das4q_retry_policy_t* policy,
+                                        uint64_t ms) {
+    if (ms < policy->timeout_min_ms) {
+        return policy->timeout_min_ms;
+    }
+    if (ms > policy->timeout_max_ms) {
+        return policy->timeout_max_ms;
+    }
+    return ms;
+}
+
+static void das4q_rtt_recompute(das4q_priv_t* priv) {
+    uint64_t var = 4 * priv->rttvar_us;
+    if (var < DAS4Q_RTT_GRANULARITY_US) {
+        var = DAS4Q_RTT_GRANULARITY_US;
+    }
+    // Rounded up, a timeout a hair short is worse than one a hair long
+    uint64_t ms = (priv->srtt_us + var + 999) / 1000;
+    priv->timeout_ms = das4q_clamp_timeout(&priv->retry, ms);
+}
+
+void das4q_retry_init(das4q_priv_t* priv) {
+    priv->retry = das4q_default_retry;
+    priv->rtt_valid = false;
+    priv->timeout_ms = priv->retry.timeout_max_ms;
+}
+
+void das4q_rtt_update(das4q_priv_t* priv, int ret, bool timed_out,
+                      uint64_t elapsed_us) {
+    if (timed_out) {
+        priv->timeout_ms =
+            das4q_clamp_timeout(&priv->retry, 2 * (uint64_t)priv->timeout_ms);
+        return;
+    }
+    if (ret < 0) {
+        return;
+    }
+    if (!priv->rtt_valid) {
+        priv->srtt_us = elapsed_us;
+        priv->rttvar_us = elapsed_us / 2;
+        priv->rtt_valid = true;
+    } else {
+        uint64_t err = elapsed_us > priv->srtt_us
+                           ? elapsed_us - priv->srtt_us
+                           : priv->srtt_us - elapsed_us;
+        priv->rttvar_us = (3 * priv->rttvar_us + err) / 4;
+        priv->srtt_us = (7 * priv->srtt_us + elapsed_us) / 8;
+    }
+    das4q_rtt_recompute(priv);
+}
+
+unsigned int das4q_io_timeout_ms(das4q_priv_t* priv) {
+    return priv->timeout_ms;
+}
+
+void das4q_backoff(das4q_priv_t* priv, int retry) {
+    const das4q_retry_policy_t* policy = &priv->retry;
+    uint64_t us = policy->backoff_us;
+
+    if (us == 0 || retry < 1) {
+        return;
+    }
+    for (int i = 1; i < retry && us < policy->backoff_max_us; i++) {
+        us *= 2;
+    }
+    if (us > policy->backoff_max_us) {
+        us = policy->backoff_max_us;
+    }
+
+    struct timespec wait = {.tv_sec = us / 1000000,
+                            .tv_nsec = (us % 1000000) * 1000};
+    nanosleep(&wait, NULL);
+    DAS4Q_STATS_ADD(priv, backoff_us, us);
+}
+
+bool das4q_budget_spent(das4q_priv_t* priv, uint64_t start_us) {
+    unsigned int budget = priv->retry.frame_budget_ms;
+    return budget != 0 &&
+           das4q_stats_now_us() - start_us >= (uint64_t)budget * 1000;
+}
+
+bool das4q_set_retry_policy(das4q_handle handle,
+                            const das4q_retry_policy_t* policy) {
+    das4q_priv_t* priv = handle;
+
+    if (policy->cmd_attempts < 1 || policy->key_attempts < 1 ||
+        policy->key_attempts > DAS4Q_MAX_KEY_ATTEMPTS ||
+        policy->version_attempts < 1 || policy->timeout_min_ms == 0 ||
+        policy->timeout_min_ms > policy->timeout_max_ms) {
+        return false;
+    }
+    priv->retry = *policy;
+    if (priv->rtt_valid) {
+        das4q_rtt_recompute(priv);
+    } else {
+        priv->timeout_ms = policy->timeout_max_ms;
+    }
+    return true;
+}
+
+void das4q_get_retry_policy(das4q_handle handle,
+                            das4q_retry_policy_t* policy) {
+    das4q_priv_t* priv = handle;
+    *policy = priv->retry;
+}
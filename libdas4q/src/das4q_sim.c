@@ -0,0 +1,249 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "das4q_sim.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "das4q_priv.h"
+
+#define DAS4Q_SIM_VERSION "S2716V21/S2749V31m"
+
+struct das4q_sim {
+    das4q_sim_config_t config;
+    das4q_sim_stats_t stats;
+    uint32_t rand_state;
+
+    // Command being reassembled from the report stream
+    uint8_t pkt[64];
+    int pkt_len;
+
+    // Responses waiting for GET_REPORT, each padded out to whole reports
+    uint8_t resp[1024];
+    int resp_head;
+    int resp_len;
+
+    das4q_setting_t keys[DAS4Q_NUM_KEYS];
+    das4q_active_setting_t active_keys[DAS4Q_NUM_KEYS];
+    bool key_set[DAS4Q_NUM_KEYS];
+};
+
+static void das4q_sim_delay(unsigned int us) {
+    if (us == 0) {
+        return;
+    }
+    struct timespec ts = {.tv_sec = us / 1000000,
+                          .tv_nsec = (us % 1000000) * 1000};
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+    }
+}
+
+// xorshift32, only needs to be repeatable
+static uint32_t das4q_sim_rand(das4q_sim_t* sim) {
+    uint32_t x = sim->rand_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    sim->rand_state = x;
+    return x;
+}
+
+static void das4q_sim_respond(das4q_sim_t* sim, const uint8_t* pkt, int len) {
+    int padded = (len + 7) & ~7;
+    if (sim->resp_len + padded > (int)sizeof(sim->resp)) {
+        // The real thing would overrun too, drop it.
+        return;
+    }
+    for (int i = 0; i < padded; i++) {
+        int at = (sim->resp_head + sim->resp_len + i) % sizeof(sim->resp);
+        sim->resp[at] = i < len ? pkt[i] : 0;
+    }
+    sim->resp_len += padded;
+}
+
+static void das4q_sim_ack(das4q_sim_t* sim, uint8_t status) {
+    uint8_t ack[] = {0xed, 0x03, 0x78, status, 0x00};
+    ack[4] = das4q_checksum_cmd(ack);
+
+    if (status == 0 && sim->config.ack_loss_ppm > 0 &&
+        das4q_sim_rand(sim) % 1000000 < sim->config.ack_loss_ppm) {
+        sim->stats.acks_lost++;
+        return;
+    }
+    sim->stats.acks_sent++;
+    das4q_sim_respond(sim, ack, sizeof(ack));
+}
+
+static void das4q_sim_command(das4q_sim_t* sim) {
+    uint8_t* pkt = sim->pkt;
+
+    sim->stats.commands++;
+    if (das4q_checksum_cmd(pkt) != 0) {
+        sim->stats.bad_checksums++;
+        das4q_sim_ack(sim, 0x01);
+        return;
+    }
+
+    if (pkt[2] == 0xb0) {
+        const char* version = sim->config.version != NULL
+                                  ? sim->config.version
+                                  : DAS4Q_SIM_VERSION;
+        uint8_t resp[64] = {0xed, 0x00, 0xb0, 0x00};
+        int len = strnlen(version, sizeof(resp) - 4);
+        resp[1] = len + 2;
+        memcpy(resp + 4, version, len);
+        das4q_sim_respond(sim, resp, len + 4);
+        return;
+    }
+
+    if (pkt[2] != 0x78) {
+        das4q_sim_ack(sim, 0x01);
+        return;
+    }
+
+    switch (pkt[3]) {
+        case 0x08: {
+            das4q_set_cmd_t* cmd = (das4q_set_cmd_t*)pkt;
+            if (cmd->keycode < DAS4Q_NUM_KEYS) {
+                das4q_setting_t* key = &sim->keys[cmd->keycode];
+                key->mode = cmd->mode;
+                key->red = cmd->red;
+                key->green = cmd->green;
+                key->blue = cmd->blue;
+            }
+            // The ack comes after the active half
+            break;
+        }
+        case 0x04: {
+            das4q_active_cmd_t* cmd = (das4q_active_cmd_t*)pkt;
+            if (cmd->keycode < DAS4Q_NUM_KEYS) {
+                das4q_active_setting_t* key = &sim->active_keys[cmd->keycode];
+                key->mode = cmd->mode;
+                key->red = cmd->red;
+                key->green = cmd->green;
+                key->blue = cmd->blue;
+                memcpy(key->unk, cmd->unk, sizeof(key->unk));
+                sim->key_set[cmd->keycode] = true;
+            }
+            das4q_sim_ack(sim, 0x00);
+            break;
+        }
+        case 0x0a:
+            das4q_sim_ack(sim, 0x00);
+            break;
+        default:
+            das4q_sim_ack(sim, 0x01);
+            break;
+    }
+}
+
+static void das4q_sim_feed(das4q_sim_t* sim, uint8_t byte) {
+    // Padding and junk between commands is skipped until the next magic
+    if (sim->pkt_len == 0 && byte != 0xea) {
+        return;
+    }
+    sim->pkt[sim->pkt_len++] = byte;
+    if (sim->pkt_len < 2) {
+        return;
+    }
+
+    int len = sim->pkt[1] + 2;
+    if (len > (int)sizeof(sim->pkt)) {
+        sim->pkt_len = 0;
+        return;
+    }
+    if (sim->pkt_len == len) {
+        das4q_sim_command(sim);
+        sim->pkt_len = 0;
+    }
+}
+
+static int das4q_sim_set_report(void* ctx, const uint8_t* buff, int len) {
+    das4q_sim_t* sim = ctx;
+
+    das4q_sim_delay(sim->config.set_latency_us);
+    sim->stats.set_reports++;
+    if (len < 1 || buff[0] != 0x01) {
+        return -EINVAL;
+    }
+    for (int i = 1; i < len; i++) {
+        das4q_sim_feed(sim, buff[i]);
+    }
+    return len;
+}
+
+static int das4q_sim_get_report(void* ctx, uint8_t* buff, int len) {
+    das4q_sim_t* sim = ctx;
+
+    das4q_sim_delay(sim->config.get_latency_us);
+    sim->stats.get_reports++;
+    memset(buff, 0, len);
+    for (int i = 0; i < len && i < 8 && sim->resp_len > 0; i++) {
+        buff[i] = sim->resp[sim->resp_head];
+        sim->resp_head = (sim->resp_head + 1) % sizeof(sim->resp);
+        sim->resp_len--;
+    }
+    return len;
+}
+
+const das4q_transport_t das4q_sim_transport = {
+    .name = "simulated",
+    .set_report = das4q_sim_set_report,
+    .get_report = das4q_sim_get_report,
+    .close = NULL,
+};
+
+das4q_sim_t* das4q_sim_new(const das4q_sim_config_t* config) {
+    das4q_sim_t* sim = calloc(1, sizeof(das4q_sim_t));
+    if (sim == NULL) {
+        return NULL;
+    }
+    das4q_sim_set_config(sim, config);
+    return sim;
+}
+
+void das4q_sim_free(das4q_sim_t* sim) { free(sim); }
+
+void das4q_sim_set_config(das4q_sim_t* sim, const das4q_sim_config_t* config) {
+    if (config != NULL) {
+        sim->config = *config;
+    } else {
+        memset(&sim->config, 0, sizeof(sim->config));
+    }
+    // xorshift gets stuck on 0
+    sim->rand_state = sim->config.seed != 0 ? sim->config.seed : 0x2037;
+}
+
+void das4q_sim_get_stats(das4q_sim_t* sim, das4q_sim_stats_t* stats) {
+    *stats = sim->stats;
+}
+
+bool das4q_sim_get_key(das4q_sim_t* sim, das4q_map_t key,
+                       das4q_setting_t* setting,
+                       das4q_active_setting_t* active) {
+    if (key >= DAS4Q_NUM_KEYS || !sim->key_set[key]) {
+        return false;
+    }
+    if (setting != NULL) {
+        *setting = sim->keys[key];
+    }
+    if (active != NULL) {
+        *active = sim->active_keys[key];
+    }
+    return true;
+}
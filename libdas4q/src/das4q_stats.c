@@ -0,0 +1,153 @@
+/**
+ * Copyright 2023 Patrick Erley <paerley@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <errno.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#include "das4q_priv.h"
+#include "libdas4q.h"
+
+uint64_t das4q_stats_now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static int das4q_stats_bucket(uint64_t us) {
+    if (us == 0) {
+        return 0;
+    }
+    int bucket = 64 - __builtin_clzll(us);
+    return bucket < DAS4Q_STATS_BUCKETS ? bucket : DAS4Q_STATS_BUCKETS - 1;
+}
+
+void das4q_stats_time(das4q_priv_t* priv, das4q_stats_op_t op,
+                      uint64_t start_us) {
+    das4q_stats_histogram_t* histogram = &priv->stats.latency[op];
+    uint64_t us = das4q_stats_now_us() - start_us;
+
+    DAS4Q_STATS_ADD(priv, latency[op].count, 1);
+    DAS4Q_STATS_ADD(priv, latency[op].total_us, us);
+    // Only the thread using the handle writes it
+    if (us > atomic_load_explicit(&histogram->max_us, memory_order_relaxed)) {
+        atomic_store_explicit(&histogram->max_us, us, memory_order_relaxed);
+    }
+    DAS4Q_STATS_ADD(priv, latency[op].buckets[das4q_stats_bucket(us)], 1);
+}
+
+void das4q_stats_transfer(das4q_priv_t* priv, bool in, int ret,
+                          uint64_t start_us) {
+    // libusb and the errno based transports say timeout differently
+    bool timed_out = (priv->ctx != NULL && ret == LIBUSB_ERROR_TIMEOUT) ||
+                     (priv->ctx == NULL && ret == -ETIMEDOUT);
+
+    das4q_stats_time(priv,
+                     in ? DAS4Q_STATS_GET_REPORT : DAS4Q_STATS_SET_REPORT,
+                     start_us);
+    das4q_rtt_update(priv, ret, timed_out, das4q_stats_now_us() - start_us);
+    if (in) {
+        DAS4Q_STATS_ADD(priv, get_reports, 1);
+    } else {
+        DAS4Q_STATS_ADD(priv, set_reports, 1);
+    }
+    if (ret >= 0) {
+        if (in) {
+            DAS4Q_STATS_ADD(priv, bytes_received, ret);
+        } else {
+            DAS4Q_STATS_ADD(priv, bytes_sent, ret);
+        }
+        return;
+    }
+    DAS4Q_STATS_ADD(priv, transfer_errors, 1);
+    if (timed_out) {
+        DAS4Q_STATS_ADD(priv, timeouts, 1);
+    }
+}
+
+// One counter for the copy, zeroed on the way if reset
+static uint64_t das4q_stats_take(_Atomic uint64_t* counter, bool reset) {
+    if (reset) {
+        return atomic_exchange_explicit(counter, 0, memory_order_relaxed);
+    }
+    return atomic_load_explicit(counter, memory_order_relaxed);
+}
+
+// Shared by das4q_get_stats and das4q_reset_stats, reset zeroes as it goes
+static void das4q_stats_copy(das4q_priv_t* priv, das4q_stats_t* stats,
+                             bool reset) {
+    das4q_stats_counters_t* c = &priv->stats;
+
+    stats->set_reports = das4q_stats_take(&c->set_reports, reset);
+    stats->get_reports = das4q_stats_take(&c->get_reports, reset);
+    stats->bytes_sent = das4q_stats_take(&c->bytes_sent, reset);
+    stats->bytes_received = das4q_stats_take(&c->bytes_received, reset);
+    stats->transfer_errors = das4q_stats_take(&c->transfer_errors, reset);
+    stats->timeouts = das4q_stats_take(&c->timeouts, reset);
+    stats->cmd_retries = das4q_stats_take(&c->cmd_retries, reset);
+    stats->key_retries = das4q_stats_take(&c->key_retries, reset);
+    stats->ack_mismatches = das4q_stats_take(&c->ack_mismatches, reset);
+    stats->ack_timeouts = das4q_stats_take(&c->ack_timeouts, reset);
+    stats->keys_sent = das4q_stats_take(&c->keys_sent, reset);
+    stats->keys_failed = das4q_stats_take(&c->keys_failed, reset);
+    stats->backoff_us = das4q_stats_take(&c->backoff_us, reset);
+    stats->budget_exceeded = das4q_stats_take(&c->budget_exceeded, reset);
+
+    for (int op = 0; op < DAS4Q_STATS_NUM_OPS; op++) {
+        das4q_stats_histogram_t* from = &c->latency[op];
+        das4q_histogram_t* to = &stats->latency[op];
+        to->count = das4q_stats_take(&from->count, reset);
+        to->total_us = das4q_stats_take(&from->total_us, reset);
+        to->max_us = das4q_stats_take(&from->max_us, reset);
+        for (int i = 0; i < DAS4Q_STATS_BUCKETS; i++) {
+            to->buckets[i] = das4q_stats_take(&from->buckets[i], reset);
+        }
+    }
+}
+
+void das4q_get_stats(das4q_handle handle, das4q_stats_t* stats) {
+    das4q_priv_t* priv = handle;
+    das4q_stats_copy(priv, stats, false);
+    stats->elapsed_us =
+        das4q_stats_now_us() -
+        atomic_load_explicit(&priv->stats_start_us, memory_order_relaxed);
+    stats->srtt_us = atomic_load_explicit(&priv->srtt_us, memory_order_relaxed);
+    stats->timeout_ms =
+        atomic_load_explicit(&priv->timeout_ms, memory_order_relaxed);
+}
+
+void das4q_reset_stats(das4q_handle handle) {
+    das4q_priv_t* priv = handle;
+    das4q_stats_t discard;
+    das4q_stats_copy(priv, &discard, true);
+    atomic_store_explicit(&priv->stats_start_us, das4q_stats_now_us(),
+                          memory_order_relaxed);
+}
+
+uint64_t das4q_histogram_percentile(const das4q_histogram_t* histogram,
+                                    double p) {
+    if (histogram->count == 0) {
+        return 0;
+    }
+    uint64_t want = histogram->count * p / 100.0;
+    uint64_t seen = 0;
+    for (int i = 0; i < DAS4Q_STATS_BUCKETS - 1; i++) {
+        seen += histogram->buckets[i];
+        if (seen > want || seen == histogram->count) {
+            return 1ull << i;
+        }
+    }
+    return histogram->max_us;
+}
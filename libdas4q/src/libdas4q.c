@@ -17,128 +17,192 @@
 
 #include <errno.h>
 #include <libusb-1.0/libusb.h>
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-/*
- * The purpose and meaning of these is still pretty unknown.
- * it is transmitted in 7 byte chunks, with 0x01 prepended to each packet.
- */
-typedef struct __attribute__((__packed__)) das4q_set_cmd {
-    uint8_t magic;       // Will be set to 0xea
-    uint8_t pkt_size;    // Will be 0x08 to set the state
-    uint8_t always_78h;  // Will be set to 0x78
-    uint8_t cmd_type;    // will be 0x08 to set  the state
-    das4q_map_t keycode;
-    das4q_keymode_t mode;
-    uint8_t red;
-    uint8_t green;
-    uint8_t blue;
-    uint8_t csum;
-} das4q_set_cmd_t;
-
-typedef struct __attribute__((__packed__)) das4q_active_cmd {
-    uint8_t magic;       // Will be set to 0xea
-    uint8_t pkt_size;    // Will be 0x0b for active.
-    uint8_t always_78h;  // Will be set to 0x78
-    uint8_t cmd_type;    // will be 0x04 for active
-    das4q_map_t keycode;
-    das4q_active_keymode_t mode;
-    uint8_t red;
-    uint8_t green;
-    uint8_t blue;
-    uint8_t unk[3];
-    uint8_t csum;
-} das4q_active_cmd_t;
-
-typedef struct das4q_priv {
-    libusb_device_handle* handle;
-} das4q_priv_t;
 
-static bool verbose = true;
-
-libusb_device_handle* get_device_by_vid_pid(uint16_t vid, uint16_t pid) {
-    libusb_device_handle* handle;
-    handle = libusb_open_device_with_vid_pid(NULL, vid, pid);
-    if (handle == NULL) {
-        perror(" Failed to open device.\n");
-        return NULL;
-    }
+#include "das4q_priv.h"
+#include "das4q_transport.h"
 
+bool das4q_usb_claim(libusb_device_handle* handle) {
     int ret = libusb_set_auto_detach_kernel_driver(handle, 1);
     if (ret < 0) {
-        perror(" Failed to set kernel auto detach\n");
-        goto fail_kern;
+        DAS4Q_ERROR("Failed to set kernel auto detach: %s",
+                    libusb_error_name(ret));
+        return false;
     }
 
     // ret = libusb_kernel_driver_active(handle, 1);
 
     ret = libusb_claim_interface(handle, 1);
     if (ret < 0) {
-        perror(" Failed to claim interface\n");
-        goto fail_kern;
+        DAS4Q_ERROR("Failed to claim interface: %s", libusb_error_name(ret));
+        return false;
     }
+    return true;
+}
 
+libusb_device_handle* get_device_by_vid_pid(libusb_context* ctx, uint16_t vid,
+                                            uint16_t pid) {
+    libusb_device_handle* handle;
+    handle = libusb_open_device_with_vid_pid(ctx, vid, pid);
+    if (handle == NULL) {
+        DAS4Q_ERROR("Failed to open device");
+        return NULL;
+    }
+
+    if (!das4q_usb_claim(handle)) {
+        libusb_close(handle);
+        return NULL;
+    }
     return handle;
+}
 
-fail_kern:
-    libusb_close(handle);
-    return NULL;
+static bool das4q_usb_is_4q(libusb_device* dev) {
+    struct libusb_device_descriptor desc;
+    if (libusb_get_device_descriptor(dev, &desc) < 0) {
+        return false;
+    }
+    return desc.idVendor == 0x24f0 && desc.idProduct == 0x2037;
 }
 
-#define HID_GET_REPORT 0x01
-#define HID_SET_REPORT 0x09
+void das4q_usb_locate(libusb_device* dev, das4q_usb_location_t* location) {
+    memset(location, 0, sizeof(*location));
+    location->bus = libusb_get_bus_number(dev);
+    int ret = libusb_get_port_numbers(dev, location->ports,
+                                      sizeof(location->ports));
+    location->nports = ret > 0 ? ret : 0;
+}
+
+bool das4q_usb_location_equal(const das4q_usb_location_t* a,
+                              const das4q_usb_location_t* b) {
+    return a->bus == b->bus && a->nports == b->nports &&
+           memcmp(a->ports, b->ports, a->nports) == 0;
+}
 
-#define HID_REPORT_TYPE_FEATURE 0x03
+// Opens the keyboard at location, found through ctx.
+static libusb_device_handle* das4q_usb_open_at(
+    libusb_context* ctx, const das4q_usb_location_t* location) {
+    libusb_device** list;
+    libusb_device_handle* handle = NULL;
 
-int write_set_report(libusb_device_handle* handle, char* buff, int len) {
-    for (int i = 0; i < len; i++) {
-        printf("%02x ", (uint8_t)buff[i]);
+    ssize_t count = libusb_get_device_list(ctx, &list);
+    if (count < 0) {
+        DAS4Q_ERROR("Failed to list devices: %s", libusb_error_name(count));
+        return NULL;
+    }
+    for (ssize_t i = 0; i < count; i++) {
+        das4q_usb_location_t here;
+        if (!das4q_usb_is_4q(list[i])) {
+            continue;
+        }
+        das4q_usb_locate(list[i], &here);
+        if (!das4q_usb_location_equal(&here, location)) {
+            continue;
+        }
+        int ret = libusb_open(list[i], &handle);
+        if (ret < 0) {
+            DAS4Q_ERROR("Failed to open device: %s", libusb_error_name(ret));
+            handle = NULL;
+        } else if (!das4q_usb_claim(handle)) {
+            libusb_close(handle);
+            handle = NULL;
+        }
+        break;
+    }
+    libusb_free_device_list(list, 1);
+    return handle;
+}
+
+// Plain libusb control transfers, ctx is the das4q_priv_t.
+static int das4q_usb_set_report(void* ctx, const uint8_t* buff, int len) {
+    das4q_priv_t* priv = ctx;
+    if (priv->handle == NULL) {
+        // Unplugged, waiting on hotplug to bring it back
+        return LIBUSB_ERROR_NO_DEVICE;
     }
-    printf("\n");
     int ret = libusb_control_transfer(
-        handle,
+        priv->handle,
         LIBUSB_ENDPOINT_OUT | LIBUSB_REQUEST_TYPE_CLASS |
             LIBUSB_RECIPIENT_INTERFACE,
         HID_SET_REPORT,
         HID_REPORT_TYPE_FEATURE << 8 | 0x01,  // Report ID 01
         1,                                    // Index 1
-        buff, len, 3000);
+        (unsigned char*)buff, len, das4q_io_timeout_ms(priv));
     if (ret < 0) {
-        printf("Got Error %s\n", libusb_error_name(ret));
+        DAS4Q_DEBUG("SET_REPORT: %s", libusb_error_name(ret));
     }
     return ret;
 }
 
-int read_get_report(libusb_device_handle* handle, char* obuff, int len) {
-    memset(obuff, 0, len);
+static int das4q_usb_get_report(void* ctx, uint8_t* buff, int len) {
+    das4q_priv_t* priv = ctx;
+    if (priv->handle == NULL) {
+        return LIBUSB_ERROR_NO_DEVICE;
+    }
+    return libusb_control_transfer(
+        priv->handle,
+        LIBUSB_ENDPOINT_IN | LIBUSB_REQUEST_TYPE_CLASS |
+            LIBUSB_RECIPIENT_INTERFACE,
+        HID_GET_REPORT, HID_REPORT_TYPE_FEATURE << 8 | 0x01, 1, buff, len,
+        das4q_io_timeout_ms(priv));
+}
 
-    int ret = 0;
-    int total = 0;
-    bool done = false;
+// das4q_close_device takes care of the libusb side.
+static const das4q_transport_t das4q_usb_transport = {
+    .name = "libusb",
+    .set_report = das4q_usb_set_report,
+    .get_report = das4q_usb_get_report,
+    .close = NULL,
+};
+
+int write_set_report(das4q_priv_t* priv, const uint8_t* buff, int len) {
+    uint64_t start = das4q_stats_now_us();
+    int ret = priv->transport->set_report(priv->transport_ctx, buff, len);
+    das4q_stats_transfer(priv, false, ret, start);
+    das4q_trace(priv, false, buff, len, ret);
+    if (ret < 0) {
+        DAS4Q_ERROR("SET_REPORT failed (%d)", ret);
+        das4q_trace_dump_new(priv);
+    }
+    return ret;
+}
 
-    while (ret >= 0 && (total == 0 || total < len) && !done) {
-        const char ebuff[8] = {0};
-        char buff[8] = {0};
+/*
+ * Reads reports until the keyboard has nothing more to say, which it shows
+ * with an all zero report, or until obuff is full.  The zero report counts
+ * towards the total.  At most len / 8 reads, however the keyboard answers.
+ */
+int read_get_report(das4q_priv_t* priv, uint8_t* obuff, int len) {
+    const uint8_t ebuff[8] = {0};
+    int total = 0;
 
-        ret = libusb_control_transfer(
-            handle,
-            LIBUSB_ENDPOINT_IN | LIBUSB_REQUEST_TYPE_CLASS |
-                LIBUSB_RECIPIENT_INTERFACE,
-            HID_GET_REPORT, HID_REPORT_TYPE_FEATURE << 8 | 0x01, 1, buff, 8,
-            3000);
+    memset(obuff, 0, len);
+    while (total + 8 <= len) {
+        uint8_t buff[8] = {0};
+
+        uint64_t start = das4q_stats_now_us();
+        int ret = priv->transport->get_report(priv->transport_ctx, buff, 8);
+        das4q_stats_transfer(priv, true, ret, start);
+        das4q_trace(priv, true, buff, 8, ret);
+        if (ret < 0) {
+            DAS4Q_ERROR("GET_REPORT failed (%d)", ret);
+            das4q_trace_dump_new(priv);
+            return ret;
+        }
+        if (ret == 0) {
+            break;
+        }
+        if (ret > 8) {
+            ret = 8;
+        }
 
+        memcpy(obuff + total, buff, ret);
+        total += ret;
         if (memcmp(buff, ebuff, 8) == 0) {
-            done = true;
+            break;
         }
-        memcpy(obuff + total, buff, 8);
-        total += ret;
-    }
-    if (ret >= 0) {
-        return total;
-    } else {
-        return ret;
     }
+    return total;
 }
 
 uint8_t das4q_checksum_cmd(uint8_t* cmd) {
@@ -151,253 +215,753 @@ uint8_t das4q_checksum_cmd(uint8_t* cmd) {
     return csum;
 }
 
+/*
+ * Sends one command, 7 bytes to a report.  The whole command is sent again
+ * if any report fails, up to cmd_attempts times.
+ *
+ *  returns: 8 on success, -EIO once out of attempts.
+ */
 int das4q_send_cmd(das4q_handle handle, uint8_t* cmd) {
     // magic + length
     uint8_t len = cmd[1] + 2;
     das4q_priv_t* priv = handle;
     uint8_t usbcmd[8] = {0};
-    int sent;
-    int ret = 0;
-    int tries = 0;
-retry_cmd:
-    for (int i = 0; i < len; i++) {
-        printf("%02x ", (uint8_t)cmd[i]);
-    }
-    printf("\n");
-    tries++;
-    if (tries == 3) {
-        return -EFAULT;
-    }
-    sent = 0;
-    while (sent < len) {
-        memset(usbcmd, 0, 8);
-        usbcmd[0] = 0x01;
-        if (len - sent < 7) {
-            memcpy(usbcmd + 1, cmd + sent, len - sent);
-        } else {
-            memcpy(usbcmd + 1, cmd + sent, 7);
+
+    for (int attempt = 0; attempt < priv->retry.cmd_attempts; attempt++) {
+        int sent = 0;
+        int ret = 0;
+
+        if (attempt > 0) {
+            DAS4Q_DEBUG("Resending command");
+            DAS4Q_STATS_ADD(priv, cmd_retries, 1);
+            das4q_backoff(priv, attempt);
         }
-        ret = write_set_report(priv->handle, usbcmd, 8);
-        if (ret != 8) {
-            goto retry_cmd;
+        while (sent < len) {
+            memset(usbcmd, 0, 8);
+            usbcmd[0] = 0x01;
+            if (len - sent < 7) {
+                memcpy(usbcmd + 1, cmd + sent, len - sent);
+            } else {
+                memcpy(usbcmd + 1, cmd + sent, 7);
+            }
+            ret = write_set_report(priv, usbcmd, 8);
+            if (ret != 8) {
+                break;
+            }
+            sent += 7;
+        }
+        if (ret == 8) {
+            return ret;
         }
-        sent += ret;
-        sent -= 1;
     }
-    return ret;
+    return -EIO;
 }
 
 bool das4q_apply_changes(das4q_handle handle) {
     das4q_priv_t* priv = handle;
     uint8_t cmd1[] = "\x01\xea\x03\x78\x0a\x9b\x00\x00";
-    int ret = write_set_report(priv->handle, cmd1, 8);
+    uint64_t start = das4q_stats_now_us();
+    int ret = write_set_report(priv, cmd1, 8);
     if (ret != 8) {
         return false;
     }
     uint8_t unknown[128] = {0};
-    ret = read_get_report(priv->handle, unknown, 128);
+    ret = read_get_report(priv, unknown, 128);
     if (ret < 0) {
         return false;
     }
+    das4q_stats_time(priv, DAS4Q_STATS_APPLY, start);
+    return true;
+}
+
+void das4q_build_key_cmds(das4q_map_t key, das4q_setting_t setting,
+                          das4q_active_setting_t active_setting,
+                          das4q_set_cmd_t* cmd1, das4q_active_cmd_t* cmd2) {
+    *cmd1 = (das4q_set_cmd_t){.magic = 0xea,
+                              .pkt_size = 0x08,
+                              .always_78h = 0x78,
+                              .cmd_type = 0x08,
+                              .keycode = key,
+                              .mode = setting.mode,
+                              .red = setting.red,
+                              .green = setting.green,
+                              .blue = setting.blue,
+                              .csum = 0};
+
+    *cmd2 = (das4q_active_cmd_t){.magic = 0xea,
+                                 .pkt_size = 0x0b,
+                                 .always_78h = 0x78,
+                                 .cmd_type = 0x04,
+                                 .keycode = key,
+                                 .mode = active_setting.mode,
+                                 .red = active_setting.red,
+                                 .green = active_setting.green,
+                                 .blue = active_setting.blue,
+                                 .csum = 0};
+    memcpy(cmd2->unk, das4q_active_unk(&active_setting), sizeof(cmd2->unk));
+
+    cmd1->csum = das4q_checksum_cmd((uint8_t*)cmd1);
+    cmd2->csum = das4q_checksum_cmd((uint8_t*)cmd2);
+}
+
+// Reads the response to a key update and checks it's the success packet.
+static bool das4q_read_ack(das4q_priv_t* priv) {
+    unsigned char unknown[128] = {0};
+    int ret = read_get_report(priv, unknown, 128);
+    uint8_t success_packet[] = {0xed, 0x03, 0x78, 0x00, 0x96, 0x00,
+                                0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                0x00, 0x00, 0x00, 0x00};
+
+    if (ret != 16 || memcmp(unknown, success_packet, 16) != 0) {
+        if (ret >= 0 && unknown[0] == 0) {
+            DAS4Q_STATS_ADD(priv, ack_timeouts, 1);
+            DAS4Q_WARN("No ack");
+        } else if (ret >= 0) {
+            DAS4Q_STATS_ADD(priv, ack_mismatches, 1);
+            das4q_log_packet(DAS4Q_LOG_WARN, "Packet didn't match: ", unknown,
+                             ret);
+        }
+        return false;
+    }
     return true;
 }
 
+void das4q_shadow_set(das4q_priv_t* priv, das4q_map_t key,
+                      das4q_setting_t setting,
+                      das4q_active_setting_t active_setting) {
+    if (key < DAS4Q_NUM_KEYS) {
+        priv->shadow[key] = setting;
+        priv->active_shadow[key] = active_setting;
+        priv->shadow_valid[key] = true;
+        DAS4Q_STATS_ADD(priv, keys_sent, 1);
+    }
+}
+
+void das4q_cache_set(das4q_priv_t* priv, das4q_map_t key,
+                     das4q_setting_t setting,
+                     das4q_active_setting_t active_setting) {
+    if (key < DAS4Q_NUM_KEYS) {
+        priv->cache[key] = setting;
+        priv->active_cache[key] = active_setting;
+        priv->cache_valid[key] = true;
+    }
+}
+
 bool das4q_set_key_backlight(das4q_handle handle, das4q_map_t key,
                              das4q_setting_t setting,
                              das4q_active_setting_t active_setting) {
     das4q_priv_t* priv = handle;
 
-    das4q_set_cmd_t cmd1 = {.magic = 0xea,
-                            .pkt_size = 0x08,
-                            .always_78h = 0x78,
-                            .cmd_type = 0x08,
-                            .keycode = key,
-                            .mode = setting.mode,
-                            .red = setting.red,
-                            .green = setting.green,
-                            .blue = setting.blue,
-                            .csum = 0};
-
-    das4q_active_cmd_t cmd2 = {.magic = 0xea,
-                               .pkt_size = 0x0b,
-                               .always_78h = 0x78,
-                               .cmd_type = 0x04,
-                               .keycode = key,
-                               .mode = active_setting.mode,
-                               .red = active_setting.red,
-                               .green = active_setting.green,
-                               .blue = active_setting.blue,
-                               .unk = {0, 0, 0},
-                               .csum = 0};
-    switch (cmd2.mode) {
-        case DAS4Q_ACTIVE_MODE_BREATHE:
-            cmd2.unk[0] = 0x03;
-            cmd2.unk[1] = 0xe8;
-            cmd2.unk[2] = 0x03;
-            break;
-        case DAS4Q_ACTIVE_MODE_CYCLE:
-            cmd2.unk[0] = 0x13;
-            cmd2.unk[1] = 0x88;
-            cmd2.unk[2] = 0x00;
-            break;
-        case DAS4Q_ACTIVE_MODE_SOLID:
-            cmd2.unk[0] = 0x07;
-            cmd2.unk[1] = 0xd0;
-            cmd2.unk[2] = 0x00;
+    if (key >= DAS4Q_NUM_KEYS) {
+        DAS4Q_ERROR("No key 0x%02x", key);
+        return false;
+    }
+    das4q_cache_set(priv, key, setting, active_setting);
+    uint8_t* cmds = das4q_encode_key(priv, key, setting, active_setting);
+
+    uint64_t start = das4q_stats_now_us();
+    for (int attempt = 0; attempt < priv->retry.key_attempts; attempt++) {
+        if (attempt > 0) {
+            DAS4Q_STATS_ADD(priv, key_retries, 1);
+            das4q_backoff(priv, attempt);
+        }
+        // das4q_send_cmd has already had its own retries
+        if (das4q_send_cmd(handle, cmds) < 0 ||
+            das4q_send_cmd(handle, cmds + sizeof(das4q_set_cmd_t)) < 0) {
             break;
-        case DAS4Q_ACTIVE_MODE_BLINK:
-            cmd2.unk[0] = 0x01;
-            cmd2.unk[1] = 0xf4;
-            cmd2.unk[2] = 0x03;
+        }
+        if (das4q_read_ack(priv)) {
+            das4q_shadow_set(priv, key, setting, active_setting);
+            das4q_stats_time(priv, DAS4Q_STATS_KEY, start);
+            return true;
+        }
+    }
+
+    DAS4Q_STATS_ADD(priv, keys_failed, 1);
+    DAS4Q_ERROR("Gave up on key 0x%02x", key);
+    das4q_trace_dump_new(priv);
+    return false;
+}
+
+/*
+ * Pulls acks for a window of keys out of the response stream.
+ *
+ * Each ack is an 0xed packet, possibly with zero padding in between.
+ * ok[i] is set for the i-th ack found.
+ *
+ *  returns: number of acks found, at most expected.
+ */
+int das4q_read_acks(das4q_priv_t* priv, bool* ok, int expected) {
+    const uint8_t success_packet[] = {0xed, 0x03, 0x78, 0x00, 0x96};
+    int found = 0;
+
+    while (found < expected) {
+        uint8_t buff[(DAS4Q_MAX_ACK_WINDOW + 1) * 8];
+        int got = 0;
+        int ret = read_get_report(priv, buff, sizeof(buff));
+        if (ret <= 0) {
             break;
-        default:
+        }
+
+        for (int i = 0; i < ret && found < expected;) {
+            if (buff[i] != 0xed || i + 1 >= ret) {
+                i++;
+                continue;
+            }
+            int pkt_len = buff[i + 1] + 2;
+            if (i + pkt_len > ret) {
+                break;
+            }
+            ok[found] = pkt_len == sizeof(success_packet) &&
+                        memcmp(buff + i, success_packet, pkt_len) == 0;
+            if (!ok[found]) {
+                DAS4Q_STATS_ADD(priv, ack_mismatches, 1);
+                das4q_log_packet(DAS4Q_LOG_WARN, "Packet didn't match: ",
+                                 buff + i, pkt_len);
+            }
+            found++;
+            got++;
+            i += pkt_len;
+        }
+
+        // Nothing new, the rest aren't coming.
+        if (got == 0) {
             break;
+        }
     }
+    DAS4Q_STATS_ADD(priv, ack_timeouts, expected - found);
+    return found;
+}
 
-    cmd1.csum = das4q_checksum_cmd((uint8_t*)(&cmd1));
-    cmd2.csum = das4q_checksum_cmd((uint8_t*)(&cmd2));
+/*
+ * Longest the work list in das4q_stream_keys can get.  Every key goes
+ * round once, then again for each attempt it's charged, and at most once
+ * more for free between charges.
+ */
+#define DAS4Q_WORK_LEN (DAS4Q_NUM_KEYS * 2 * DAS4Q_MAX_KEY_ATTEMPTS)
 
-    int tries = 0;
-retry:
-    tries++;
-    if (tries >= 3) {
-        return false;
-    }
-    if (!das4q_send_cmd(handle, (uint8_t*)(&cmd1))) {
+/*
+ * Puts a key back on the end of the work list, if it has attempts left.
+ * charge is false when the key may well have made it and only lost its
+ * ack in a window, that doesn't count as an attempt.  A key only gets one
+ * free go per attempt, after that a lost ack is charged like any other.
+ */
+static bool das4q_requeue_key(das4q_priv_t* priv, das4q_map_t key,
+                              das4q_map_t* work, int* nwork, uint8_t* tries,
+                              bool* free_go, bool charge) {
+    priv->shadow_valid[key] = false;
+    if (!charge && free_go[key]) {
+        charge = true;
+    }
+    free_go[key] = !charge;
+    if (*nwork >= DAS4Q_WORK_LEN ||
+        (charge && ++tries[key] >= priv->retry.key_attempts)) {
+        DAS4Q_STATS_ADD(priv, keys_failed, 1);
+        DAS4Q_ERROR("Gave up on key 0x%02x", key);
+        das4q_trace_dump_new(priv);
         return false;
     }
+    DAS4Q_STATS_ADD(priv, key_retries, 1);
+    work[(*nwork)++] = key;
+    return true;
+}
 
-    if (!das4q_send_cmd(handle, (uint8_t*)(&cmd2))) {
-        return false;
-    }
+/*
+ * Sends a list of keys as one continuous byte stream.
+ *
+ * das4q_send_cmd zero pads the last report of every command.  The firmware
+ * already has to reassemble commands split across reports, so here each
+ * report is filled with the next 7 bytes of the stream whatever command
+ * they belong to.  A full frame drops from 528 reports to 434.
+ *
+ * Up to ack_window keys are sent before their acks are read back in one
+ * go.  Keys with a bad ack are queued again at the end of the stream.  If
+ * acks went missing there's no telling which key they belonged to, so the
+ * whole window is queued again.  Before going on after a failure there's
+ * a backoff, longer the more attempts the failed keys have had.
+ *
+ * With a frame budget set, whatever hasn't been acked once the budget is
+ * spent is given up on, but only between windows so no ack is left behind
+ * to be mistaken for the next key's.
+ */
+int das4q_stream_keys(das4q_priv_t* priv, const das4q_map_t* keys, int nkeys,
+                      const das4q_setting_t* settings,
+                      const das4q_active_setting_t* active_settings) {
+    uint8_t tries[DAS4Q_NUM_KEYS] = {0};
+    bool free_go[DAS4Q_NUM_KEYS] = {0};  // Requeued free since last charged
+    das4q_map_t work[DAS4Q_WORK_LEN];
+    int nwork = nkeys;
+    int acked = 0;   // work[acked] is the oldest key without an ack
+    size_t pos = 0;  // Next byte of the stream to go out
+    int sent = 0;
+    int ret = 0;
+    uint64_t start = das4q_stats_now_us();
+
+    for (int i = 0; i < nkeys; i++) {
+        das4q_map_t key = keys[i];
+        das4q_encode_key(priv, key, settings[key], active_settings[key]);
+        work[i] = key;
+        das4q_cache_set(priv, key, settings[key], active_settings[key]);
+    }
+    if (!das4q_is_connected(priv)) {
+        // Remembered for das4q_replay_frame when it comes back
+        return -ENODEV;
+    }
+
+    while (acked < nwork) {
+        uint8_t usbcmd[8] = {0};
+        size_t end = nwork * DAS4Q_KEY_CMDS_LEN;
+        int done;
+
+        if (pos == acked * DAS4Q_KEY_CMDS_LEN &&
+            das4q_budget_spent(priv, start)) {
+            DAS4Q_ERROR("Frame budget spent with %d keys to go",
+                        nwork - acked);
+            DAS4Q_STATS_ADD(priv, budget_exceeded, 1);
+            for (; acked < nwork; acked++) {
+                priv->shadow_valid[work[acked]] = false;
+                DAS4Q_STATS_ADD(priv, keys_failed, 1);
+            }
+            ret = -ETIMEDOUT;
+            break;
+        }
 
-    unsigned char unknown[128] = {0};
-    {
-        int ret = read_get_report(priv->handle, unknown, 128);
-        uint8_t success_packet[] = {0xed, 0x03, 0x78, 0x00, 0x96, 0x00,
-                                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-                                    0x00, 0x00, 0x00, 0x00};
-
-        if (ret != 16 || memcmp(unknown, success_packet, 16) != 0) {
-            printf("Packet didn't match: ");
-            for (int i = 0; i < ret; i++) {
-                printf("0x%02x ", unknown[i]);
+        usbcmd[0] = 0x01;
+        for (int i = 1; i < 8 && pos < end; i++, pos++) {
+            usbcmd[i] = priv->encoded[work[pos / DAS4Q_KEY_CMDS_LEN]]
+                               [pos % DAS4Q_KEY_CMDS_LEN];
+        }
+
+        if (write_set_report(priv, usbcmd, 8) != 8) {
+            // Everything in flight is suspect.  Throw away whatever acks
+            // made it and start over on a fresh report.
+            bool ok[DAS4Q_MAX_ACK_WINDOW + 1];
+            int retry = 1;
+            done = (pos + DAS4Q_KEY_CMDS_LEN - 1) / DAS4Q_KEY_CMDS_LEN;
+            das4q_read_acks(priv, ok, done - acked);
+            for (; acked < done; acked++) {
+                das4q_map_t key = work[acked];
+                if (!das4q_requeue_key(priv, key, work, &nwork, tries,
+                                       free_go, true)) {
+                    ret = -EIO;
+                } else if (tries[key] > retry) {
+                    retry = tries[key];
+                }
             }
-            printf("\n");
-            printf("                     ");
-            for (int i = 0; i < ret; i++) {
-                printf("0x%02x ", success_packet[i]);
+            pos = acked * DAS4Q_KEY_CMDS_LEN;
+            das4q_backoff(priv, retry);
+            continue;
+        }
+
+        // Keys whose last byte has gone out.  Retries are acked one at a
+        // time so a lost ack can't take a whole window down with it again.
+        done = pos / DAS4Q_KEY_CMDS_LEN;
+        int limit = acked < nkeys ? priv->ack_window : 1;
+        if (done - acked < limit && pos < end) {
+            continue;
+        }
+
+        bool ok[DAS4Q_MAX_ACK_WINDOW];
+        int retry = 0;  // Highest attempt among keys going round again
+        int window = done - acked;
+        int found = das4q_read_acks(priv, ok, window);
+        for (int i = 0; i < window; i++, acked++) {
+            das4q_map_t key = work[acked];
+            if (found == window && ok[i]) {
+                das4q_shadow_set(priv, key, settings[key],
+                                 active_settings[key]);
+                sent++;
+            } else if (!das4q_requeue_key(priv, key, work, &nwork, tries,
+                                          free_go,
+                                          found == window || window == 1)) {
+                ret = -EIO;
+            } else if (tries[key] >= retry) {
+                retry = tries[key] > 0 ? tries[key] : 1;
             }
-            printf("\n");
-            goto retry;
         }
+        das4q_backoff(priv, retry);
+    }
+
+    das4q_stats_time(priv, DAS4Q_STATS_STREAM, start);
+    if (ret < 0) {
+        return ret;
+    }
+    return sent;
+}
+
+int das4q_set_frame(
+    das4q_handle handle, const das4q_setting_t settings[DAS4Q_NUM_KEYS],
+    const das4q_active_setting_t active_settings[DAS4Q_NUM_KEYS]) {
+    das4q_map_t keys[DAS4Q_NUM_KEYS];
+
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        keys[i] = i;
+    }
+    return das4q_stream_keys(handle, keys, DAS4Q_NUM_KEYS, settings,
+                             active_settings);
+}
+
+static bool das4q_setting_equal(das4q_setting_t a, das4q_setting_t b) {
+    return a.mode == b.mode && a.red == b.red && a.green == b.green &&
+           a.blue == b.blue;
+}
+
+static bool das4q_active_setting_equal(das4q_active_setting_t a,
+                                       das4q_active_setting_t b) {
+    return a.mode == b.mode && a.red == b.red && a.green == b.green &&
+           a.blue == b.blue && memcmp(a.unk, b.unk, sizeof(a.unk)) == 0;
+}
+
+int das4q_diff_frame(das4q_priv_t* priv, const das4q_setting_t* settings,
+                     const das4q_active_setting_t* active_settings,
+                     das4q_map_t keys[DAS4Q_NUM_KEYS]) {
+    int nkeys = 0;
+
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        if (priv->shadow_valid[i] &&
+            das4q_setting_equal(priv->shadow[i], settings[i]) &&
+            das4q_active_setting_equal(priv->active_shadow[i],
+                                       active_settings[i])) {
+            continue;
+        }
+        keys[nkeys++] = i;
     }
+    return nkeys;
+}
+
+int das4q_update_frame(
+    das4q_handle handle, const das4q_setting_t settings[DAS4Q_NUM_KEYS],
+    const das4q_active_setting_t active_settings[DAS4Q_NUM_KEYS]) {
+    das4q_priv_t* priv = handle;
+    das4q_map_t keys[DAS4Q_NUM_KEYS];
+    int nkeys = das4q_diff_frame(priv, settings, active_settings, keys);
+
+    if (nkeys == 0) {
+        return 0;
+    }
+    return das4q_stream_keys(priv, keys, nkeys, settings, active_settings);
+}
+
+bool das4q_set_ack_window(das4q_handle handle, int window) {
+    das4q_priv_t* priv = handle;
+    if (window < 1 || window > DAS4Q_MAX_ACK_WINDOW) {
+        return false;
+    }
+    priv->ack_window = window;
     return true;
 }
 
+void das4q_invalidate_frame(das4q_handle handle) {
+    das4q_priv_t* priv = handle;
+    memset(priv->shadow_valid, 0, sizeof(priv->shadow_valid));
+}
+
+int das4q_replay_frame(das4q_handle handle) {
+    das4q_priv_t* priv = handle;
+    das4q_map_t keys[DAS4Q_NUM_KEYS];
+    int nkeys = 0;
+
+    das4q_invalidate_frame(priv);
+    for (int i = 0; i < DAS4Q_NUM_KEYS; i++) {
+        if (priv->cache_valid[i]) {
+            keys[nkeys++] = i;
+        }
+    }
+    if (nkeys == 0) {
+        return 0;
+    }
+    int ret = das4q_stream_keys(priv, keys, nkeys, priv->cache,
+                                priv->active_cache);
+    if (ret >= 0) {
+        das4q_apply_changes(priv);
+    }
+    return ret;
+}
+
 bool das4q_check_version(das4q_handle handle) {
     das4q_priv_t* priv = handle;
-    char magic_string[] = "\x01\xea\x02\xb0\x58\x00\x00\x00";
-    int ret = 0;
+    uint8_t magic_string[] = "\x01\xea\x02\xb0\x58\x00\x00\x00";
     unsigned char version_string[128] = {0};
 
-retry:
-    memset(version_string, 0, 128);
-    ret = write_set_report(priv->handle, magic_string, 8);
-    ret = read_get_report(priv->handle, version_string, 128);
+    for (int attempt = 0; attempt < priv->retry.version_attempts; attempt++) {
+        if (attempt > 0) {
+            das4q_backoff(priv, attempt);
+        }
+        memset(version_string, 0, 128);
+        if (write_set_report(priv, magic_string, 8) != 8 ||
+            read_get_report(priv, version_string, 128) < 0) {
+            continue;
+        }
 
-    // We sent 0x01, 0xEA..
-    // Maybe 0xED is the response?
-    if (version_string[0] != 0xED) {  // Magic byte 1?
-        printf("Wrong first byte\n");
-        goto retry;
+        // We sent 0x01, 0xEA..
+        // Maybe 0xED is the response?
+        if (version_string[0] == 0xED) {  // Magic byte 1?
+            break;
+        }
+        DAS4Q_WARN("Wrong first byte");
+    }
+    if (version_string[0] != 0xED) {
+        DAS4Q_ERROR("No version response after %d attempts",
+                    priv->retry.version_attempts);
+        das4q_trace_dump_new(priv);
+        return false;
     }
 
     if (version_string[1] != 0x14) {  // Bytes after magic byte
-        printf("Unexpected version length? %d\n", version_string[1]);
+        DAS4Q_ERROR("Unexpected version length? %d", version_string[1]);
+        das4q_trace_dump_new(priv);
         return false;
     }
 
     // Not sure what this byte is... it was in the first magic packet?
     if (version_string[2] != 0xB0) {
-        printf("Unexpected magic response? 0x%02x\n",
-               (uint8_t)version_string[2]);
+        DAS4Q_ERROR("Unexpected magic response? 0x%02x",
+                    (uint8_t)version_string[2]);
+        das4q_trace_dump_new(priv);
         return false;
     }
 
     if (version_string[3] != 0x00) {
-        printf("Dunno...\n");
+        DAS4Q_ERROR("Dunno...");
+        das4q_trace_dump_new(priv);
         return false;
     }
 
-    if (memcmp(version_string + 4, "S2716V21/S2749V31m",
-               strlen("S2716V21/S2749V31m")) != 0) {
-        printf("Got unexpected version string: %s, expected %s",
-               version_string + 4, "S2716V21/S2749V31m");
+    if (memcmp(version_string + 4, DAS4Q_FIRMWARE_VERSION,
+               strlen(DAS4Q_FIRMWARE_VERSION)) != 0) {
+        DAS4Q_ERROR("Got unexpected version string: %s, expected %s",
+                    version_string + 4, DAS4Q_FIRMWARE_VERSION);
         return false;
     }
 
-    printf("Version %s\n", version_string + 4);
+    DAS4Q_INFO("Version %s", version_string + 4);
     return true;
 }
 
-das4q_handle das4q_init_device(char* hiddev) {
+static das4q_priv_t* das4q_alloc_priv(void) {
     if (sizeof(das4q_map_t) != 1) {
-        perror("Key Enum wrong size");
+        DAS4Q_ERROR("Key Enum wrong size");
         return NULL;
     }
     if (sizeof(das4q_keymode_t) != 1) {
-        perror("Mode Enum wrong size");
+        DAS4Q_ERROR("Mode Enum wrong size");
     }
 
-    if (hiddev != NULL) {
-        errno = -ENOTSUP;
-        perror("named open not implemented yet\n");
+    das4q_priv_t* priv = calloc(1, sizeof(das4q_priv_t));
+    if (priv == NULL) {
+        errno = -ENOMEM;
+        DAS4Q_ERROR("Failed to alloc private data");
         return NULL;
     }
+    priv->ack_window = 1;
+    das4q_encode_init(priv);
+    das4q_retry_init(priv);
+    priv->stats_start_us = das4q_stats_now_us();
+    return priv;
+}
 
-    das4q_priv_t* priv = calloc(1, sizeof(das4q_priv_t));
+void das4q_start_device(das4q_priv_t* priv) {
+    bool cached = (priv->init_flags & DAS4Q_INIT_CACHED_IDENTITY) &&
+                  das4q_identity_cached(priv);
+
+    if (!cached) {
+        if (!das4q_check_version(priv)) {
+            return;
+        }
+        if (priv->init_flags & DAS4Q_INIT_CACHED_IDENTITY) {
+            das4q_identity_store(priv);
+        }
+    }
+    if (!(priv->init_flags & DAS4Q_INIT_NO_CLEAR)) {
+        // Clears the backlight
+        das4q_apply_changes(priv);
+    }
+}
+
+/*
+ * Sets up a handle on an open transport.
+ *
+ *  location: where the keyboard is, for the identity cache, NULL if
+ *            that's unknown
+ */
+static das4q_handle das4q_open_transport_at(
+    const das4q_transport_t* transport, void* ctx, unsigned int flags,
+    const das4q_usb_location_t* location) {
+    if (transport == NULL || transport->set_report == NULL ||
+        transport->get_report == NULL) {
+        errno = -EINVAL;
+        return NULL;
+    }
+
+    das4q_priv_t* priv = das4q_alloc_priv();
     if (priv == NULL) {
-        errno = -ENOMEM;
-        perror("Failed to alloc private data\n");
         return NULL;
     }
-    libusb_init(NULL);
+    priv->transport = transport;
+    priv->transport_ctx = ctx;
+    priv->init_flags = flags;
+    if (location != NULL) {
+        priv->location = *location;
+    }
 
-    if (verbose) {
-        const struct libusb_version* version = libusb_get_version();
-        printf("Using libusb v%d.%d.%d.%d\n", version->major, version->minor,
-               version->micro, version->nano);
+    DAS4Q_INFO("Using %s transport", transport->name);
+    das4q_record_attach(priv);
+    das4q_start_device(priv);
+
+    return priv;
+}
+
+static das4q_handle das4q_init_hidraw(char* hiddev, unsigned int flags) {
+    const das4q_transport_t* transport;
+    das4q_usb_location_t location;
+    void* ctx;
+
+    int ret = das4q_hidraw_open(hiddev, &transport, &ctx, &location);
+    if (ret < 0) {
+        errno = ret;
+        return NULL;
+    }
+
+    das4q_handle handle =
+        das4q_open_transport_at(transport, ctx, flags, &location);
+    if (handle == NULL) {
+        transport->close(ctx);
     }
+    return handle;
+}
+
+/*
+ * Opens a keyboard through libusb, in a context of its own so handles can
+ * be used from different threads.
+ *
+ *  location: which keyboard, NULL for the first one found
+ */
+static das4q_handle das4q_init_usb(const das4q_usb_location_t* location,
+                                   unsigned int flags) {
+    das4q_priv_t* priv = das4q_alloc_priv();
+    if (priv == NULL) {
+        return NULL;
+    }
+    priv->init_flags = flags;
+    if (libusb_init(&priv->ctx) < 0) {
+        errno = -EIO;
+        DAS4Q_ERROR("Failed to init libusb");
+        free(priv);
+        return NULL;
+    }
+    priv->transport = &das4q_usb_transport;
+    priv->transport_ctx = priv;
+
+    const struct libusb_version* version = libusb_get_version();
+    DAS4Q_INFO("Using libusb v%d.%d.%d.%d", version->major, version->minor,
+               version->micro, version->nano);
 
-    if (hiddev == NULL) {
-        // Should handle be an array?  How should we handle multiple
-        // keyboards?
-        priv->handle = get_device_by_vid_pid(0x24f0, 0x2037);
+    if (location != NULL) {
+        priv->handle = das4q_usb_open_at(priv->ctx, location);
+        priv->pinned = true;
+    } else {
+        priv->handle = get_device_by_vid_pid(priv->ctx, 0x24f0, 0x2037);
     }
 
     if (priv->handle == NULL) {
-        // It might be better to register as a udev listener here
-        // and watch for plug events... oh well.
+        // Replugs are picked up by das4q_enable_hotplug, but the keyboard
+        // has to be there to start with.
         errno = -ENOENT;
         goto fatal;
     }
-    if (das4q_check_version(priv)) {
-        // Clears the backlight
-        das4q_apply_changes(priv);
-    }
+    das4q_usb_locate(libusb_get_device(priv->handle), &priv->location);
+    das4q_record_attach(priv);
+    das4q_start_device(priv);
 
     return priv;
 
 fatal:
+    libusb_exit(priv->ctx);
     free(priv);
     return NULL;
 }
 
+das4q_handle das4q_init_device_flags(char* hiddev, unsigned int flags) {
+    if (hiddev != NULL) {
+        return das4q_init_hidraw(hiddev, flags);
+    }
+    return das4q_init_usb(NULL, flags);
+}
+
+das4q_handle das4q_init_device(char* hiddev) {
+    return das4q_init_device_flags(hiddev, DAS4Q_INIT_DEFAULT);
+}
+
+int das4q_init_devices(das4q_handle handles[], int max) {
+    return das4q_init_devices_flags(handles, max, DAS4Q_INIT_DEFAULT);
+}
+
+int das4q_init_devices_flags(das4q_handle handles[], int max,
+                             unsigned int flags) {
+    libusb_context* ctx;
+    libusb_device** list;
+    int found = 0;
+    int opened = 0;
+
+    if (max <= 0) {
+        return -EINVAL;
+    }
+    das4q_usb_location_t* locations = calloc(max, sizeof(*locations));
+    if (locations == NULL) {
+        return -ENOMEM;
+    }
+
+    // Only looking, each keyboard gets opened in its own context below
+    if (libusb_init(&ctx) < 0) {
+        free(locations);
+        return -EIO;
+    }
+    ssize_t count = libusb_get_device_list(ctx, &list);
+    for (ssize_t i = 0; i < count && found < max; i++) {
+        if (das4q_usb_is_4q(list[i])) {
+            das4q_usb_locate(list[i], &locations[found++]);
+        }
+    }
+    if (count >= 0) {
+        libusb_free_device_list(list, 1);
+    }
+    libusb_exit(ctx);
+
+    for (int i = 0; i < found; i++) {
+        das4q_handle handle = das4q_init_usb(&locations[i], flags);
+        if (handle == NULL) {
+            DAS4Q_ERROR("Failed to open keyboard on bus %d", locations[i].bus);
+            continue;
+        }
+        handles[opened++] = handle;
+    }
+    free(locations);
+
+    return opened > 0 ? opened : -ENOENT;
+}
+
+das4q_handle das4q_open_transport_flags(const das4q_transport_t* transport,
+                                        void* ctx, unsigned int flags) {
+    return das4q_open_transport_at(transport, ctx, flags, NULL);
+}
+
+das4q_handle das4q_open_transport(const das4q_transport_t* transport,
+                                  void* ctx) {
+    return das4q_open_transport_flags(transport, ctx, DAS4Q_INIT_DEFAULT);
+}
+
 void das4q_close_device(das4q_handle handle) {
     das4q_priv_t* priv = handle;
+    das4q_async_close(priv);
+    das4q_hotplug_close(priv);
+    if (priv->transport->close) {
+        priv->transport->close(priv->transport_ctx);
+    }
     if (priv->handle) {
         libusb_close(priv->handle);
     }
+    if (priv->ctx) {
+        libusb_exit(priv->ctx);
+    }
     free(handle);
 }
\ No newline at end of file